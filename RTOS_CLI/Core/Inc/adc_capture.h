@@ -0,0 +1,79 @@
+/*
+ * adc_capture.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Triggered capture of one ADC channel, oscilloscope style: a ring keeps
+ *  the samples before the trigger, the trigger is searched for in whole
+ *  blocks as the ADC task publishes them, and the capture freezes once the
+ *  samples after it are in (see adc_capture.c).
+ */
+
+#ifndef INC_ADC_CAPTURE_H_
+#define INC_ADC_CAPTURE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "adc_dsp.h"
+#include "adc_task.h"
+
+/* Samples in a capture, before and after the trigger together; a power of two, for the ring. */
+#define ADC_CAPTURE_SAMPLES         (1024U)
+
+/* Samples per `capture dump` record: 18 header bytes and 480 packed ones fit one binary protocol response. */
+#define ADC_CAPTURE_DUMP_SAMPLES    (320U)
+
+#define ADC_CAPTURE_DUMP_HEADER     (18U)
+
+/* Record layout version, the first byte of every dump record. */
+#define ADC_CAPTURE_DUMP_FORMAT     (1U)
+
+typedef enum
+{
+    ADC_CAPTURE_IDLE,
+    ADC_CAPTURE_ARMED,          /* Filling the pre-trigger ring and searching each block */
+    ADC_CAPTURE_TRIGGERED,      /* Taking the samples after the trigger */
+    ADC_CAPTURE_DONE,           /* Frozen until re-armed */
+}ADC_CAPTURE_STATE;
+
+typedef struct
+{
+    ADC_CAPTURE_STATE state;
+    ADC_TRIGGER trigger;
+    uint8_t  channel;
+    uint16_t level;             /* 12-bit code */
+    uint16_t pre;               /* Samples before the trigger; the trigger sample is the first of the rest */
+    uint32_t period_us;         /* Of the block the trigger fired in */
+    uint32_t sequence;          /* That block's sequence number */
+    uint32_t gaps;              /* Blocks lost between the capture's first and last sample */
+    uint32_t blocks;            /* Searched while armed */
+    uint64_t search_cycles;     /* Spent in adc_dsp_find_trigger() over them */
+    uint32_t search_cycles_max;
+    TickType_t armed_at;
+    TickType_t triggered_at;
+}AdcCaptureInfo;
+
+/* Creates the `capture dump` lock. Called from adc_init(). */
+void adc_capture_init(void);
+
+/* Starts a new capture, dropping any previous one. `post` samples from the trigger on are kept, the trigger
+ * sample included, and ADC_CAPTURE_SAMPLES - post before it. */
+void adc_capture_arm(uint32_t channel, uint16_t level, ADC_TRIGGER trigger, uint32_t post);
+
+/* Back to idle; a capture already frozen is dropped too. */
+void adc_capture_stop(void);
+
+void adc_capture_get_info(AdcCaptureInfo *info);
+
+/* Copies up to `count` samples from `offset` on, oldest first, and returns how many. 0 unless the capture is done.
+ * `info` gets the capture the samples came from, taken together with them, so a re-arm cannot fall in between. */
+size_t adc_capture_read(AdcCaptureInfo *info, uint16_t *out, size_t offset, size_t count);
+
+/* Feeds one published block. ADC task only. */
+void adc_capture_block(const AdcBlock *block);
+
+#endif /* INC_ADC_CAPTURE_H_ */
@@ -0,0 +1,131 @@
+/*
+ * adc_dsp.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Fixed-point filters for ADC blocks, in Q15. Each kernel has a portable
+ *  _ref twin that computes the same output bit for bit; the kernels
+ *  themselves use the Cortex-M4 SIMD instructions (SSUB16, QSUB16, SMLAD,
+ *  PKHBT). State is carried from one block to the next. The trigger search
+ *  of the capture (adc_capture.c) and the FFT of `adc fft` are here too,
+ *  for the same reasons.
+ */
+
+#ifndef INC_ADC_DSP_H_
+#define INC_ADC_DSP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* FIR length; even, so that taps go through SMLAD in pairs. */
+#define ADC_DSP_FIR_TAPS        (16U)
+
+/* Longest block adc_dsp_fir() takes at once. */
+#define ADC_DSP_FIR_MAX_BLOCK   (128U)
+
+#define ADC_DSP_CIC_ORDER       (3U)
+#define ADC_DSP_DECIMATION      (4U)
+
+/* log2(ADC_DSP_DECIMATION ^ ADC_DSP_CIC_ORDER): the CIC's DC gain, taken back out of its output. */
+#define ADC_DSP_CIC_SHIFT       (6U)
+
+/* Oversampling by 4^k, k up to this, adds k bits: 16-bit results at most. */
+#define ADC_DSP_OVERSAMPLE_MAX_SHIFT    (4U)
+
+/* FFT length: 4^5, five radix-4 stages. */
+#define ADC_DSP_FFT_SIZE        (1024U)
+
+/* Bins of a real input's spectrum, DC to Nyquist. */
+#define ADC_DSP_FFT_BINS        (ADC_DSP_FFT_SIZE / 2U + 1U)
+
+/* DC blocker pole: 0.995 in Q15, a -3 dB corner near 4 Hz at 5 kHz. */
+#define ADC_DSP_DC_POLE         (32604)
+
+typedef enum
+{
+    ADC_TRIGGER_RISING,         /* Previous sample below the level, this one at or above it */
+    ADC_TRIGGER_FALLING,        /* Previous sample at or above the level, this one below it */
+    ADC_TRIGGER_ABOVE,          /* Any sample at or above the level */
+    ADC_TRIGGER_BELOW,          /* Any sample below the level */
+}ADC_TRIGGER;
+
+typedef struct
+{
+    int16_t x;                  /* Last input of the previous block */
+    int16_t y;                  /* Last output */
+}AdcDcBlock;
+
+typedef struct
+{
+    int32_t integrator[ADC_DSP_CIC_ORDER];
+    int32_t comb[ADC_DSP_CIC_ORDER];    /* Input of each comb at the previous output */
+    uint32_t phase;                     /* Inputs since the last output */
+}AdcCic;
+
+typedef struct
+{
+    int16_t coeffs[ADC_DSP_FIR_TAPS];   /* Time-reversed, so they run forwards along the window */
+    /* The last ADC_DSP_FIR_TAPS - 1 inputs, then the block; one spare for the paired loads. */
+    int16_t window[ADC_DSP_FIR_TAPS - 1 + ADC_DSP_FIR_MAX_BLOCK + 1];
+}AdcFir;
+
+typedef struct
+{
+    uint32_t sum;
+    uint32_t pending;           /* Samples in `sum` */
+    uint32_t shift;             /* k: 4^k samples per result */
+}AdcOversampler;
+
+/* 300 Hz low-pass at the decimated rate (1250 Hz at the default ADC period), unity gain at DC. */
+extern const int16_t ADC_DSP_LOWPASS[ADC_DSP_FIR_TAPS];
+
+void adc_dsp_dc_block_init(AdcDcBlock *dc);
+void adc_dsp_cic_init(AdcCic *cic);
+void adc_dsp_fir_init(AdcFir *fir, const int16_t *coeffs);
+void adc_dsp_oversample_init(AdcOversampler *os, uint32_t shift);
+
+/* 12-bit right-aligned samples to Q15 around mid-scale: (s - 2048) << 4. */
+void adc_dsp_to_q15(const uint16_t *in, int16_t *out, size_t count);
+void adc_dsp_to_q15_ref(const uint16_t *in, int16_t *out, size_t count);
+
+/* y[n] = x[n] - x[n-1] + pole * y[n-1]; the difference saturates. `out` may be `in`. */
+void adc_dsp_dc_block(AdcDcBlock *dc, const int16_t *in, int16_t *out, size_t count);
+void adc_dsp_dc_block_ref(AdcDcBlock *dc, const int16_t *in, int16_t *out, size_t count);
+
+/* Decimates by ADC_DSP_DECIMATION; returns the outputs written. `out` may be `in`. */
+size_t adc_dsp_cic(AdcCic *cic, const int16_t *in, int16_t *out, size_t count);
+size_t adc_dsp_cic_ref(AdcCic *cic, const int16_t *in, int16_t *out, size_t count);
+
+/* At most ADC_DSP_FIR_MAX_BLOCK samples per call. `out` may be `in`. */
+void adc_dsp_fir(AdcFir *fir, const int16_t *in, int16_t *out, size_t count);
+void adc_dsp_fir_ref(AdcFir *fir, const int16_t *in, int16_t *out, size_t count);
+
+/* Sums each 4^shift 12-bit samples and rounds the sum to 12 + shift bits, left-aligned to 16 bits so that
+ * 0xFFF0 is full scale at any ratio. Returns the results written; a partial sum carries over to the next call. */
+size_t adc_dsp_oversample(AdcOversampler *os, const uint16_t *in, uint16_t *out, size_t count);
+size_t adc_dsp_oversample_ref(AdcOversampler *os, const uint16_t *in, uint16_t *out, size_t count);
+
+/* Index of the first of `count` 12-bit samples that fires `trigger`, or `count` if none does. Edges compare each
+ * sample with the one before it; `previous` is the one before in[0]. */
+size_t adc_dsp_find_trigger(const uint16_t *in, size_t count, uint16_t previous, uint16_t level, ADC_TRIGGER trigger);
+size_t adc_dsp_find_trigger_ref(const uint16_t *in, size_t count, uint16_t previous, uint16_t level, ADC_TRIGGER trigger);
+
+/* The FFT works on complex Q15 values packed one per word, real part in the low half and imaginary part in the
+ * high half, the layout the dual 16-bit instructions take. */
+
+/* ADC_DSP_FFT_SIZE 12-bit samples to Q15 around mid-scale, times a Hann window; imaginary parts zero. */
+void adc_dsp_fft_window(const uint16_t *in, uint32_t *out);
+
+/* Forward FFT in place. Every stage halves twice, so the output is the DFT divided by ADC_DSP_FFT_SIZE and cannot
+ * overflow. It is left in base-4 digit-reversed order; adc_dsp_fft_magnitudes() puts it back in bin order. */
+void adc_dsp_fft(uint32_t *data);
+void adc_dsp_fft_ref(uint32_t *data);
+
+/* Position of bin `k` in adc_dsp_fft()'s output. */
+uint32_t adc_dsp_fft_bin(uint32_t k);
+
+/* |X[k]| in Q15 for the ADC_DSP_FFT_BINS bins of a real input, in bin order. */
+void adc_dsp_fft_magnitudes(const uint32_t *data, uint16_t *magnitudes);
+
+#endif /* INC_ADC_DSP_H_ */
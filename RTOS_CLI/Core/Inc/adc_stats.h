@@ -0,0 +1,39 @@
+/*
+ * adc_stats.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Running statistics of one ADC channel, merged one block at a time in
+ *  constant memory (see adc_stats.c).
+ */
+
+#ifndef INC_ADC_STATS_H_
+#define INC_ADC_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct
+{
+    uint64_t count;             /* Samples merged */
+    uint64_t sum;               /* Exact: the mean never drifts */
+    uint64_t m2;                /* Sum of squared deviations from the mean, LSB^2 */
+    uint16_t min;
+    uint16_t max;
+}AdcChannelStats;
+
+void adc_stats_reset(AdcChannelStats *stats);
+
+/* Merges one block of 12-bit samples. */
+void adc_stats_update(AdcChannelStats *stats, const uint16_t *samples, size_t count);
+
+/* Mean, in LSB Q16. 0 while empty. */
+uint32_t adc_stats_mean_q16(const AdcChannelStats *stats);
+
+/* Root mean square of the samples themselves (DC included), and of their deviation from the mean (AC only),
+ * both in LSB Q8. */
+uint32_t adc_stats_rms_q8(const AdcChannelStats *stats);
+uint32_t adc_stats_ac_rms_q8(const AdcChannelStats *stats);
+
+#endif /* INC_ADC_STATS_H_ */
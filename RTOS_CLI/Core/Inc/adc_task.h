@@ -3,13 +3,142 @@
  *
  *  Created on: Jun 9, 2025
  *      Author: Ashish Bansal
+ *
+ *  ADC1 acquisition: TIM3 TRGO starts a scan of ADC_CHANNELS inputs every
+ *  sample period, DMA2 Stream4 writes the results into a circular buffer of
+ *  two halves, and each half/complete interrupt hands one block of
+ *  ADC_BLOCK_SCANS scans to the ADC task. The task copies it out into a free
+ *  block of a small pool and publishes that block to every open reader.
  */
 
 #ifndef INC_ADC_TASK_H_
 #define INC_ADC_TASK_H_
 
-#define RING_BUFFER_SIZE    (2)
-#define BUFFER_SIZE         (50)
-#define DEF_NOTIFICATION_VAL    (1)
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "adc_dsp.h"
+#include "adc_stats.h"
+
+/* PA0, PA1, PA2: ADC1_IN0 .. ADC1_IN2, converted in that order. */
+#define ADC_CHANNELS            (3U)
+
+/* Scans per block, and so per DMA half: 20 ms at the default period. */
+#define ADC_BLOCK_SCANS         (100U)
+
+/* TIM3 update period at boot. `bench adc` changes it for the duration of the benchmark only. */
+#define ADC_SAMPLE_PERIOD_US    (200U)
+
+/* Shortest period `bench adc` tries; three 84-cycle conversions at 36 MHz take 8 us. */
+#define ADC_MIN_PERIOD_US       (10U)
+
+/* Readers open at once: one per CLI job worker, and the CLI task for commands over the binary protocol. */
+#define ADC_READERS             (3U)
+
+/* Blocks in the pool: one being filled, one held by each reader, the rest published and waiting. */
+#define ADC_POOL_BLOCKS         (ADC_READERS + 2U)
+
+/* Filtered samples per block: after the CIC, 1250 per second at the default period. */
+#define ADC_FILTERED_SCANS      (ADC_BLOCK_SCANS / ADC_DSP_DECIMATION)
+
+/* Oversampling ratios, per channel: 4^k for k = 0 (off) .. ADC_DSP_OVERSAMPLE_MAX_SHIFT, giving 12 + k bits. */
+#define ADC_OVERSAMPLE_MAX_RATIO    (1U << (2U * ADC_DSP_OVERSAMPLE_MAX_SHIFT))
+
+/* Most oversampled results a block can carry: ratio 4. */
+#define ADC_OVERSAMPLED_SCANS       (ADC_BLOCK_SCANS / 4U)
+
+/* VDDA on the STM32F4-Discovery, which is also VREF+. */
+#define ADC_VREF_MV             (3000U)
+
+/* Above the CLI, so a long command cannot hold a half-buffer past its 20 ms deadline. */
+#define ADC_TASK_PRIORITY       (tskIDLE_PRIORITY + 4)
+#define ADC_TASK_STACK_WORDS    (256U)
+
+/* One published block, de-interleaved so each channel is contiguous. */
+typedef struct
+{
+    uint32_t sequence;                              /* Counts every block the DMA completed, lost ones included */
+    uint32_t period_us;                             /* Sample period the block was taken at */
+    uint16_t samples[ADC_CHANNELS][ADC_BLOCK_SCANS];
+    int16_t  filtered[ADC_CHANNELS][ADC_FILTERED_SCANS];  /* Q15 around mid-scale, see adc_dsp.c */
+    uint16_t oversampled[ADC_CHANNELS][ADC_OVERSAMPLED_SCANS];  /* Left-aligned 16-bit, 0xFFF0 at full scale */
+    uint8_t  oversampled_count[ADC_CHANNELS];                   /* 0 for a channel with oversampling off */
+}AdcBlock;
+
+typedef struct
+{
+    uint32_t blocks;            /* Published */
+    uint32_t lost;              /* Halves the DMA refilled before the task got to them */
+    uint32_t dropped;           /* Published but taken by no reader: the oldest published block is reused when the pool runs out */
+    uint32_t overruns;          /* ADC OVR: a conversion was not read in time; acquisition restarted */
+    uint32_t dma_errors;
+    uint32_t irqs;              /* DMA half / complete interrupts */
+    uint64_t task_cycles;       /* Spent handling blocks in the ADC task, filters included */
+    uint32_t task_cycles_max;
+}AdcStats;
+
+typedef struct
+{
+    uint32_t ratio;             /* 1: off */
+    uint32_t results;           /* Since the ratio was set or the counters were cleared */
+    uint64_t cycles;            /* Spent in adc_dsp_oversample() producing them */
+    uint16_t latest;            /* Last result, left-aligned 16-bit */
+}AdcOversampleStats;
+
+/* One reader's place in the stream of published blocks; see adc_reader_open(). */
+typedef struct
+{
+    uint32_t next;              /* Sequence of the oldest block it has not taken yet */
+    uint8_t  slot;
+}AdcReader;
+
+extern TaskHandle_t Adc_Task_Handle;
+
+/* Configures ADC1, TIM3 and DMA2 Stream4, stopped, and fills the block pool. Call before the scheduler starts. */
+void adc_init(void);
+
+/* Processes each half buffer as the DMA completes it. Starts acquisition itself. */
+void adc_task(void*);
+
+/* Starts `reader` at the next block to be published. Every open reader sees every block, in order, so readers
+ * do not take blocks from each other. Returns 0 when ADC_READERS are open already. */
+uint8_t adc_reader_open(AdcReader *reader);
+
+/* Call before `reader` goes out of scope, with every block it took released. */
+void adc_reader_close(AdcReader *reader);
+
+/* The oldest published block `reader` has not taken yet, or NULL once `wait` runs out. Blocks the pool reused
+ * before the reader got to them are skipped, which shows as a gap in `sequence`. Blocks are handed over by
+ * pointer and shared by the readers; give each one back with adc_block_release() when done, or the pool runs
+ * dry. */
+const AdcBlock *adc_block_take(AdcReader *reader, TickType_t wait);
+
+void adc_block_release(const AdcBlock *block);
+
+/* Restarts acquisition at a new TIM3 period, ADC_MIN_PERIOD_US and up. Blocks already queued are kept. */
+void adc_set_period_us(uint32_t period_us);
+
+uint32_t adc_get_period_us(void);
+
+void adc_get_stats(AdcStats *stats);
+
+void adc_reset_stats(void);
+
+/* Running statistics of each channel's raw samples, and the tick they were last cleared at. */
+void adc_get_channel_stats(AdcChannelStats stats[ADC_CHANNELS], TickType_t *since);
+
+/* Clears the channel statistics before the next block is merged. Acquisition carries on. */
+void adc_reset_channel_stats(void);
+
+/* Sets a channel's oversampling ratio, from its next block: 1 (off), 4, 16, 64 or 256. Returns 0 for any other
+ * ratio or channel. */
+uint8_t adc_set_oversampling(uint32_t channel, uint32_t ratio);
+
+void adc_get_oversampling(AdcOversampleStats stats[ADC_CHANNELS]);
+
+/* Clears the result and cycle counters from the next block. Ratios are kept. */
+void adc_reset_oversampling_stats(void);
 
 #endif /* INC_ADC_TASK_H_ */
@@ -0,0 +1,72 @@
+/*
+ * cli_args.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_ARGS_H_
+#define INC_CLI_ARGS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Most tokens a command line may carry, command word included. */
+#define CLI_MAX_ARGS    (8U)
+
+typedef enum
+{
+    CLI_ARG_INT,        /* Decimal number within [min, max]; also accepts the keywords in `choices` */
+    CLI_ARG_ENUM,       /* One of `choices`; value is its index */
+    CLI_ARG_COLORS,     /* Zero or more of `choices`; value is the bitmask of the names given */
+    CLI_ARG_TEXT,       /* Any single token, passed through as is */
+}CLI_ARG_TYPE;
+
+typedef enum
+{
+    CLI_ARGS_OK,
+    CLI_ARGS_MISSING,       /* A required argument was not given */
+    CLI_ARGS_INVALID,       /* Token does not convert, or is out of range */
+    CLI_ARGS_TOO_MANY,      /* Tokens left after the last argument */
+}CLI_ARGS_STATUS;
+
+/* One entry of a command's argument schema. */
+typedef struct
+{
+    const char *name;               /* Shown in the usage line */
+    CLI_ARG_TYPE type;
+    uint8_t optional;
+    int32_t min;                    /* CLI_ARG_INT range */
+    int32_t max;
+    const char *const *choices;     /* CLI_ARG_ENUM / CLI_ARG_COLORS names, CLI_ARG_INT keywords */
+    uint8_t choice_count;
+}CliArgSpec;
+
+/* One converted argument. */
+typedef struct
+{
+    const char *text;   /* First token consumed, NULL when absent */
+    int32_t value;      /* Number, enum index or colour bitmask */
+    uint8_t keyword;    /* CLI_ARG_INT: 1 + index of the keyword given, 0 for a number */
+    uint8_t present;
+}CliArg;
+
+/* A tokenized and converted command line. argv[] points into the caller's line buffer. */
+typedef struct
+{
+    size_t argc;                    /* Tokens including the command word */
+    char *argv[CLI_MAX_ARGS];
+    CliArg arg[CLI_MAX_ARGS];       /* arg[i] is schema entry i */
+}CliArgs;
+
+#define CLI_ARG_COUNT(spec_)    (sizeof(spec_) / sizeof((spec_)[0]))
+
+/* Split `line` in place at spaces: separators become NULs and argv[] points at each token.
+ * Returns the token count, or CLI_MAX_ARGS + 1 when the line has more tokens than fit; argc is set to the same, and
+ * argv[] then holds only the first CLI_MAX_ARGS. */
+size_t cli_tokenize(char *line, CliArgs *args);
+
+/* Convert argv[1..] against `spec`. On failure `failed` is the schema index (or argv index for CLI_ARGS_TOO_MANY). */
+CLI_ARGS_STATUS cli_args_parse(const CliArgSpec *spec, size_t count, CliArgs *args, size_t *failed);
+
+#endif /* INC_CLI_ARGS_H_ */
@@ -0,0 +1,22 @@
+/*
+ * cli_bench.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_BENCH_H_
+#define INC_CLI_BENCH_H_
+
+#include "uart_cli.h"
+
+/* Calls per measurement; the reported figure is the average. */
+#define BENCH_ITERATIONS    (100U)
+
+/* Stack given to the worker task that runs each measurement. */
+#define BENCH_STACK_WORDS   (512U)
+
+/* `bench <name>` command: runs the named micro-benchmark and prints cycles per call and stack use. */
+CLI_STATUS cli_bench(const CliArgs *args);
+
+#endif /* INC_CLI_BENCH_H_ */
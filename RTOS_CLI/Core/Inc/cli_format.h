@@ -0,0 +1,29 @@
+/*
+ * cli_format.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_FORMAT_H_
+#define INC_CLI_FORMAT_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/* Receives formatted output in runs; `data` is only valid for the duration of the call. */
+typedef void (*cli_format_sink)(void *context, const char *data, size_t len);
+
+/* printf-style formatting straight into `sink`, no line buffer and no truncation. Returns characters produced.
+ *
+ * Conversions : %d %i %u %x %X %c %s %% and %q (fixed point, see below)
+ * Flags       : '-' '0' '+' ' '
+ * Width/prec. : decimal or '*'
+ * Length      : hh h l ll z
+ *
+ * %q prints a signed integer that holds value * 10^precision as a decimal,
+ * e.g. cli_printf("%6.2q", 1234) gives " 12.34". Integer arithmetic only.
+ */
+size_t cli_vformat(cli_format_sink sink, void *context, const char *format, va_list args);
+
+#endif /* INC_CLI_FORMAT_H_ */
@@ -0,0 +1,73 @@
+/*
+ * cli_frame.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_FRAME_H_
+#define INC_CLI_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Ends every frame on the wire; COBS guarantees it appears nowhere else. */
+#define CLI_FRAME_DELIMITER     (0x00U)
+
+/* Request id (little endian), type, status. */
+#define CLI_FRAME_HEADER_SIZE   (4U)
+
+/* CRC-16/CCITT-FALSE over header and payload, little endian. */
+#define CLI_FRAME_CRC_SIZE      (2U)
+
+/* Command text in a request, captured CLI output in a response. */
+#define CLI_FRAME_MAX_PAYLOAD   (512U)
+
+#define CLI_FRAME_MAX           (CLI_FRAME_HEADER_SIZE + CLI_FRAME_MAX_PAYLOAD + CLI_FRAME_CRC_SIZE)
+
+/* COBS adds one byte per 254 plus one; the delimiter one more. */
+#define CLI_FRAME_MAX_ENCODED   (CLI_FRAME_MAX + CLI_FRAME_MAX / 254U + 2U)
+
+typedef enum
+{
+    CLI_FRAME_REQUEST  = 0x01,
+    CLI_FRAME_RESPONSE = 0x81,
+}CLI_FRAME_TYPE;
+
+typedef enum
+{
+    CLI_FRAME_OK,           /* Command ran and succeeded */
+    CLI_FRAME_FAILED,       /* Command failed, or the CLI rejected it; the payload says why */
+    CLI_FRAME_BAD_CRC,
+    CLI_FRAME_MALFORMED,    /* COBS error, wrong length or unknown type */
+}CLI_FRAME_STATUS;
+
+/* Status flag: the command printed more than CLI_FRAME_MAX_PAYLOAD bytes and the rest was cut. */
+#define CLI_FRAME_TRUNCATED     (0x80U)
+
+typedef struct
+{
+    uint16_t id;
+    uint8_t type;
+    uint8_t status;
+    const uint8_t *payload;
+    size_t payload_len;
+}CliFrame;
+
+/* CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). */
+uint16_t cli_frame_crc16(const uint8_t *data, size_t len);
+
+/* COBS-encode `len` bytes into `dst` (room for len + len / 254 + 1). Returns the encoded length, delimiter not included. */
+size_t cli_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/* Decode a COBS block (delimiter stripped). `dst` may be `src`. Returns the decoded length, 0 when the block is invalid. */
+size_t cli_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/* Lay out header, payload and CRC in `raw` (CLI_FRAME_MAX bytes), then encode into `out` (CLI_FRAME_MAX_ENCODED bytes)
+ * with the delimiter appended. The payload may already sit at raw + CLI_FRAME_HEADER_SIZE. Returns bytes in `out`. */
+size_t cli_frame_pack(const CliFrame *frame, uint8_t *raw, uint8_t *out);
+
+/* Decode a received frame in place and check its length and CRC. `frame->payload` points into `data`. */
+CLI_FRAME_STATUS cli_frame_unpack(uint8_t *data, size_t len, CliFrame *frame);
+
+#endif /* INC_CLI_FRAME_H_ */
@@ -0,0 +1,44 @@
+/*
+ * cli_jobs.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_JOBS_H_
+#define INC_CLI_JOBS_H_
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "uart_cli.h"
+
+/* Worker tasks that run command handlers. */
+#define CLI_JOB_WORKERS         (2U)
+
+/* Jobs that can exist at once, queued or running. */
+#define CLI_JOB_SLOTS           (4U)
+
+#define CLI_JOB_STACK_WORDS     (512U)
+
+/* Below the CLI task, so typing and echo always preempt a busy job. */
+#define CLI_JOB_PRIORITY        (tskIDLE_PRIORITY + 2)
+
+/* A command still running after this long is left in the background and the prompt returns. */
+#define CLI_JOB_DETACH_MS       (200U)
+
+/* Create the worker tasks. Called once by the CLI task. */
+void cli_jobs_init(void);
+
+/* Run `cmd` on a worker with a private copy of `args`. Waits up to CLI_JOB_DETACH_MS and returns the handler's
+ * status; a job still running then is detached (CLI_OK) and reports `[id] done` when it ends. */
+CLI_STATUS cli_job_run(const CliStruct *cmd, const CliArgs *args);
+
+/* Number of jobs queued or running, plus detached ones that have not printed their last line yet. */
+uint32_t cli_jobs_active(void);
+
+/* For long-running handlers: sleep up to `ticks`, waking early when the job is killed. Returns 1 once killed. */
+uint8_t cli_job_sleep(TickType_t ticks);
+
+#endif /* INC_CLI_JOBS_H_ */
@@ -0,0 +1,25 @@
+/*
+ * cli_proto.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_PROTO_H_
+#define INC_CLI_PROTO_H_
+
+#include "cli_frame.h"
+
+typedef enum
+{
+    CLI_PROTO_TEXT,         /* Human CLI: echo, prompt, `\r` terminated lines */
+    CLI_PROTO_BINARY,       /* COBS framed requests and responses, see cli_frame.h */
+}CLI_PROTO_MODE;
+
+/* Mode USART1 is in; switched by the `proto text|binary` command. */
+CLI_PROTO_MODE cli_proto_mode(void);
+
+/* Serve binary requests until a `proto text` request arrives. Run by the CLI task once `proto binary` executed. */
+void cli_proto_session(void);
+
+#endif /* INC_CLI_PROTO_H_ */
@@ -0,0 +1,58 @@
+/*
+ * cli_registry.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_CLI_REGISTRY_H_
+#define INC_CLI_REGISTRY_H_
+
+#include <stddef.h>
+
+#include "uart_cli.h"
+
+/* Upper bound on registered commands; the sorted index lives in RAM. */
+#define CLI_MAX_COMMANDS    (160U)
+
+#define CLI_CONCAT_(a, b)   a##b
+#define CLI_CONCAT(a, b)    CLI_CONCAT_(a, b)
+
+/* Register a command from any module: the entry is placed in the `cli_commands` linker section
+ * and picked up by cli_registry_init(). Names are matched case-insensitively as a whole token.
+ *
+ *     CLI_COMMAND("list", list_commands, ALL, "List all commands");
+ */
+#define CLI_COMMAND(name_, handler_, privilege_, description_)                                          \
+    CLI_COMMAND_ENTRY(name_, handler_, privilege_, description_, NULL, 0, 0)
+
+/* As CLI_COMMAND(), with a CliArgSpec array the arguments are checked and converted against
+ * before `handler_` runs.
+ *
+ *     static const CliArgSpec Cpu_Args[] = { { "mode", CLI_ARG_ENUM, .choices = Modes, .choice_count = 2 } };
+ *     CLI_COMMAND_ARGS("cpu_monitor", cpu_monitor, ALL, "Prints CPU Stats", Cpu_Args);
+ */
+#define CLI_COMMAND_ARGS(name_, handler_, privilege_, description_, spec_)                              \
+    CLI_COMMAND_ENTRY(name_, handler_, privilege_, description_, spec_, CLI_ARG_COUNT(spec_), 0)
+
+/* Full form, for the few commands that need `flags_` (e.g. CLI_INLINE); `spec_` may be NULL with `count_` 0. */
+#define CLI_COMMAND_ENTRY(name_, handler_, privilege_, description_, spec_, count_, flags_)             \
+    static const CliStruct CLI_CONCAT(Cli_Command_, __LINE__)                                             \
+        __attribute__((used, section("cli_commands"), aligned(__alignof__(CliStruct)))) = {             \
+        .command = (name_), .handler = (handler_), .privilege_level = (privilege_),                       \
+        .description = (description_), .args = (spec_), .arg_count = (count_), .flags = (flags_) }
+
+/* Sort the registered commands by name. Called once by the CLI task before the first lookup.
+ * Returns how many commands did not fit in CLI_MAX_COMMANDS (0 when all are reachable). */
+size_t cli_registry_init(void);
+
+/* Exact, case-insensitive match of the `len` characters at `token`. NULL when there is no such command. */
+const CliStruct* cli_registry_find(const char *token, size_t len);
+
+/* Number of registered commands. */
+size_t cli_registry_count(void);
+
+/* Command `index` in name order. */
+const CliStruct* cli_registry_at(size_t index);
+
+#endif /* INC_CLI_REGISTRY_H_ */
@@ -8,6 +8,41 @@
 #ifndef INC_CPU_MONITOR_H_
 #define INC_CPU_MONITOR_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/* Length of one load interval. */
+#define CPU_MONITOR_PERIOD_MS       (1000U)
+
+/* Intervals kept per task for min / average / peak. */
+#define CPU_MONITOR_HISTORY         (60U)
+
+/* Most tasks tracked; tasks beyond this are not reported. */
+#define CPU_MONITOR_MAX_TASKS       (20U)
+
+/* Above every application task so the intervals stay evenly spaced. */
+#define CPU_MONITOR_PRIORITY        (tskIDLE_PRIORITY + 4)
+
+#define CPU_MONITOR_STACK_WORDS     (256U)
+
+/* Load of one task. Percentages are in hundredths of a percent (0..10000). */
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN];
+    uint16_t last;          /* Most recent interval */
+    uint16_t min;
+    uint16_t avg;
+    uint16_t peak;
+    uint16_t samples;       /* Intervals behind min / avg / peak, 0 until the task has lived through one */
+    uint16_t stack_free;    /* High water mark, words */
+}CpuMonitorTask;
+
+/* Samples every task's run time each CPU_MONITOR_PERIOD_MS and keeps the per-interval load history. */
 void cpu_monitor_task(void * Arguments);
 
+/* Copy the current figures of up to `max` tasks into `tasks`; returns how many were written. */
+size_t cpu_monitor_snapshot(CpuMonitorTask *tasks, size_t max);
+
 #endif /* INC_CPU_MONITOR_H_ */
@@ -0,0 +1,129 @@
+/*
+ * irq_stats.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Entry/exit instrumentation for the busy interrupt handlers. Each handler
+ *  gets log2 histograms of its run time, of the time between entries and of
+ *  the change in that time from one entry to the next (jitter), all in DWT
+ *  cycles. `irqstat` prints them. The clock is run_time_cycles(), so a
+ *  period the core partly slept through is not cut short.
+ *
+ *  The hooks are two CYCCNT reads and a handful of increments, cheap enough
+ *  to leave on. With IRQ_STATS_ENABLE 0 they expand to nothing.
+ */
+
+#ifndef INC_IRQ_STATS_H_
+#define INC_IRQ_STATS_H_
+
+#include <stdint.h>
+
+/* 1: instrument the handlers and register `irqstat`. 0: compile it all out. */
+#ifndef IRQ_STATS_ENABLE
+#define IRQ_STATS_ENABLE    (1)
+#endif
+
+/* Bucket k counts values in [2^k, 2^(k+1)) cycles; the last one also takes everything larger (~58 ms at 144 MHz). */
+#define IRQ_STATS_BUCKETS   (24U)
+
+typedef enum
+{
+    IRQ_STAT_USART1,        /* USART1_IRQHandler: RX idle line / RXNE */
+    IRQ_STAT_UART_RX_DMA,   /* DMA2_Stream2_IRQHandler: RX half / full buffer */
+    IRQ_STAT_UART_TX_DMA,   /* DMA2_Stream7_IRQHandler: TX chunk done */
+    IRQ_STAT_TIM1,          /* TIM1_UP_TIM10_IRQHandler: HAL time base */
+    IRQ_STAT_TIM3,          /* TIM3_IRQHandler */
+    IRQ_STAT_ADC_DMA,       /* DMA2_Stream4_IRQHandler: ADC half / full buffer */
+    IRQ_STAT_COUNT
+}IRQ_STAT_ID;
+
+typedef struct
+{
+    uint32_t count;
+    uint64_t cycles;                        /* Total time in the handler */
+    uint32_t cycles_max;
+    uint32_t last_entry;                    /* run_time_cycles() at the previous entry */
+    uint32_t last_period;
+    uint32_t duration[IRQ_STATS_BUCKETS];   /* Entry to exit */
+    uint32_t period[IRQ_STATS_BUCKETS];     /* Entry to next entry */
+    uint32_t jitter[IRQ_STATS_BUCKETS];     /* |period - previous period| */
+}IrqStats;
+
+#if IRQ_STATS_ENABLE
+
+#include "main.h"
+#include "run_time.h"
+
+/* Written only by the handler each entry belongs to; read through irq_stats_get(). */
+extern IrqStats Irq_Stats[IRQ_STAT_COUNT];
+
+/* First statement of a handler: IRQ_STATS_ENTER(IRQ_STAT_TIM3); last one: IRQ_STATS_EXIT(IRQ_STAT_TIM3), ahead of any
+ * portYIELD_FROM_ISR(). */
+#define IRQ_STATS_ENTER(id_)    const uint32_t irq_stats_start_ = irq_stats_enter(id_)
+#define IRQ_STATS_EXIT(id_)     irq_stats_exit((id_), irq_stats_start_)
+
+/* -- Histogram Bucket -- */
+/* floor(log2(value)), clamped to the last bucket; 0 and 1 both land in bucket 0. */
+static inline uint32_t irq_stats_bucket(const uint32_t value)
+{
+    const uint32_t bucket = 31U - (uint32_t) __builtin_clz(value | 1U);
+    return (bucket < IRQ_STATS_BUCKETS) ? bucket : IRQ_STATS_BUCKETS - 1U;
+}
+
+/* -- IRQ Entry -- */
+static inline uint32_t irq_stats_enter(const IRQ_STAT_ID id)
+{
+    IrqStats *const stats = &Irq_Stats[id];
+    const uint32_t now = run_time_cycles();
+
+    if (stats->count != 0)
+    {
+        const uint32_t period = now - stats->last_entry;
+
+        stats->period[irq_stats_bucket(period)]++;
+        if (stats->count > 1)
+        {
+            const uint32_t jitter = (period > stats->last_period) ? period - stats->last_period
+                                                                  : stats->last_period - period;
+            stats->jitter[irq_stats_bucket(jitter)]++;
+        }
+        stats->last_period = period;
+    }
+
+    stats->last_entry = now;
+    return now;
+}
+
+/* -- IRQ Exit -- */
+static inline void irq_stats_exit(const IRQ_STAT_ID id, const uint32_t start)
+{
+    IrqStats *const stats = &Irq_Stats[id];
+    const uint32_t cycles = run_time_cycles() - start;
+
+    stats->count++;
+    stats->cycles += cycles;
+    stats->duration[irq_stats_bucket(cycles)]++;
+    if (cycles > stats->cycles_max)
+    {
+        stats->cycles_max = cycles;
+    }
+}
+
+/* Enable the cycle counter; call before the instrumented interrupts are enabled. */
+void irq_stats_init(void);
+
+/* Consistent copy of one handler's statistics. */
+void irq_stats_get(IRQ_STAT_ID id, IrqStats *stats);
+
+/* Clear all histograms. */
+void irq_stats_reset(void);
+
+#else
+
+#define IRQ_STATS_ENTER(id_)
+#define IRQ_STATS_EXIT(id_)
+
+#endif /* IRQ_STATS_ENABLE */
+
+#endif /* INC_IRQ_STATS_H_ */
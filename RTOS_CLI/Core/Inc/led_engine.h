@@ -0,0 +1,49 @@
+/*
+ * led_engine.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  All four LEDs blink from one FreeRTOS software timer. The engine keeps an
+ *  absolute next-toggle tick per LED and re-arms the timer for the earliest
+ *  one, so periods do not drift and the cost is one timer however many LEDs
+ *  there are. LEDs given a brightness pattern are handed to TIM4 (led_pwm.h)
+ *  and leave the timer alone.
+ */
+
+#ifndef INC_LED_ENGINE_H_
+#define INC_LED_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "led_pwm.h"
+#include "tasks.h"
+
+/* Blink interval at boot, in ms between toggles. */
+#define LED_DEFAULT_RATE_MS     (1000U)
+
+/* Pattern period when `led` is not given one. */
+#define LED_DEFAULT_PATTERN_MS  (2000U)
+
+/* One LED_CONFIG settings message. */
+typedef struct
+{
+    uint8_t  colour_mask;                       /* BIT(BLUE) | ... */
+    uint8_t  pattern;                           /* LED_PATTERN */
+    uint8_t  level_count;                       /* LED_PATTERN_CUSTOM only */
+    uint8_t  levels[LED_CUSTOM_MAX_LEVELS];     /* Percent */
+    uint32_t period_ms;                         /* Blink interval, or one pattern cycle */
+}LedRequest;
+
+extern const char *const COLOR_NAMES[LED_COUNT];
+extern const char *const LED_PATTERN_NAMES[LED_PATTERN_COUNT];
+
+/* Create and start the timer and set up TIM4; call before vTaskStartScheduler(). */
+void led_engine_init(void);
+
+/* Apply `count` requests together in the timer service task and wait until they have been. Used by the
+ * settings task. */
+void led_engine_apply(const LedRequest *requests, size_t count);
+
+#endif /* INC_LED_ENGINE_H_ */
@@ -0,0 +1,55 @@
+/*
+ * led_pwm.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Brightness patterns on the four LEDs from TIM4 PWM. PD12..PD15 are TIM4
+ *  CH1..CH4: a table of frames, one CCR1..CCR4 set each, is streamed into the
+ *  compare registers by a circular DMA burst on every update event, so a
+ *  running pattern costs no CPU time and no interrupts.
+ */
+
+#ifndef INC_LED_PWM_H_
+#define INC_LED_PWM_H_
+
+#include <stdint.h>
+
+#include "tasks.h"
+
+/* Frames per second; also the PWM frequency. */
+#define LED_PWM_FRAME_HZ        (100U)
+
+/* Compare steps per PWM period (ARR + 1). */
+#define LED_PWM_STEPS           (1000U)
+
+/* Frame table size, which bounds the pattern period: 5 s at 100 Hz. */
+#define LED_PWM_MAX_FRAMES      (500U)
+
+#define LED_PATTERN_MIN_PERIOD_MS   (100U)
+#define LED_PATTERN_MAX_PERIOD_MS   (LED_PWM_MAX_FRAMES * 1000U / LED_PWM_FRAME_HZ)
+
+/* Points of a custom brightness table. */
+#define LED_CUSTOM_MAX_LEVELS   (16U)
+
+typedef enum
+{
+    LED_PATTERN_BLINK,          /* On/off from the software timer (led_engine.c), pin in GPIO mode */
+    LED_PATTERN_BREATHE,        /* Smooth fade in and out */
+    LED_PATTERN_HEARTBEAT,      /* Two short pulses, then rest */
+    LED_PATTERN_CUSTOM,         /* Linear steps through the custom levels */
+    LED_PATTERN_COUNT
+}LED_PATTERN;
+
+/* Set up TIM4 and DMA1 Stream6; nothing runs until led_pwm_play(). */
+void led_pwm_init(void);
+
+/* Rebuild the frame table for every LED whose pattern is not LED_PATTERN_BLINK and restart the stream from
+ * frame 0; those pins go to TIM4, the rest back to GPIO. With no PWM LED left, TIM4 and the DMA are stopped.
+ * `levels` are percentages used by LED_PATTERN_CUSTOM. */
+void led_pwm_play(const LED_PATTERN pattern[LED_COUNT], uint32_t period_ms, const uint8_t *levels, uint8_t level_count);
+
+/* Current compare value of the LED's channel, 0 .. LED_PWM_STEPS. */
+uint32_t led_pwm_duty(COLOR colour);
+
+#endif /* INC_LED_PWM_H_ */
@@ -0,0 +1,48 @@
+/*
+ * low_power.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_LOW_POWER_H_
+#define INC_LOW_POWER_H_
+
+#include <stdint.h>
+
+typedef enum
+{
+    LOW_POWER_PERIODIC,     /* Sleep between ticks; the 1 kHz tick wakes the core every millisecond */
+    LOW_POWER_TICKLESS,     /* Suppress the tick while idle; only due tasks and interrupts wake the core */
+}LOW_POWER_MODE;
+
+/* Idle mode at boot. */
+#define LOW_POWER_DEFAULT_MODE  (LOW_POWER_TICKLESS)
+
+typedef struct
+{
+    uint32_t wakeups;           /* Returns from sleep, of either kind */
+    uint32_t tickless_sleeps;   /* Sleeps with the tick suppressed */
+    uint32_t tick_sleeps;       /* Sleeps until the next tick (periodic mode) */
+    uint32_t per_second;        /* Wakeups per second over the last completed window */
+}LowPowerStats;
+
+/* Hand the HAL time base over to the kernel tick. Call right before vTaskStartScheduler(). */
+void low_power_init(void);
+
+void low_power_set_mode(LOW_POWER_MODE mode);
+
+LOW_POWER_MODE low_power_get_mode(void);
+
+void low_power_get_stats(LowPowerStats *stats);
+
+/* configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING: the idle time to sleep for, 0 in periodic mode. */
+uint32_t low_power_idle_time(uint32_t expected_idle_ticks);
+
+/* configPRE_SLEEP_PROCESSING: notes SysTick and CYCCNT before WFI. */
+void low_power_pre_sleep(void);
+
+/* configPOST_SLEEP_PROCESSING: credits the cycles slept to the run-time clock and counts the wakeup. */
+void low_power_post_sleep(uint32_t expected_idle_ticks);
+
+#endif /* INC_LOW_POWER_H_ */
@@ -0,0 +1,32 @@
+/*
+ * run_time.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Cycle clock behind the run-time stats and the irq_stats periods: the DWT
+ *  cycle counter, plus the cycles the core spent asleep, which CYCCNT does
+ *  not see because it stops with the core clock in WFI (see low_power.c).
+ */
+
+#ifndef INC_RUN_TIME_H_
+#define INC_RUN_TIME_H_
+
+#include <stdint.h>
+
+#include "main.h"
+
+/* Cycles slept since boot, modulo 2^32. Added to by low_power.c with interrupts masked. */
+extern volatile uint32_t Run_Time_Slept_Cycles;
+
+/* -- Cycle Clock -- */
+/* CYCCNT as if the core had never slept; wraps like CYCCNT, about every 30 s at 144 MHz. */
+static inline uint32_t run_time_cycles(void)
+{
+    return DWT->CYCCNT + Run_Time_Slept_Cycles;
+}
+
+/* Credits `cycles` the core slept through. Call with interrupts masked, right after waking. */
+void run_time_add_sleep(uint32_t cycles);
+
+#endif /* INC_RUN_TIME_H_ */
@@ -0,0 +1,62 @@
+/*
+ * settings_store.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Persistent key/value settings, kept as an append-only log in flash
+ *  sectors 1 and 2 (see settings_store.c).
+ */
+
+#ifndef INC_SETTINGS_STORE_H_
+#define INC_SETTINGS_STORE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/* Sectors 1 and 2 of the STM32F407: 16 KB each, right after the vector table (linker script: SETTINGS). */
+#define SETTINGS_STORE_SECTOR_SIZE  (16U * 1024U)
+
+/* Keys are 0 .. SETTINGS_STORE_MAX_KEYS - 1; the RAM index holds one slot per key. */
+#define SETTINGS_STORE_MAX_KEYS     (16U)
+
+/* Largest value, in bytes. */
+#define SETTINGS_STORE_MAX_VALUE    (64U)
+
+typedef struct
+{
+    uint32_t generation;        /* Header of the active sector: bumped by every compaction */
+    uint8_t  active_sector;     /* 0 or 1 for flash sector 1 or 2; SETTINGS_STORE_NO_SECTOR while blank */
+    uint32_t used;              /* Bytes of the active sector taken, sector header included */
+    uint32_t records;           /* Valid records in the active sector, superseded ones included */
+    uint32_t keys;              /* Keys with a value */
+    uint32_t compactions;       /* Since boot */
+    uint32_t bad_records;       /* Records the boot scan rejected: CRC mismatch or torn write */
+    uint32_t scan_cycles;       /* Boot scan, in core cycles */
+}SettingsStoreStats;
+
+#define SETTINGS_STORE_NO_SECTOR    (0xFFU)
+
+/* Find the active sector and index its latest record per key. Call once, before the scheduler starts; does
+ * not write or erase flash. */
+void settings_store_init(void);
+
+/* Copies up to `size` bytes of the value for `key` into `value`. Returns the stored length, 0 when unset. */
+size_t settings_store_get(uint16_t key, void *value, size_t size);
+
+/* Appends a record unless the stored value is already the same. Compacts into the other sector when the
+ * active one is full. Task context only: a compaction stalls flash reads (and so code fetch) during the
+ * sector erase. */
+BaseType_t settings_store_put(uint16_t key, const void *value, size_t length);
+
+/* Moves the latest record of each key into the other sector, even when the active one has room. */
+BaseType_t settings_store_compact(void);
+
+/* Erases both sectors: defaults apply from the next boot. */
+BaseType_t settings_store_clear(void);
+
+void settings_store_get_stats(SettingsStoreStats *stats);
+
+#endif /* INC_SETTINGS_STORE_H_ */
@@ -8,20 +8,75 @@
 #ifndef _SETTINGS_TASK_H_
 #define _SETTINGS_TASK_H_
 
+#include <stddef.h>
 #include <stdint.h>
 #include <limits.h>
 
+#include "FreeRTOS.h"
+#include "task.h"
+#include "led_engine.h"
+#include "uart_cli.h"
+
 typedef enum
 {
     LED_CONFIG, UART_CONFIG, ADC_CONFIG, CPU_USAGE_DISPLAY_CONFIG
 } CONFIGS;
 
+/* One settings change. Every pending slot holds a whole Settings, so keep the union members small: the
+ * largest one sets the size for all. */
 typedef struct
 {
-    CONFIGS config_id;
-    uint8_t Buffer[UINT8_MAX];
+    uint8_t config_id;              /* CONFIGS */
+    union
+    {
+        LedRequest led;             /* LED_CONFIG */
+        uint32_t   baud_rate;       /* UART_CONFIG */
+    };
 } Settings;
 
+/* Keys in the persistent settings store (settings_store.h). Append new keys at the end: records written by
+ * older firmware stay in flash across updates. */
+typedef enum
+{
+    SETTINGS_KEY_UART_BAUD,         /* uint32_t */
+    SETTINGS_KEY_LED_FIRST,         /* LedRequest for one LED, in COLOR order */
+    SETTINGS_KEY_COUNT = SETTINGS_KEY_LED_FIRST + LED_COUNT,
+} SETTINGS_KEY;
+
+typedef enum
+{
+    SETTINGS_SUBMITTED,     /* Applied on the settings task's next pass */
+    SETTINGS_COALESCED,     /* Replaced a value for the same key that had not been applied yet */
+    SETTINGS_BATCHED,       /* Held in the open batch until settings_batch_end() submits it */
+    SETTINGS_INVALID,       /* Unknown config_id, or no LED selected: nothing was changed */
+} SETTINGS_SUBMIT;
+
+/* Created in main(); woken first by the CLI task once USART1 and uart_tx are up, then by settings_submit(). */
+extern TaskHandle_t Setting_Task_Handle;
+
+/* Never blocks. The change goes into the pending slot of its key (the baud rate, or each selected LED),
+ * replacing what is there, and the settings task applies the latest value of every pending key together.
+ * While a batch is open the change is held in the batch instead. */
+SETTINGS_SUBMIT settings_submit(const Settings *settings);
+
+/* As settings_submit(), for several changes at once. They all land in the same pass of the settings task,
+ * or none does. */
+SETTINGS_SUBMIT settings_submit_batch(const Settings *settings, size_t count);
+
+/* Opens a batch: until settings_batch_end(), settings_submit() holds the latest change per key, and a change
+ * to a key already held replaces it (SETTINGS_COALESCED from settings_batch_end()). The CLI task opens one
+ * around each `;` line, so its setting commands are applied together. */
+void settings_batch_begin(void);
+
+/* Closes the batch and hands what it holds to settings_submit_batch() in one call. A batch that holds nothing
+ * submits nothing and returns SETTINGS_SUBMITTED. */
+SETTINGS_SUBMIT settings_batch_end(void);
+
+/* CLI status of a submit result, saying so when the change replaced one not applied yet. */
+CLI_STATUS settings_report(SETTINGS_SUBMIT result);
+
+/* Applies the stored settings once the CLI task has started, then each batch of submitted ones, saving them to
+ * flash. */
 void setting_task(void*);
 
 #endif /* _SETTINGS_TASK_H_ */
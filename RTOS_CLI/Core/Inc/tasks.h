@@ -19,8 +19,6 @@ typedef enum
 
 #define BIT(m)  (1 << (m))
 
-void create_led_tasks();
-
 void Cli_Task(void *Arguments);
 
 void adc_task(void*);
@@ -8,8 +8,19 @@
 #ifndef INC_UART_CLI_H_
 #define INC_UART_CLI_H_
 
-#define TOTAL_TASKS_TO_WATCH (20)
-#define MAX_CMD_LEN (100)
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cli_args.h"
+#include "cli_format.h"
+
+#define MAX_CMD_LEN (256)
+
+/* Separates commands sent on one line: `set_blink_rate red 100; uart stats`. */
+#define CLI_CMD_SEPARATOR   ';'
+
+/* While a line is being typed, wake at most this often (ms) to echo it. */
+#define CLI_ECHO_TIMEOUT (20)
 
 #define BACK_SPACE  0x7F
 #define ENTER       0x0D
@@ -23,9 +34,17 @@ typedef enum
     ALL,
 }PRIVILAGE_LEVEL;
 
-#define TOTAL_COMMANDS  ( sizeof(Command_Handlers) / sizeof(Command_Handlers[0]) )
+typedef enum
+{
+    CLI_OK,
+    CLI_FAILED,
+}CLI_STATUS;
+
+/* Handlers receive the line already split and converted against the command's schema. */
+typedef CLI_STATUS (*cmd_handler)(const CliArgs*);
 
-typedef void (*cmd_handler)(const char*);
+/* CliStruct flags */
+#define CLI_INLINE  (1U << 0)   /* Run in the CLI task itself, never on a job worker */
 
 typedef struct cli
 {
@@ -33,6 +52,9 @@ typedef struct cli
     cmd_handler handler;
     PRIVILAGE_LEVEL privilege_level;
     char* description;
+    const CliArgSpec* args;
+    uint8_t arg_count;
+    uint8_t flags;
 }CliStruct;
 
 typedef struct
@@ -51,4 +73,11 @@ void cli_printn(const char *ptr, const size_t);
 /* Format and send a string (like printf) over the CLI UART. */
 size_t cli_printf(const char *format, ...);
 
+/* Send everything the cli_print* functions produce to `sink` instead of the UART; NULL restores the UART.
+ * Job workers print through the same sink, so swap it only while cli_jobs_active() is 0. */
+void cli_set_output(cli_format_sink sink, void *context);
+
+/* Tokenize and run a single command (no `;` splitting). Returns the command's status. */
+CLI_STATUS cli_execute(char *line);
+
 #endif /* INC_UART_CLI_H_ */
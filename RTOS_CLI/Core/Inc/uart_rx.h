@@ -0,0 +1,67 @@
+/*
+ * uart_rx.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_UART_RX_H_
+#define INC_UART_RX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/* 1: circular DMA with IDLE/HT/TC chunk hand-off. 0: legacy one interrupt per byte, kept for comparison. */
+#ifndef UART_RX_USE_DMA
+#define UART_RX_USE_DMA     (1)
+#endif
+
+/* DMA landing buffer; HT and TC fire every half of it. */
+#define UART_RX_DMA_SIZE    (128U)
+
+/* Single-producer (RX ISRs) / single-consumer (CLI task) input ring. Power of two.
+ * Sized to hold a pasted batch of commands while the earlier ones are still running. */
+#define UART_RX_RING_SIZE   (1024U)
+
+/* Byte that ends a command line and always wakes the reader, until uart_rx_set_terminator() changes it. */
+#define UART_RX_TERMINATOR  ('\r')
+
+typedef struct
+{
+    uint32_t interrupts;    /* USART1 + DMA2 Stream2 entries that handled RX */
+    uint32_t bytes;         /* Bytes handed to the CLI */
+    uint32_t dropped;       /* Bytes lost: input ring full, USART overrun or a DMA lap */
+    uint32_t laps;          /* Times the DMA went round the whole buffer before it was drained; each drops a buffer */
+    uint32_t wakeups;       /* Times the ISRs woke the reader */
+    uint64_t isr_cycles;    /* DWT cycles spent in the RX handlers */
+    uint32_t isr_cycles_max;
+} UartRxStats;
+
+/* Start USART1 reception (DMA2 Stream2 / channel 4 circular, or RXNE) and enable its IRQs. Call after MX_USART1_UART_Init. */
+void uart_rx_init(void);
+
+/* Block until at least `trigger_level` bytes or a terminator are buffered, or `timeout` expires. Returns bytes available. */
+size_t uart_rx_wait(size_t trigger_level, TickType_t timeout);
+
+/* Copy up to `len` buffered bytes without consuming them. */
+size_t uart_rx_peek(uint8_t *data, size_t len);
+
+/* Consume up to `len` buffered bytes. Never blocks. */
+size_t uart_rx_read(uint8_t *data, size_t len);
+
+/* Number of complete lines (terminators) currently buffered. Does not consume anything. */
+uint32_t uart_rx_lines_pending(void);
+
+/* Switch the wake-up byte (e.g. the 0x00 frame delimiter in binary mode); input already buffered is recounted. Reader only. */
+void uart_rx_set_terminator(uint8_t terminator);
+
+/* Longest time received bytes can wait in the DMA buffer before the reader sees them, at the current baud rate.
+ * Input quiet for this long has really stopped; the CLI uses it to tell the end of a pasted batch. */
+TickType_t uart_rx_latency(void);
+
+/* Snapshot of the RX counters. */
+void uart_rx_get_stats(UartRxStats *stats);
+
+#endif /* INC_UART_RX_H_ */
@@ -0,0 +1,57 @@
+/*
+ * uart_tx.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ */
+
+#ifndef INC_UART_TX_H_
+#define INC_UART_TX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/* Must be a power of two, the ring indices run free and are masked on use. */
+#define UART_TX_RING_SIZE   (1024U)
+
+typedef enum
+{
+    UART_TX_BLOCKING,       /* Writer sleeps until the DMA frees space */
+    UART_TX_NON_BLOCKING,   /* Whatever does not fit is dropped and counted */
+} UART_TX_POLICY;
+
+typedef struct
+{
+    uint32_t bytes_queued;
+    uint32_t bytes_dropped;
+    uint32_t stalls;        /* Times a writer found the ring full and had to wait */
+    uint32_t stall_ticks;   /* Ticks spent waiting in those stalls */
+    uint32_t dma_transfers;
+    uint32_t dma_errors;
+} UartTxStats;
+
+/* Configure DMA2 Stream7 for USART1 TX and create the ring locks. Call after MX_USART1_UART_Init. */
+void uart_tx_init(void);
+
+/* Copy `len` bytes into the TX ring and kick the DMA. Returns the number of bytes accepted. */
+size_t uart_tx_write(const uint8_t *data, size_t len);
+
+/* Hold the ring across several writes so a formatted line is not interleaved with other tasks. Nests. */
+void uart_tx_lock(void);
+
+void uart_tx_unlock(void);
+
+/* Wait until the ring is empty and the last stop bit has left the pin. Returns pdFALSE on timeout. */
+BaseType_t uart_tx_flush(TickType_t timeout);
+
+/* Select what a writer does when the ring is full. */
+void uart_tx_set_policy(UART_TX_POLICY policy);
+
+UART_TX_POLICY uart_tx_get_policy(void);
+
+/* Snapshot of the TX counters. */
+void uart_tx_get_stats(UartTxStats *stats);
+
+#endif /* INC_UART_TX_H_ */
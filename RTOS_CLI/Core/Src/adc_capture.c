@@ -0,0 +1,409 @@
+/*
+ * adc_capture.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Triggered capture of one channel, fed by the ADC task with every block
+ *  it publishes, so it sees every sample at the full TIM3 rate without a
+ *  copy of its own on the way in.
+ *
+ *  Once armed, each block goes into a ring of ADC_CAPTURE_SAMPLES, and the
+ *  whole block is searched for the trigger in one adc_dsp_find_trigger()
+ *  call, two samples per SIMD step. The search only starts once the ring
+ *  holds the samples wanted before the trigger. After the trigger only the
+ *  samples still wanted are written, so the ring ends up holding exactly
+ *  the capture and is frozen as it is: no copy on the way out either. A
+ *  block lost before the trigger restarts the ring, so the capture never
+ *  spans a gap it does not report.
+ *
+ *  `capture dump <offset>` returns one record of ADC_CAPTURE_DUMP_SAMPLES
+ *  per request on the binary protocol, all fields little endian:
+ *
+ *      0   u8   format (ADC_CAPTURE_DUMP_FORMAT)
+ *      1   u8   channel
+ *      2   u8   trigger (ADC_TRIGGER)
+ *      3   u8   reserved, 0
+ *      4   u32  sample period, us
+ *      8   u16  trigger level, 12-bit code
+ *      10  u16  samples before the trigger
+ *      12  u16  samples in the capture
+ *      14  u16  offset of the first sample in this record
+ *      16  u16  samples in this record
+ *      18  ...  the samples, 12 bits each: two in three bytes, low bits first
+ *
+ *  `cli_proto_client <tty> --capture <file>` fetches them all into a CSV.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* -- User Library -- */
+#include "adc_capture.h"
+#include "cli_proto.h"
+#include "cli_registry.h"
+#include "uart_cli.h"
+#include "uart_tx.h"
+
+#define CAPTURE_RING_MASK   (ADC_CAPTURE_SAMPLES - 1U)
+
+/* -- Function Declarations -- */
+
+/* `capture [<channel> <level> [edge] [post] | stop | dump <offset>]`. */
+static CLI_STATUS capture_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+/* Written by the ADC task until the capture is done; read by the CLI only after that, in a critical section. */
+static uint16_t Ring[ADC_CAPTURE_SAMPLES];
+static uint32_t Head;               /* Next slot written */
+static uint32_t Filled;             /* Samples written since arming, up to ADC_CAPTURE_SAMPLES */
+static uint32_t Remaining;          /* Samples after the trigger still to take */
+static uint32_t Trigger_At;         /* Slot of the trigger sample */
+static uint32_t Last_Sequence;
+static uint16_t Last_Sample;
+
+static AdcCaptureInfo Info;
+
+/* Held by `capture dump` from filling its record buffers until the record is sent. */
+static SemaphoreHandle_t Dump_Lock;
+
+static const char *const Capture_Keywords[] = { "dump", "stop" };
+static const char *const Capture_Triggers[] = { "rising", "falling", "above", "below" };
+static const char *const Capture_States[] = { "idle", "armed", "triggered", "done" };
+
+static const CliArgSpec Capture_Args[] =
+{
+    { "channel", CLI_ARG_INT, .optional = 1, .min = 0, .max = ADC_CHANNELS - 1, .choices = Capture_Keywords,
+      .choice_count = CLI_ARG_COUNT(Capture_Keywords) },
+    { "level", CLI_ARG_INT, .optional = 1, .min = 0, .max = 4095 },
+    { "edge", CLI_ARG_ENUM, .optional = 1, .choices = Capture_Triggers, .choice_count = CLI_ARG_COUNT(Capture_Triggers) },
+    { "post", CLI_ARG_INT, .optional = 1, .min = 1, .max = ADC_CAPTURE_SAMPLES },
+};
+
+CLI_COMMAND_ARGS("capture", capture_command, ALL, "Triggered capture of one ADC channel, dumped in binary", Capture_Args);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Ring Write -- */
+static inline void ring_write(const uint16_t *samples, size_t count)
+{
+    const size_t first = (count < ADC_CAPTURE_SAMPLES - Head) ? count : ADC_CAPTURE_SAMPLES - Head;
+
+    memcpy(&Ring[Head], samples, first * sizeof(Ring[0]));
+    memcpy(Ring, samples + first, (count - first) * sizeof(Ring[0]));
+
+    Head = (Head + (uint32_t) count) & CAPTURE_RING_MASK;
+    Filled = (Filled + count < ADC_CAPTURE_SAMPLES) ? Filled + (uint32_t) count : ADC_CAPTURE_SAMPLES;
+}
+
+/* -- Search Block -- */
+/* Returns the index of the trigger sample in the block, ADC_BLOCK_SCANS if it is not there. */
+static inline size_t capture_search(const uint16_t *samples)
+{
+    /* Not before the ring holds the samples wanted ahead of the trigger, nor without one for the edge to compare. */
+    size_t start = (Filled < Info.pre) ? Info.pre - Filled : 0;
+
+    if (Filled == 0 && start == 0)
+    {
+        start = 1;
+    }
+    if (start >= ADC_BLOCK_SCANS)
+    {
+        return ADC_BLOCK_SCANS;
+    }
+
+    const uint16_t previous = (start == 0) ? Last_Sample : samples[start - 1];
+    const uint32_t begin = DWT->CYCCNT;
+    const size_t hit = start + adc_dsp_find_trigger(&samples[start], ADC_BLOCK_SCANS - start, previous, Info.level,
+                                                    Info.trigger);
+    const uint32_t cycles = DWT->CYCCNT - begin;
+
+    Info.blocks++;
+    Info.search_cycles += cycles;
+    if (cycles > Info.search_cycles_max)
+    {
+        Info.search_cycles_max = cycles;
+    }
+
+    return hit;
+}
+
+static inline void put_le16(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t) (value >> 8);
+}
+
+static inline void put_le32(uint8_t *out, uint32_t value)
+{
+    put_le16(out, value);
+    put_le16(out + 2, value >> 16);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Capture Functions                             */
+/* -------------------------------------------------------------------------- */
+
+/* -- Capture Init -- */
+void adc_capture_init(void)
+{
+    Dump_Lock = xSemaphoreCreateMutex();
+    assert_param(Dump_Lock != NULL);
+}
+
+/* -- Arm -- */
+void adc_capture_arm(uint32_t channel, uint16_t level, ADC_TRIGGER trigger, uint32_t post)
+{
+    post = (post < 1U) ? 1U : (post > ADC_CAPTURE_SAMPLES) ? ADC_CAPTURE_SAMPLES : post;
+
+    taskENTER_CRITICAL();
+    Info = (AdcCaptureInfo)
+    {
+        .state = ADC_CAPTURE_ARMED,
+        .trigger = trigger,
+        .channel = (uint8_t) ((channel < ADC_CHANNELS) ? channel : 0U),
+        .level = (level > 4095U) ? 4095U : level,
+        .pre = (uint16_t) (ADC_CAPTURE_SAMPLES - post),
+        .armed_at = xTaskGetTickCount(),
+    };
+    Head = 0;
+    Filled = 0;
+    Remaining = 0;
+    taskEXIT_CRITICAL();
+}
+
+void adc_capture_stop(void)
+{
+    taskENTER_CRITICAL();
+    Info.state = ADC_CAPTURE_IDLE;
+    taskEXIT_CRITICAL();
+}
+
+void adc_capture_get_info(AdcCaptureInfo *info)
+{
+    taskENTER_CRITICAL();
+    *info = Info;
+    taskEXIT_CRITICAL();
+}
+
+/* -- Read Capture -- */
+/* One critical section over the info and the copy: an arm from another CLI worker, and the ADC task refilling the
+ * ring after it, wait until the record is taken. A whole dump record is a few microseconds of copying. */
+size_t adc_capture_read(AdcCaptureInfo *info, uint16_t *out, size_t offset, size_t count)
+{
+    taskENTER_CRITICAL();
+    *info = Info;
+    if (Info.state != ADC_CAPTURE_DONE || offset >= ADC_CAPTURE_SAMPLES)
+    {
+        taskEXIT_CRITICAL();
+        return 0;
+    }
+
+    const uint32_t first = (Trigger_At - Info.pre + (uint32_t) offset) & CAPTURE_RING_MASK;
+
+    count = (count < ADC_CAPTURE_SAMPLES - offset) ? count : ADC_CAPTURE_SAMPLES - offset;
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = Ring[(first + i) & CAPTURE_RING_MASK];
+    }
+    taskEXIT_CRITICAL();
+
+    return count;
+}
+
+/* -- Feed Block -- */
+void adc_capture_block(const AdcBlock *block)
+{
+    if (Info.state != ADC_CAPTURE_ARMED && Info.state != ADC_CAPTURE_TRIGGERED)
+    {
+        return;
+    }
+
+    const uint16_t *const samples = block->samples[Info.channel];
+    const uint8_t gap = (Filled != 0 && block->sequence != Last_Sequence + 1U);
+    size_t take = ADC_BLOCK_SCANS;
+
+    if (Info.state == ADC_CAPTURE_ARMED)
+    {
+        if (gap)
+        {
+            Filled = 0;
+        }
+
+        const size_t hit = capture_search(samples);
+
+        if (hit < ADC_BLOCK_SCANS)
+        {
+            Trigger_At = (Head + (uint32_t) hit) & CAPTURE_RING_MASK;
+            Remaining = ADC_CAPTURE_SAMPLES - Info.pre;
+            take = (hit + Remaining < ADC_BLOCK_SCANS) ? hit + Remaining : ADC_BLOCK_SCANS;
+            Remaining -= (uint32_t) (take - hit);
+
+            Info.period_us = block->period_us;
+            Info.sequence = block->sequence;
+            Info.triggered_at = xTaskGetTickCount();
+            Info.state = ADC_CAPTURE_TRIGGERED;
+        }
+    }
+    else
+    {
+        Info.gaps += gap;
+        take = (Remaining < ADC_BLOCK_SCANS) ? Remaining : ADC_BLOCK_SCANS;
+        Remaining -= (uint32_t) take;
+    }
+
+    ring_write(samples, take);
+    Last_Sample = samples[take - 1];
+    Last_Sequence = block->sequence;
+
+    if (Info.state == ADC_CAPTURE_TRIGGERED && Remaining == 0)
+    {
+        Info.state = ADC_CAPTURE_DONE;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Capture Command                              */
+/* -------------------------------------------------------------------------- */
+
+/* -- Dump Record -- */
+/* Raw bytes: only the binary protocol carries them intact, each record in one response frame. The buffers are too
+ * big for a CLI worker's stack, so two dumps on two workers take turns with them. */
+static CLI_STATUS capture_dump(uint32_t offset)
+{
+    static uint16_t samples[ADC_CAPTURE_DUMP_SAMPLES];
+    static uint8_t record[ADC_CAPTURE_DUMP_HEADER + ADC_CAPTURE_DUMP_SAMPLES * 3U / 2U];
+    AdcCaptureInfo info;
+
+    if (cli_proto_mode() != CLI_PROTO_BINARY)
+    {
+        cli_print("capture dump needs the binary protocol, see \"proto\"\r\n");
+        return CLI_FAILED;
+    }
+
+    xSemaphoreTake(Dump_Lock, portMAX_DELAY);
+
+    /* The header comes from the same read as the samples, never from a capture armed since. */
+    const size_t count = adc_capture_read(&info, samples, offset, ADC_CAPTURE_DUMP_SAMPLES);
+    if (count == 0)
+    {
+        xSemaphoreGive(Dump_Lock);
+        cli_print((info.state != ADC_CAPTURE_DONE) ? "No capture to dump\r\n" : "Offset past the capture\r\n");
+        return CLI_FAILED;
+    }
+
+    uint8_t *out = record + ADC_CAPTURE_DUMP_HEADER;
+    size_t i = 0;
+
+    record[0] = ADC_CAPTURE_DUMP_FORMAT;
+    record[1] = info.channel;
+    record[2] = (uint8_t) info.trigger;
+    record[3] = 0;
+    put_le32(&record[4], info.period_us);
+    put_le16(&record[8], info.level);
+    put_le16(&record[10], info.pre);
+    put_le16(&record[12], ADC_CAPTURE_SAMPLES);
+    put_le16(&record[14], offset);
+    put_le16(&record[16], (uint32_t) count);
+
+    for (; i + 1 < count; i += 2)
+    {
+        *out++ = (uint8_t) samples[i];
+        *out++ = (uint8_t) ((samples[i] >> 8) | (samples[i + 1] << 4));
+        *out++ = (uint8_t) (samples[i + 1] >> 4);
+    }
+    if (i < count)
+    {
+        put_le16(out, samples[i]);
+        out += 2;
+    }
+
+    cli_printn((const char*) record, (size_t) (out - record));
+    xSemaphoreGive(Dump_Lock);
+
+    return CLI_OK;
+}
+
+/* -- Capture Status -- */
+static CLI_STATUS capture_status(void)
+{
+    AdcCaptureInfo info;
+
+    adc_capture_get_info(&info);
+
+    uart_tx_lock();
+    if (info.state == ADC_CAPTURE_IDLE)
+    {
+        cli_print("State   : idle; arm with \"capture <channel> <level> [edge] [post]\"\r\n");
+        uart_tx_unlock();
+        return CLI_OK;
+    }
+
+    cli_printf("State   : %s\r\n", Capture_States[info.state]);
+    cli_printf("Trigger : IN%u %s at %u (%lu mV); %u samples before it, %u from it on\r\n", info.channel,
+               Capture_Triggers[info.trigger], info.level, (unsigned long) (info.level * ADC_VREF_MV / 4095U),
+               info.pre, ADC_CAPTURE_SAMPLES - info.pre);
+    if (info.blocks != 0)
+    {
+        cli_printf("Search  : %lu blocks, %lu cycles per block on average, %lu at most\r\n", (unsigned long) info.blocks,
+                   (unsigned long) (info.search_cycles / info.blocks), (unsigned long) info.search_cycles_max);
+    }
+    if (info.state != ADC_CAPTURE_ARMED)
+    {
+        cli_printf("Fired   : %lu ms after arming, in block %lu, %lu us per sample; %lu blocks lost after it\r\n",
+                   (unsigned long) ((info.triggered_at - info.armed_at) * portTICK_PERIOD_MS),
+                   (unsigned long) info.sequence, (unsigned long) info.period_us, (unsigned long) info.gaps);
+    }
+    uart_tx_unlock();
+
+    return CLI_OK;
+}
+
+/* -- Capture Command -- */
+static CLI_STATUS capture_command(const CliArgs *args)
+{
+    if (!args->arg[0].present)
+    {
+        return capture_status();
+    }
+
+    switch (args->arg[0].keyword)
+    {
+        case 1: // dump
+            return capture_dump(args->arg[1].present ? (uint32_t) args->arg[1].value : 0U);
+
+        case 2: // stop
+            adc_capture_stop();
+            cli_print("Capture stopped\r\n");
+            return CLI_OK;
+
+        default:
+            break;
+    }
+
+    if (!args->arg[1].present)
+    {
+        cli_print("Usage: capture <channel> <level> [rising|falling|above|below] [post]\r\n");
+        return CLI_FAILED;
+    }
+
+    const ADC_TRIGGER trigger = args->arg[2].present ? (ADC_TRIGGER) args->arg[2].value : ADC_TRIGGER_RISING;
+    const uint32_t post = args->arg[3].present ? (uint32_t) args->arg[3].value : ADC_CAPTURE_SAMPLES / 2U;
+
+    adc_capture_arm((uint32_t) args->arg[0].value, (uint16_t) args->arg[1].value, trigger, post);
+    cli_printf("Armed: IN%ld %s at %ld, %lu samples before the trigger and %lu from it on\r\n", (long) args->arg[0].value,
+               Capture_Triggers[trigger], (long) args->arg[1].value, (unsigned long) (ADC_CAPTURE_SAMPLES - post),
+               (unsigned long) post);
+    return CLI_OK;
+}
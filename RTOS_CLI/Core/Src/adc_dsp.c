@@ -0,0 +1,703 @@
+/*
+ * adc_dsp.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  The ADC task runs each channel's block through to_q15, the DC blocker
+ *  (AC channels only), the CIC decimator and the FIR low-pass. The
+ *  kernels handle two samples per 32-bit load:
+ *
+ *    to_q15   : SSUB16 takes mid-scale off both halves, one shift scales both
+ *    dc_block : QSUB16 forms two saturated differences; the pole is scalar
+ *    cic      : add-only and sequential, so no SIMD: integrators kept in
+ *               registers and one comb pass per ADC_DSP_DECIMATION inputs
+ *    fir      : SMLAD does two taps per cycle; two outputs per pass share
+ *               each coefficient load, the odd-aligned window built by PKHBT
+ *
+ *  Oversampling, when enabled for a channel, works on the raw samples:
+ *
+ *    oversample : SMLAD against 0x00010001 adds two samples per instruction
+ *
+ *  and the capture's trigger search on one channel's block:
+ *
+ *    find_trigger : SSUB16 against the level in both halves; the two sign
+ *                   bits say which samples are below it, and one test per
+ *                   pair finds a hit
+ *
+ *  and `adc fft`, on 1024 samples of one channel:
+ *
+ *    fft          : radix-4 decimation in frequency on packed complex Q15.
+ *                   SHADD16 / SHSUB16 / SHASX / SHSAX form a butterfly's
+ *                   four outputs with both parts at once, halving as they
+ *                   go; SMUSD and SMUADX give a twiddle product's real and
+ *                   imaginary part in one instruction each
+ *
+ *  The _ref versions are the textbook loops. They compute the same output
+ *  bit for bit (Host/Test/adc_dsp_test.c checks this) and are what
+ *  `bench dsp` measures the kernels against.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- User Library -- */
+#include "adc_dsp.h"
+
+#define ADC_DSP_MID_SCALE   (2048)
+
+#define FFT_QUARTER         (ADC_DSP_FFT_SIZE / 4U)
+#define FFT_STAGES          (5U)
+
+#if (ADC_DSP_FFT_SIZE != (1U << (2U * FFT_STAGES)))
+#error "adc_dsp_fft() is radix-4 only: ADC_DSP_FFT_SIZE must be 4^FFT_STAGES"
+#endif
+
+#if (ADC_DSP_CIC_ORDER != 3U)
+#error "adc_dsp_cic() keeps exactly three integrators in registers"
+#endif
+
+/* -- Global Variables -- */
+
+const int16_t ADC_DSP_LOWPASS[ADC_DSP_FIR_TAPS] =
+{
+    -106, -71, 400, 446, -1485, -1895, 4906, 14188, 14188, 4906, -1895, -1485, 446, 400, -71, -106,
+};
+
+/* sin(2 pi i / ADC_DSP_FFT_SIZE) in Q15 over the first quarter turn, both ends included; the rest follows by symmetry. */
+static const int16_t Fft_Sine[FFT_QUARTER + 1U] =
+{
+        0,   201,   402,   603,   804,  1005,  1206,  1407,  1608,  1809,  2009,  2210,  2410,  2611,  2811,  3012,
+     3212,  3412,  3612,  3811,  4011,  4210,  4410,  4609,  4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,
+     6393,  6590,  6786,  6983,  7179,  7375,  7571,  7767,  7962,  8157,  8351,  8545,  8739,  8933,  9126,  9319,
+     9512,  9704,  9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+    12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+    15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+    18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+    20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+    23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+    25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+    27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+    28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+    30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+    31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+    32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+    32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+    32767,
+};
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Saturate to Q15 -- */
+static inline int16_t saturate_q15(const int32_t value)
+{
+    return (int16_t) ((value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value);
+}
+
+/* -- DC Blocker Step -- */
+/* Pole times y[n-1] stays within 2^30, as does a saturated difference times 2^15: the sum fits int32. */
+static inline int32_t dc_block_step(const int32_t difference, const int32_t y)
+{
+    return __SSAT((difference * 32768 + ADC_DSP_DC_POLE * y) >> 15, 16);
+}
+
+/* -- CIC Combs -- */
+/* Integrators wrap by design; the combs undo it, leaving at most 2^15 * ADC_DSP_DECIMATION ^ ADC_DSP_CIC_ORDER. */
+static inline int16_t cic_combs(AdcCic *cic, uint32_t value)
+{
+    for (uint32_t stage = 0; stage < ADC_DSP_CIC_ORDER; ++stage)
+    {
+        const uint32_t difference = value - (uint32_t) cic->comb[stage];
+
+        cic->comb[stage] = (int32_t) value;
+        value = difference;
+    }
+
+    return (int16_t) ((int32_t) value >> ADC_DSP_CIC_SHIFT);
+}
+
+/* -- FIR Single Output -- */
+static inline int16_t fir_output(const int16_t *coeffs, const int16_t *x)
+{
+    uint32_t acc = 0;
+
+    for (uint32_t k = 0; k < ADC_DSP_FIR_TAPS; k += 2)
+    {
+        acc = __SMLAD(__UNALIGNED_UINT32_READ(&x[k]), __UNALIGNED_UINT32_READ(&coeffs[k]), acc);
+    }
+
+    return (int16_t) __SSAT((int32_t) acc >> 15, 16);
+}
+
+/* -- Oversampled Result -- */
+/* Round to 12 + shift bits, then left-align. Full scale 4095 * 4^shift rounds to 4095 * 2^shift: no carry out. */
+static inline uint16_t oversample_result(const uint32_t sum, const uint32_t shift)
+{
+    const uint32_t rounded = (sum + ((1UL << shift) >> 1)) >> shift;
+
+    return (uint16_t) (rounded << (ADC_DSP_OVERSAMPLE_MAX_SHIFT - shift));
+}
+
+/* -- FFT Sine -- */
+/* sin(2 pi i / ADC_DSP_FFT_SIZE), any i. */
+static inline int32_t fft_sine(uint32_t i)
+{
+    i &= ADC_DSP_FFT_SIZE - 1U;
+
+    if (i <= FFT_QUARTER)
+    {
+        return Fft_Sine[i];
+    }
+    if (i <= 2U * FFT_QUARTER)
+    {
+        return Fft_Sine[2U * FFT_QUARTER - i];
+    }
+    if (i <= 3U * FFT_QUARTER)
+    {
+        return -Fft_Sine[i - 2U * FFT_QUARTER];
+    }
+    return -Fft_Sine[ADC_DSP_FFT_SIZE - i];
+}
+
+/* -- FFT Twiddle -- */
+/* e^(-j 2 pi i / ADC_DSP_FFT_SIZE), packed: cos in the low half, -sin in the high half. */
+static inline uint32_t fft_twiddle(uint32_t i)
+{
+    return __PKHBT(fft_sine(i + FFT_QUARTER), -fft_sine(i), 16);
+}
+
+/* -- FFT Rotate -- */
+/* x * w, truncated back to Q15. PKHBT with LSL 1 takes bits 30..15 of the imaginary product. */
+static inline uint32_t fft_rotate(uint32_t x, uint32_t w)
+{
+    const int32_t re = (int32_t) __SMUSD(x, w);
+    const int32_t im = (int32_t) __SMUADX(x, w);
+
+    return __PKHBT(re >> 15, im, 1);
+}
+
+/* -- Integer Square Root -- */
+static inline uint32_t isqrt32(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  DSP State                                 */
+/* -------------------------------------------------------------------------- */
+
+void adc_dsp_dc_block_init(AdcDcBlock *dc)
+{
+    *dc = (AdcDcBlock) { 0 };
+}
+
+void adc_dsp_cic_init(AdcCic *cic)
+{
+    *cic = (AdcCic) { 0 };
+}
+
+void adc_dsp_fir_init(AdcFir *fir, const int16_t *coeffs)
+{
+    for (uint32_t k = 0; k < ADC_DSP_FIR_TAPS; ++k)
+    {
+        fir->coeffs[k] = coeffs[ADC_DSP_FIR_TAPS - 1U - k];
+    }
+    memset(fir->window, 0, sizeof(fir->window));
+}
+
+void adc_dsp_oversample_init(AdcOversampler *os, uint32_t shift)
+{
+    *os = (AdcOversampler) { .shift = (shift > ADC_DSP_OVERSAMPLE_MAX_SHIFT) ? ADC_DSP_OVERSAMPLE_MAX_SHIFT : shift };
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                SIMD Kernels                                */
+/* -------------------------------------------------------------------------- */
+
+/* -- To Q15 -- */
+/* After SSUB16 each half is within +/-2^11, so the bits the shift carries across halves are cleared by the mask. */
+void adc_dsp_to_q15(const uint16_t *in, int16_t *out, size_t count)
+{
+    size_t n = 0;
+
+    for (; n + 1 < count; n += 2)
+    {
+        const uint32_t centred = __SSUB16(__UNALIGNED_UINT32_READ(&in[n]), 0x08000800U);
+
+        __UNALIGNED_UINT32_WRITE(&out[n], (centred << 4) & 0xFFF0FFF0U);
+    }
+
+    if (n < count)
+    {
+        out[n] = (int16_t) (((int32_t) in[n] - ADC_DSP_MID_SCALE) * 16);
+    }
+}
+
+/* -- DC Blocker -- */
+void adc_dsp_dc_block(AdcDcBlock *dc, const int16_t *in, int16_t *out, size_t count)
+{
+    uint32_t previous = (uint16_t) dc->x;
+    int32_t y = dc->y;
+    size_t n = 0;
+
+    for (; n + 1 < count; n += 2)
+    {
+        const uint32_t x = __UNALIGNED_UINT32_READ(&in[n]);               /* x[n+1] : x[n] */
+        const uint32_t delayed = __PKHBT(previous, x, 16);               /* x[n]   : x[n-1] */
+        const uint32_t difference = __QSUB16(x, delayed);
+
+        y = dc_block_step((int16_t) difference, y);
+        out[n] = (int16_t) y;
+        y = dc_block_step((int16_t) (difference >> 16), y);
+        out[n + 1] = (int16_t) y;
+        previous = x >> 16;
+    }
+
+    if (n < count)
+    {
+        const int16_t x = in[n];
+
+        y = dc_block_step(__SSAT((int32_t) x - (int16_t) previous, 16), y);
+        out[n] = (int16_t) y;
+        previous = (uint16_t) x;
+    }
+
+    dc->x = (int16_t) previous;
+    dc->y = (int16_t) y;
+}
+
+/* -- CIC Decimator -- */
+size_t adc_dsp_cic(AdcCic *cic, const int16_t *in, int16_t *out, size_t count)
+{
+    uint32_t i0 = (uint32_t) cic->integrator[0];
+    uint32_t i1 = (uint32_t) cic->integrator[1];
+    uint32_t i2 = (uint32_t) cic->integrator[2];
+    uint32_t phase = cic->phase;
+    size_t written = 0;
+    size_t n = 0;
+
+    while (n < count)
+    {
+        if (phase == 0 && count - n >= ADC_DSP_DECIMATION)
+        {
+            for (uint32_t k = 0; k < ADC_DSP_DECIMATION; ++k)
+            {
+                i0 += (uint32_t) (int32_t) in[n + k];
+                i1 += i0;
+                i2 += i1;
+            }
+            n += ADC_DSP_DECIMATION;
+            out[written++] = cic_combs(cic, i2);
+            continue;
+        }
+
+        i0 += (uint32_t) (int32_t) in[n++];
+        i1 += i0;
+        i2 += i1;
+        if (++phase == ADC_DSP_DECIMATION)
+        {
+            phase = 0;
+            out[written++] = cic_combs(cic, i2);
+        }
+    }
+
+    cic->integrator[0] = (int32_t) i0;
+    cic->integrator[1] = (int32_t) i1;
+    cic->integrator[2] = (int32_t) i2;
+    cic->phase = phase;
+    return written;
+}
+
+/* -- FIR -- */
+void adc_dsp_fir(AdcFir *fir, const int16_t *in, int16_t *out, size_t count)
+{
+    int16_t *const window = fir->window;
+    size_t n = 0;
+
+    memcpy(&window[ADC_DSP_FIR_TAPS - 1U], in, count * sizeof(*in));
+
+    for (; n + 1 < count; n += 2)
+    {
+        const int16_t *const x = &window[n];
+        uint32_t acc0 = 0, acc1 = 0;
+        uint32_t x0 = __UNALIGNED_UINT32_READ(&x[0]);
+
+        for (uint32_t k = 0; k < ADC_DSP_FIR_TAPS; k += 2)
+        {
+            const uint32_t c = __UNALIGNED_UINT32_READ(&fir->coeffs[k]);
+            const uint32_t x2 = __UNALIGNED_UINT32_READ(&x[k + 2]);
+            const uint32_t x1 = __PKHBT(x0 >> 16, x2, 16);              /* x[k+2] : x[k+1] */
+
+            acc0 = __SMLAD(x0, c, acc0);
+            acc1 = __SMLAD(x1, c, acc1);
+            x0 = x2;
+        }
+
+        out[n] = (int16_t) __SSAT((int32_t) acc0 >> 15, 16);
+        out[n + 1] = (int16_t) __SSAT((int32_t) acc1 >> 15, 16);
+    }
+
+    if (n < count)
+    {
+        out[n] = fir_output(fir->coeffs, &window[n]);
+    }
+
+    memmove(window, &window[count], (ADC_DSP_FIR_TAPS - 1U) * sizeof(*window));
+}
+
+/* -- Oversample -- */
+/* 12-bit samples are positive as signed halves too, and 256 of them sum well inside 32 bits. */
+size_t adc_dsp_oversample(AdcOversampler *os, const uint16_t *in, uint16_t *out, size_t count)
+{
+    const uint32_t ratio = 1UL << (2U * os->shift);
+    uint32_t sum = os->sum;
+    uint32_t pending = os->pending;
+    size_t written = 0;
+    size_t n = 0;
+
+    while (n < count)
+    {
+        const size_t run = (ratio - pending < count - n) ? ratio - pending : count - n;
+        const size_t end = n + run;
+
+        for (; n + 1 < end; n += 2)
+        {
+            sum = __SMLAD(__UNALIGNED_UINT32_READ(&in[n]), 0x00010001U, sum);
+        }
+        if (n < end)
+        {
+            sum += in[n++];
+        }
+
+        pending += (uint32_t) run;
+        if (pending == ratio)
+        {
+            out[written++] = oversample_result(sum, os->shift);
+            sum = 0;
+            pending = 0;
+        }
+    }
+
+    os->sum = sum;
+    os->pending = pending;
+    return written;
+}
+
+/* -- Find Trigger -- */
+/* `below` holds bit 15 / bit 31 for samples below the level. Each pair's predecessors are the same bits moved up
+ * one lane, the first from the pair before. A trigger fires where (predecessor ^ flip_before | any_before) and
+ * (below ^ flip) are both set. */
+size_t adc_dsp_find_trigger(const uint16_t *in, size_t count, uint16_t previous, uint16_t level, ADC_TRIGGER trigger)
+{
+    const uint32_t levels = __PKHBT(level, level, 16);
+    const uint32_t flip_before = (trigger == ADC_TRIGGER_FALLING) ? 0x80008000U : 0;
+    const uint32_t any_before = (trigger == ADC_TRIGGER_ABOVE || trigger == ADC_TRIGGER_BELOW) ? 0x80008000U : 0;
+    const uint32_t flip = (trigger == ADC_TRIGGER_RISING || trigger == ADC_TRIGGER_ABOVE) ? 0x80008000U : 0;
+    uint32_t carry = (previous < level) ? 0x8000U : 0;
+    size_t n = 0;
+
+    /* 12-bit codes minus a 12-bit level cannot leave a signed half. */
+    for (; n + 1 < count; n += 2)
+    {
+        const uint32_t below = __SSUB16(__UNALIGNED_UINT32_READ(&in[n]), levels) & 0x80008000U;
+        const uint32_t before = (below << 16) | carry;
+        const uint32_t hits = ((before ^ flip_before) | any_before) & (below ^ flip) & 0x80008000U;
+
+        if (hits != 0)
+        {
+            return n + ((hits & 0x8000U) ? 0 : 1);
+        }
+        carry = below >> 16;
+    }
+
+    if (n < count)
+    {
+        const uint32_t below = (in[n] < level) ? 0x8000U : 0;
+
+        if (((carry ^ flip_before) | any_before) & (below ^ flip) & 0x8000U)
+        {
+            return n;
+        }
+    }
+
+    return count;
+}
+
+/* -- FFT Window -- */
+/* Hann: (1 - cos) / 2, from the same sine table as the twiddles. */
+void adc_dsp_fft_window(const uint16_t *in, uint32_t *out)
+{
+    for (uint32_t n = 0; n < ADC_DSP_FFT_SIZE; ++n)
+    {
+        const int32_t hann = (32767 - fft_sine(n + FFT_QUARTER)) >> 1;
+        const int32_t sample = ((int32_t) in[n] - ADC_DSP_MID_SCALE) * 16;
+
+        out[n] = (uint16_t) ((sample * hann) >> 15);
+    }
+}
+
+/* -- FFT -- */
+/* Each pass of a stage takes x[n], x[n + q], x[n + 2q], x[n + 3q] of one span to
+ *
+ *     y0 = a + b + c + d        y1 = (a - c) - j(b - d)
+ *     y2 = a - b + c - d        y3 = (a - c) + j(b - d)
+ *
+ * quartered, and stores y1..y3 rotated by w^n, w^2n, w^3n. Twiddles are fetched once per n for all spans, and
+ * n = 0 (every pass of the last stage) skips the rotations. */
+void adc_dsp_fft(uint32_t *data)
+{
+    for (uint32_t span = ADC_DSP_FFT_SIZE, stride = 1; span >= 4U; span /= 4U, stride *= 4U)
+    {
+        const uint32_t quarter = span / 4U;
+
+        for (uint32_t n = 0; n < quarter; ++n)
+        {
+            const uint32_t w1 = fft_twiddle(n * stride);
+            const uint32_t w2 = fft_twiddle(2U * n * stride);
+            const uint32_t w3 = fft_twiddle(3U * n * stride);
+
+            for (uint32_t base = n; base < ADC_DSP_FFT_SIZE; base += span)
+            {
+                uint32_t *const x = &data[base];
+                const uint32_t t0 = __SHADD16(x[0], x[2U * quarter]);
+                const uint32_t t1 = __SHSUB16(x[0], x[2U * quarter]);
+                const uint32_t t2 = __SHADD16(x[quarter], x[3U * quarter]);
+                const uint32_t t3 = __SHSUB16(x[quarter], x[3U * quarter]);
+
+                x[0] = __SHADD16(t0, t2);
+                if (n == 0)
+                {
+                    x[quarter] = __SHSAX(t1, t3);
+                    x[2U * quarter] = __SHSUB16(t0, t2);
+                    x[3U * quarter] = __SHASX(t1, t3);
+                }
+                else
+                {
+                    x[quarter] = fft_rotate(__SHSAX(t1, t3), w1);
+                    x[2U * quarter] = fft_rotate(__SHSUB16(t0, t2), w2);
+                    x[3U * quarter] = fft_rotate(__SHASX(t1, t3), w3);
+                }
+            }
+        }
+    }
+}
+
+/* -- FFT Bin -- */
+/* Decimation in frequency leaves bin k at k with its base-4 digits reversed. */
+uint32_t adc_dsp_fft_bin(uint32_t k)
+{
+    uint32_t position = 0;
+
+    for (uint32_t stage = 0; stage < FFT_STAGES; ++stage)
+    {
+        position = (position << 2) | (k & 3U);
+        k >>= 2;
+    }
+
+    return position;
+}
+
+/* -- FFT Magnitudes -- */
+/* SMUAD of a value with itself is re^2 + im^2; it fits: the parts are Q15 and the magnitude at most one. */
+void adc_dsp_fft_magnitudes(const uint32_t *data, uint16_t *magnitudes)
+{
+    for (uint32_t k = 0; k < ADC_DSP_FFT_BINS; ++k)
+    {
+        const uint32_t x = data[adc_dsp_fft_bin(k)];
+
+        magnitudes[k] = (uint16_t) isqrt32(__SMUAD(x, x));
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Reference Kernels                             */
+/* -------------------------------------------------------------------------- */
+
+void adc_dsp_to_q15_ref(const uint16_t *in, int16_t *out, size_t count)
+{
+    for (size_t n = 0; n < count; ++n)
+    {
+        out[n] = (int16_t) (((int32_t) in[n] - ADC_DSP_MID_SCALE) * 16);
+    }
+}
+
+void adc_dsp_dc_block_ref(AdcDcBlock *dc, const int16_t *in, int16_t *out, size_t count)
+{
+    for (size_t n = 0; n < count; ++n)
+    {
+        const int32_t difference = saturate_q15((int32_t) in[n] - dc->x);
+        const int32_t acc = difference * 32768 + ADC_DSP_DC_POLE * (int32_t) dc->y;
+
+        dc->x = in[n];
+        dc->y = saturate_q15(acc >> 15);
+        out[n] = dc->y;
+    }
+}
+
+size_t adc_dsp_cic_ref(AdcCic *cic, const int16_t *in, int16_t *out, size_t count)
+{
+    size_t written = 0;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        uint32_t value = (uint32_t) (int32_t) in[n];
+
+        for (uint32_t stage = 0; stage < ADC_DSP_CIC_ORDER; ++stage)
+        {
+            value += (uint32_t) cic->integrator[stage];
+            cic->integrator[stage] = (int32_t) value;
+        }
+
+        if (++cic->phase < ADC_DSP_DECIMATION)
+        {
+            continue;
+        }
+        cic->phase = 0;
+
+        for (uint32_t stage = 0; stage < ADC_DSP_CIC_ORDER; ++stage)
+        {
+            const uint32_t difference = value - (uint32_t) cic->comb[stage];
+
+            cic->comb[stage] = (int32_t) value;
+            value = difference;
+        }
+        out[written++] = (int16_t) ((int32_t) value >> ADC_DSP_CIC_SHIFT);
+    }
+
+    return written;
+}
+
+void adc_dsp_fir_ref(AdcFir *fir, const int16_t *in, int16_t *out, size_t count)
+{
+    int16_t *const window = fir->window;
+
+    memcpy(&window[ADC_DSP_FIR_TAPS - 1U], in, count * sizeof(*in));
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        int32_t acc = 0;
+
+        for (uint32_t k = 0; k < ADC_DSP_FIR_TAPS; ++k)
+        {
+            acc += (int32_t) fir->coeffs[k] * window[n + k];
+        }
+        out[n] = saturate_q15(acc >> 15);
+    }
+
+    memmove(window, &window[count], (ADC_DSP_FIR_TAPS - 1U) * sizeof(*window));
+}
+
+size_t adc_dsp_oversample_ref(AdcOversampler *os, const uint16_t *in, uint16_t *out, size_t count)
+{
+    size_t written = 0;
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        os->sum += in[n];
+        if (++os->pending == (1UL << (2U * os->shift)))
+        {
+            out[written++] = (uint16_t) (((os->sum + ((1UL << os->shift) >> 1)) >> os->shift)
+                                         << (ADC_DSP_OVERSAMPLE_MAX_SHIFT - os->shift));
+            os->sum = 0;
+            os->pending = 0;
+        }
+    }
+
+    return written;
+}
+
+size_t adc_dsp_find_trigger_ref(const uint16_t *in, size_t count, uint16_t previous, uint16_t level, ADC_TRIGGER trigger)
+{
+    for (size_t n = 0; n < count; ++n)
+    {
+        const uint16_t before = (n == 0) ? previous : in[n - 1];
+        uint8_t fires;
+
+        switch (trigger)
+        {
+            case ADC_TRIGGER_RISING:  fires = (before < level) && (in[n] >= level); break;
+            case ADC_TRIGGER_FALLING: fires = (before >= level) && (in[n] < level); break;
+            case ADC_TRIGGER_ABOVE:   fires = (in[n] >= level);                     break;
+            default:                  fires = (in[n] < level);                      break;
+        }
+
+        if (fires)
+        {
+            return n;
+        }
+    }
+
+    return count;
+}
+
+/* Real and imaginary parts kept apart, every halving and product written out. */
+void adc_dsp_fft_ref(uint32_t *data)
+{
+    for (uint32_t span = ADC_DSP_FFT_SIZE, stride = 1; span >= 4U; span /= 4U, stride *= 4U)
+    {
+        const uint32_t quarter = span / 4U;
+
+        for (uint32_t base = 0; base < ADC_DSP_FFT_SIZE; base += span)
+        {
+            for (uint32_t n = 0; n < quarter; ++n)
+            {
+                int32_t re[4], im[4];
+
+                for (uint32_t m = 0; m < 4U; ++m)
+                {
+                    re[m] = (int16_t) data[base + n + m * quarter];
+                    im[m] = (int16_t) (data[base + n + m * quarter] >> 16);
+                }
+
+                const int32_t t0r = (re[0] + re[2]) >> 1, t0i = (im[0] + im[2]) >> 1;
+                const int32_t t1r = (re[0] - re[2]) >> 1, t1i = (im[0] - im[2]) >> 1;
+                const int32_t t2r = (re[1] + re[3]) >> 1, t2i = (im[1] + im[3]) >> 1;
+                const int32_t t3r = (re[1] - re[3]) >> 1, t3i = (im[1] - im[3]) >> 1;
+                const int32_t yr[4] = { (t0r + t2r) >> 1, (t1r + t3i) >> 1, (t0r - t2r) >> 1, (t1r - t3i) >> 1 };
+                const int32_t yi[4] = { (t0i + t2i) >> 1, (t1i - t3r) >> 1, (t0i - t2i) >> 1, (t1i + t3r) >> 1 };
+
+                for (uint32_t m = 0; m < 4U; ++m)
+                {
+                    int32_t out_r = yr[m], out_i = yi[m];
+
+                    if (n != 0 && m != 0)
+                    {
+                        const int32_t c = fft_sine(m * n * stride + FFT_QUARTER);
+                        const int32_t s = -fft_sine(m * n * stride);
+
+                        out_r = (yr[m] * c - yi[m] * s) >> 15;
+                        out_i = (yr[m] * s + yi[m] * c) >> 15;
+                    }
+                    data[base + n + m * quarter] = (uint16_t) out_r | ((uint32_t) (uint16_t) out_i << 16);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * adc_stats.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Welford's update, one block at a time (Chan et al.'s pairwise form), in
+ *  integers only. A block is summarised exactly: its sum, its sum of
+ *  squares and from those its own M2. Merging it moves M2 by
+ *
+ *      M2 += M2_block + delta^2 * n_a * n_b / n
+ *
+ *  with delta the difference of the two means. Squared deviations are
+ *  never formed from one large sum of squares, so the variance keeps its
+ *  precision however long the channel runs. M2 overflows after about 10^12
+ *  full-scale square-wave samples, years at the ADC rate.
+ */
+
+/* -- User Library -- */
+#include "adc_stats.h"
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Integer Square Root -- */
+/* floor(sqrt(value)), one result bit per pass. */
+static inline uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t) root;
+}
+
+/* -- Quotient in Q16 -- */
+/* num / den without shifting num itself, which could overflow after long runs. */
+static inline uint64_t quotient_q16(const uint64_t num, const uint64_t den)
+{
+    return ((num / den) << 16) + ((num % den) << 16) / den;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               ADC Statistics                               */
+/* -------------------------------------------------------------------------- */
+
+void adc_stats_reset(AdcChannelStats *stats)
+{
+    *stats = (AdcChannelStats) { .min = UINT16_MAX, .max = 0 };
+}
+
+/* -- Merge Block -- */
+void adc_stats_update(AdcChannelStats *stats, const uint16_t *samples, size_t count)
+{
+    uint64_t squares = 0;
+    uint32_t sum = 0;
+    uint16_t min = stats->min, max = stats->max;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t sample = samples[i];
+
+        sum += sample;
+        squares += sample * sample;
+        min = (sample < min) ? (uint16_t) sample : min;
+        max = (sample > max) ? (uint16_t) sample : max;
+    }
+
+    /* The block's own M2: (n * sum(x^2) - sum(x)^2) / n, exact before the division. */
+    const uint64_t block_m2 = (count * squares - (uint64_t) sum * sum) / count;
+
+    if (stats->count != 0)
+    {
+        const uint64_t total = stats->count + count;
+        const int64_t delta = (int64_t) (((uint64_t) sum << 16) / count) - (int64_t) adc_stats_mean_q16(stats);
+        const uint64_t delta_sq = (uint64_t) (delta * delta) >> 16;     /* Q16 */
+
+        /* n_a * n_b / n as n_b - n_b^2 / n, which cannot overflow for any n_a. */
+        const uint64_t spread = delta_sq * count - delta_sq * count * count / total;
+
+        stats->m2 += block_m2 + (spread >> 16);
+    }
+    else
+    {
+        stats->m2 = block_m2;
+    }
+
+    stats->count += count;
+    stats->sum += sum;
+    stats->min = min;
+    stats->max = max;
+}
+
+uint32_t adc_stats_mean_q16(const AdcChannelStats *stats)
+{
+    return (stats->count != 0) ? (uint32_t) quotient_q16(stats->sum, stats->count) : 0;
+}
+
+uint32_t adc_stats_ac_rms_q8(const AdcChannelStats *stats)
+{
+    return (stats->count != 0) ? isqrt64(quotient_q16(stats->m2, stats->count)) : 0;
+}
+
+/* mean^2 + variance, in Q16. */
+uint32_t adc_stats_rms_q8(const AdcChannelStats *stats)
+{
+    const uint64_t mean = adc_stats_mean_q16(stats);
+
+    return (stats->count != 0) ? isqrt64(((mean * mean) >> 16) + quotient_q16(stats->m2, stats->count)) : 0;
+}
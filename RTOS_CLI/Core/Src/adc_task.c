@@ -3,69 +3,1148 @@
  *
  *  Created on: Jun 9, 2025
  *      Author: Ashish Bansal
+ *
+ *  ADC1 scans PA0..PA2 on every TIM3 update (TRGO). DMA2 Stream4 / channel 0
+ *  moves each conversion into Adc_Dma in circular mode, so the CPU is not
+ *  involved per sample at all: the only interrupts are the DMA half and
+ *  complete events, two per ADC_BLOCK_SCANS * 2 scans.
+ *
+ *  The interrupt sets one notification bit per finished half. The ADC task
+ *  then has a whole half period (20 ms at 200 us) to copy that half out,
+ *  de-interleaved, into a block from the pool and queue the block's pointer.
+ *  The same pass runs each channel through the adc_dsp.c filter chain into
+ *  block->filtered, and, for channels with a ratio set, sums the raw
+ *  samples into block->oversampled: a slow sensor traded 4^k samples for k
+ *  more bits. A triggered capture (adc_capture.c), when armed, sees the
+ *  block before it is published. Readers take and release blocks by pointer,
+ *  so a block is copied exactly once however far it travels. Each open
+ *  reader keeps its own sequence cursor and sees every published block, so
+ *  two commands reading at once do not take blocks from each other; a block
+ *  goes back to the pool once no reader holds it. A half the DMA finished
+ *  again before the task got to it is counted as lost. When no reader keeps
+ *  up, the task reuses the oldest published block nobody holds instead of
+ *  stopping acquisition.
+ *
+ *  `adc fft` is such a reader: it gathers ADC_DSP_FFT_SIZE consecutive
+ *  samples of one channel from back-to-back blocks, then windows and
+ *  transforms them in the CLI task, leaving the ADC task's budget alone.
+ *  `adc fft capture` transforms the last triggered capture instead, which
+ *  is one transform long. The size is fixed at build time: the twiddle
+ *  table and the digit-reversed order are laid out for 4^5 points.
+ *
+ *  Stream0 would be the other choice for ADC1, but SPI1 RX (spi.c) is set
+ *  up on it.
  */
-#if 0
+
 /* -- Standard Library -- */
-#include <stdio.h>
 #include <string.h>
 
 /* -- STM32 Library -- */
-#include "adc.h"
+#include "main.h"
+#include "stm32f4xx_ll_adc.h"
+#include "stm32f4xx_ll_bus.h"
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_gpio.h"
+#include "stm32f4xx_ll_tim.h"
 
 /* -- FreeRTOS Library -- */
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
 #include "semphr.h"
 
 /* -- User Library -- */
+#include "adc_capture.h"
+#include "adc_stats.h"
 #include "adc_task.h"
+#include "cli_proto.h"
+#include "cli_registry.h"
+#include "irq_stats.h"
+#include "uart_cli.h"
+#include "uart_tx.h"
+
+/* TIM3 sits on APB1 (HCLK / 4); APB1 timers run at twice PCLK1. */
+#define ADC_TIMER_CLOCK_HZ  (SystemCoreClock / 2U)
+
+#define ADC_DMA_STREAM      LL_DMA_STREAM_4
+#define ADC_DMA_ITEMS       (2U * ADC_BLOCK_SCANS * ADC_CHANNELS)
+
+/* Notification bits of the ADC task. */
+#define ADC_NOTIFY_HALF(n)  (1UL << (n))
+#define ADC_NOTIFY_HALVES   (ADC_NOTIFY_HALF(0) | ADC_NOTIFY_HALF(1))
+#define ADC_NOTIFY_RESTART  (1UL << 2)
+
+/* `adc fft` lists this many peaks unless told otherwise, and ADC_FFT_MAX_PEAKS at most. */
+#define ADC_FFT_PEAKS       (8U)
+#define ADC_FFT_MAX_PEAKS   (16U)
+
+#if (ADC_CAPTURE_SAMPLES != ADC_DSP_FFT_SIZE)
+#error "`adc fft capture` transforms a whole capture: ADC_CAPTURE_SAMPLES must be ADC_DSP_FFT_SIZE"
+#endif
+
+/* Magnitudes per `adc fft spectrum` record: 12 header bytes and 496 more fit one binary protocol response. */
+#define ADC_FFT_DUMP_BINS   (248U)
+#define ADC_FFT_DUMP_HEADER (12U)
+#define ADC_FFT_DUMP_FORMAT (1U)
+
+/* -- Function Declarations -- */
+
+/* `adc [stats [reset]]`: acquisition counters and the latest block, or running per-channel statistics.
+ * `adc oversample [reset | <channel> <ratio>]`: oversampling ratios, latest results and their cost.
+ * `adc fft <channel|capture> [peaks] | fft spectrum <offset>`: the strongest bins of one channel, live or from the
+ * last triggered capture, or the spectrum in binary. */
+static CLI_STATUS adc_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+/* Written by DMA2, so it must stay out of CCM RAM. [half][scan][channel], the order the DMA writes in. */
+static uint16_t Adc_Dma[2][ADC_BLOCK_SCANS][ADC_CHANNELS];
+
+/* Per pool block, under a critical section: the readers holding it, whether it carries a published block (not
+ * while the ADC task refills it) and whether any reader took it. */
+static AdcBlock Pool[ADC_POOL_BLOCKS];
+static uint8_t  Holders[ADC_POOL_BLOCKS];
+static uint8_t  Published[ADC_POOL_BLOCKS];
+static uint8_t  Taken[ADC_POOL_BLOCKS];
+
+/* Open readers by slot, under a critical section. Each slot's semaphore is given on every publish. */
+static AdcReader        *Readers[ADC_READERS];
+static SemaphoreHandle_t Reader_Wake[ADC_READERS];
+
+static volatile uint32_t Period_Us = ADC_SAMPLE_PERIOD_US;
+
+/* irqs, lost and dma_errors are written by the DMA interrupt, the rest by the ADC task; the task's own lost and
+ * blocks counts change inside a critical section, so neither side loses the other's update. */
+static AdcStats Stats;
+
+/* Sequence numbers count on from Stats.blocks + Stats.lost; a stats reset moves what they had counted in here. */
+static uint32_t Sequence_Base;
+
+/* Updated by the ADC task from every published block. A reset is left for the task to carry out, so
+ * acquisition never stops for it and a block is never half merged. */
+static AdcChannelStats   Channel_Stats[ADC_CHANNELS];
+static TickType_t        Channel_Stats_Since;
+static volatile uint8_t  Channel_Stats_Reset = 1;
+
+/* Filter chain state per channel; the DC blocker runs on the AC inputs only. */
+typedef struct
+{
+    AdcDcBlock dc;
+    AdcCic     cic;
+    AdcFir     fir;
+    AdcOversampler oversampler;
+    uint8_t    ac_coupled;
+}AdcChannelDsp;
+
+static AdcChannelDsp Dsp[ADC_CHANNELS] = { { .ac_coupled = 1 }, { .ac_coupled = 1 }, { .ac_coupled = 0 } };
+static int16_t       Dsp_Scratch[ADC_BLOCK_SCANS];
+
+/* Ratios as set from the CLI, log4; the ADC task picks a change up at its next block, like a statistics reset. */
+static volatile uint8_t  Oversample_Shift[ADC_CHANNELS];
+static volatile uint8_t  Oversample_Reset;
+static AdcOversampleStats Oversample_Stats[ADC_CHANNELS] = { { .ratio = 1 }, { .ratio = 1 }, { .ratio = 1 } };
+
+/* The last `adc fft`, kept for `adc fft spectrum`. Under Fft_Lock: commands run on more than one CLI worker. */
+static SemaphoreHandle_t Fft_Lock;
+static uint16_t Fft_Samples[ADC_DSP_FFT_SIZE];
+static uint32_t Fft_Data[ADC_DSP_FFT_SIZE];
+static uint16_t Fft_Magnitudes[ADC_DSP_FFT_BINS];
+static uint8_t  Fft_Channel;
+static uint32_t Fft_Period_Us;          /* 0 until the first transform */
+
+static const uint32_t Channels[ADC_CHANNELS] = { LL_ADC_CHANNEL_0, LL_ADC_CHANNEL_1, LL_ADC_CHANNEL_2 };
+static const uint32_t Ranks[ADC_CHANNELS] = { LL_ADC_REG_RANK_1, LL_ADC_REG_RANK_2, LL_ADC_REG_RANK_3 };
+
+static const char *const Adc_Views[] = { "stats", "oversample", "fft" };
+static const char *const Adc_Keywords[] = { "reset", "spectrum", "capture" };
+
+static const CliArgSpec Adc_Args[] =
+{
+    { "view", CLI_ARG_ENUM, .optional = 1, .choices = Adc_Views, .choice_count = CLI_ARG_COUNT(Adc_Views) },
+    { "channel", CLI_ARG_INT, .optional = 1, .min = 0, .max = ADC_CHANNELS - 1, .choices = Adc_Keywords,
+      .choice_count = CLI_ARG_COUNT(Adc_Keywords) },
+    /* Oversampling ratio, FFT peaks or spectrum offset, checked against the view. */
+    { "n", CLI_ARG_INT, .optional = 1, .min = 0, .max = ADC_DSP_FFT_BINS - 1 },
+};
+
+CLI_COMMAND_ARGS("adc", adc_command, ALL, "ADC counters, latest block, channel statistics, oversampling and FFT", Adc_Args);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Start Acquisition -- */
+/* Restarts TIM3, ADC1 and the DMA from the first half. ADC task only. */
+static inline void adc_start(void)
+{
+    LL_TIM_DisableCounter(TIM3);
+    LL_ADC_REG_StopConversionExtTrig(ADC1);
+    LL_ADC_Disable(ADC1);
+
+    LL_DMA_DisableStream(DMA2, ADC_DMA_STREAM);
+    while (LL_DMA_IsEnabledStream(DMA2, ADC_DMA_STREAM))
+        ;
+    LL_DMA_ClearFlag_HT4(DMA2);
+    LL_DMA_ClearFlag_TC4(DMA2);
+    LL_DMA_ClearFlag_TE4(DMA2);
+    LL_DMA_SetDataLength(DMA2, ADC_DMA_STREAM, ADC_DMA_ITEMS);
+
+    /* The filters start over with the samples. */
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        adc_dsp_dc_block_init(&Dsp[ch].dc);
+        adc_dsp_cic_init(&Dsp[ch].cic);
+        adc_dsp_fir_init(&Dsp[ch].fir, ADC_DSP_LOWPASS);
+        adc_dsp_oversample_init(&Dsp[ch].oversampler, Dsp[ch].oversampler.shift);
+    }
+
+    LL_DMA_EnableStream(DMA2, ADC_DMA_STREAM);
+
+    LL_ADC_ClearFlag_OVR(ADC1);
+    LL_ADC_Enable(ADC1);
+    LL_ADC_REG_StartConversionExtTrig(ADC1, LL_ADC_REG_TRIG_EXT_RISING);
+
+    /* 1 MHz count; the update event loads the new prescaler. */
+    LL_TIM_SetPrescaler(TIM3, ADC_TIMER_CLOCK_HZ / 1000000U - 1U);
+    LL_TIM_SetAutoReload(TIM3, Period_Us - 1U);
+    LL_TIM_GenerateEvent_UPDATE(TIM3);
+    LL_TIM_EnableCounter(TIM3);
+}
+
+/* -- Oversample Block -- */
+/* Picks up ratio changes and counter resets from the CLI, then sums each oversampled channel. */
+static inline void adc_oversample(AdcBlock *block)
+{
+    const uint8_t reset = Oversample_Reset;
+
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        AdcOversampler *const os = &Dsp[ch].oversampler;
+        AdcOversampleStats *const stats = &Oversample_Stats[ch];
+        const uint32_t shift = Oversample_Shift[ch];
+        const uint8_t changed = (shift != os->shift);
+
+        if (changed || reset)
+        {
+            taskENTER_CRITICAL();
+            *stats = (AdcOversampleStats) { .ratio = 1UL << (2U * shift), .latest = changed ? 0 : stats->latest };
+            taskEXIT_CRITICAL();
+        }
+        if (changed)
+        {
+            adc_dsp_oversample_init(os, shift);
+        }
+
+        block->oversampled_count[ch] = 0;
+        if (shift == 0)
+        {
+            continue;
+        }
+
+        const uint32_t start = DWT->CYCCNT;
+        const size_t results = adc_dsp_oversample(os, block->samples[ch], block->oversampled[ch], ADC_BLOCK_SCANS);
+        const uint32_t cycles = DWT->CYCCNT - start;
+
+        block->oversampled_count[ch] = (uint8_t) results;
+        stats->cycles += cycles;
+        stats->results += results;
+        if (results != 0)
+        {
+            stats->latest = block->oversampled[ch][results - 1];
+        }
+    }
+
+    if (reset)
+    {
+        Oversample_Reset = 0;
+    }
+}
+
+/* -- Claim Block -- */
+/* A pool block no reader holds: one never published if there is one, else the oldest published, counted as
+ * dropped when no reader took it. NULL, and the half lost, when readers hold every block. */
+static inline AdcBlock *adc_claim_block(void)
+{
+    int32_t claimed = -1;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < ADC_POOL_BLOCKS; ++i)
+    {
+        if (Holders[i] != 0)
+        {
+            continue;
+        }
+        if (!Published[i])
+        {
+            claimed = (int32_t) i;
+            break;
+        }
+        if (claimed < 0 || (int32_t) (Pool[i].sequence - Pool[claimed].sequence) < 0)
+        {
+            claimed = (int32_t) i;
+        }
+    }
+
+    if (claimed < 0)
+    {
+        Stats.lost++;
+    }
+    else
+    {
+        Stats.dropped += (Published[claimed] && !Taken[claimed]);
+        Published[claimed] = 0;
+        Taken[claimed] = 0;
+    }
+    taskEXIT_CRITICAL();
+
+    return (claimed < 0) ? NULL : &Pool[claimed];
+}
 
-typedef uint16_t Adc_Raw_t;
+/* -- Publish Block -- */
+/* The only copy a sample sees on its way to readers. */
+static inline void adc_publish(const uint16_t (*scans)[ADC_CHANNELS])
+{
+    const uint32_t start = DWT->CYCCNT;
+    AdcBlock *const block = adc_claim_block();
+    uint8_t wake = 0;
+
+    if (block == NULL)
+    {
+        return;
+    }
 
-extern ADC_HandleTypeDef hadc1;
-extern volatile xQueueHandle Adc_to_cdc_queue;
-extern xTaskHandle Adc_Task_Handle;
+    for (uint32_t scan = 0; scan < ADC_BLOCK_SCANS; ++scan)
+    {
+        for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+        {
+            block->samples[ch][scan] = scans[scan][ch];
+        }
+    }
 
-uint16_t latest_conv_val = 0;
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        AdcChannelDsp *const dsp = &Dsp[ch];
 
+        adc_dsp_to_q15(block->samples[ch], Dsp_Scratch, ADC_BLOCK_SCANS);
+        if (dsp->ac_coupled)
+        {
+            adc_dsp_dc_block(&dsp->dc, Dsp_Scratch, Dsp_Scratch, ADC_BLOCK_SCANS);
+        }
+        const size_t decimated = adc_dsp_cic(&dsp->cic, Dsp_Scratch, Dsp_Scratch, ADC_BLOCK_SCANS);
+        adc_dsp_fir(&dsp->fir, Dsp_Scratch, block->filtered[ch], decimated);
+    }
+
+    adc_oversample(block);
+
+    if (Channel_Stats_Reset)
+    {
+        taskENTER_CRITICAL();
+        for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+        {
+            adc_stats_reset(&Channel_Stats[ch]);
+        }
+        Channel_Stats_Since = xTaskGetTickCount();
+        Channel_Stats_Reset = 0;
+        taskEXIT_CRITICAL();
+    }
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        adc_stats_update(&Channel_Stats[ch], block->samples[ch], ADC_BLOCK_SCANS);
+    }
+
+    taskENTER_CRITICAL();
+    block->sequence = Sequence_Base + Stats.blocks + Stats.lost;
+    taskEXIT_CRITICAL();
+    block->period_us = Period_Us;
+    adc_capture_block(block);
+
+    taskENTER_CRITICAL();
+    Published[block - Pool] = 1;
+    Stats.blocks++;
+    for (uint32_t slot = 0; slot < ADC_READERS; ++slot)
+    {
+        wake |= (uint8_t) ((Readers[slot] != NULL) << slot);
+    }
+    taskEXIT_CRITICAL();
+
+    for (uint32_t slot = 0; slot < ADC_READERS; ++slot)
+    {
+        if (wake & (1U << slot))
+        {
+            xSemaphoreGive(Reader_Wake[slot]);
+        }
+    }
+
+    const uint32_t cycles = DWT->CYCCNT - start;
+    Stats.task_cycles += cycles;
+    if (cycles > Stats.task_cycles_max)
+    {
+        Stats.task_cycles_max = cycles;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                ADC Functions                               */
+/* -------------------------------------------------------------------------- */
+
+/* -- ADC Init -- */
+/* Configures the hardware, stopped, and creates the block pool and the locks. Call before vTaskStartScheduler(). */
+void adc_init(void)
+{
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_GPIOA);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM3);
+    LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_ADC1);
+
+    LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_0, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_1, LL_GPIO_MODE_ANALOG);
+    LL_GPIO_SetPinMode(GPIOA, LL_GPIO_PIN_2, LL_GPIO_MODE_ANALOG);
+
+    /* PCLK2 (72 MHz) / 2: 36 MHz, the ADC's maximum at 3 V. */
+    LL_ADC_SetCommonClock(__LL_ADC_COMMON_INSTANCE(ADC1), LL_ADC_CLOCK_SYNC_PCLK_DIV2);
+    LL_ADC_SetResolution(ADC1, LL_ADC_RESOLUTION_12B);
+    LL_ADC_SetDataAlignment(ADC1, LL_ADC_DATA_ALIGN_RIGHT);
+    LL_ADC_SetSequencersScanMode(ADC1, LL_ADC_SEQ_SCAN_ENABLE);
+    LL_ADC_REG_SetTriggerSource(ADC1, LL_ADC_REG_TRIG_EXT_TIM3_TRGO);
+    LL_ADC_REG_SetSequencerLength(ADC1, LL_ADC_REG_SEQ_SCAN_ENABLE_3RANKS);
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        LL_ADC_REG_SetSequencerRanks(ADC1, Ranks[ch], Channels[ch]);
+        LL_ADC_SetChannelSamplingTime(ADC1, Channels[ch], LL_ADC_SAMPLINGTIME_84CYCLES);
+    }
+    LL_ADC_REG_SetDMATransfer(ADC1, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+    LL_ADC_EnableIT_OVR(ADC1);
+
+    LL_TIM_SetTriggerOutput(TIM3, LL_TIM_TRGO_UPDATE);
+
+    LL_DMA_DisableStream(DMA2, ADC_DMA_STREAM);
+    while (LL_DMA_IsEnabledStream(DMA2, ADC_DMA_STREAM))
+        ;
+    LL_DMA_SetChannelSelection(DMA2, ADC_DMA_STREAM, LL_DMA_CHANNEL_0);
+    LL_DMA_ConfigTransfer(DMA2, ADC_DMA_STREAM,
+                          LL_DMA_DIRECTION_PERIPH_TO_MEMORY |
+                          LL_DMA_MODE_CIRCULAR |
+                          LL_DMA_PERIPH_NOINCREMENT |
+                          LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_HALFWORD |
+                          LL_DMA_MDATAALIGN_HALFWORD |
+                          LL_DMA_PRIORITY_HIGH);
+    LL_DMA_DisableFifoMode(DMA2, ADC_DMA_STREAM);
+    LL_DMA_SetPeriphAddress(DMA2, ADC_DMA_STREAM, LL_ADC_DMA_GetRegAddr(ADC1, LL_ADC_DMA_REG_REGULAR_DATA));
+    LL_DMA_SetMemoryAddress(DMA2, ADC_DMA_STREAM, (uintptr_t) Adc_Dma);
+    LL_DMA_EnableIT_HT(DMA2, ADC_DMA_STREAM);
+    LL_DMA_EnableIT_TC(DMA2, ADC_DMA_STREAM);
+    LL_DMA_EnableIT_TE(DMA2, ADC_DMA_STREAM);
+
+    /* Below configMAX_SYSCALL_INTERRUPT_PRIORITY, like the UART interrupts. */
+    NVIC_SetPriority(DMA2_Stream4_IRQn, 6);
+    NVIC_EnableIRQ(DMA2_Stream4_IRQn);
+    NVIC_SetPriority(ADC_IRQn, 6);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    for (uint32_t slot = 0; slot < ADC_READERS; ++slot)
+    {
+        Reader_Wake[slot] = xSemaphoreCreateBinary();
+        assert_param(Reader_Wake[slot] != NULL);
+    }
+
+    Fft_Lock = xSemaphoreCreateMutex();
+    assert_param(Fft_Lock != NULL);
+
+    adc_capture_init();
+}
+
+/* -- ADC Task -- */
 void adc_task(void*)
 {
-    uint32_t Notify;
-    size_t index = 0;
+    uint32_t expected = 0;      /* Half the DMA finishes next */
+
+    adc_start();
+
+    while (1)
+    {
+        uint32_t pending;
+
+        xTaskNotifyWait(0, UINT32_MAX, &pending, portMAX_DELAY);
+
+        if (pending & ADC_NOTIFY_RESTART)
+        {
+            /* Halves still pending belong to the old period. */
+            adc_start();
+            expected = 0;
+            continue;
+        }
+
+        const uint32_t halves = pending & ADC_NOTIFY_HALVES;
+
+        if (halves == ADC_NOTIFY_HALVES)
+        {
+            /* Both finished since the last pass: the DMA is already overwriting the older one. */
+            taskENTER_CRITICAL();
+            Stats.lost++;
+            taskEXIT_CRITICAL();
+            expected ^= 1U;
+        }
+        else if (halves != 0 && !(halves & ADC_NOTIFY_HALF(expected)))
+        {
+            /* Back in step after a loss the interrupt counted. */
+            expected ^= 1U;
+        }
+
+        if (halves != 0)
+        {
+            adc_publish(Adc_Dma[expected]);
+            expected ^= 1U;
+        }
+    }
+}
+
+/* -- Open Reader -- */
+uint8_t adc_reader_open(AdcReader *reader)
+{
+    uint8_t opened = 0;
+
+    taskENTER_CRITICAL();
+    for (uint32_t slot = 0; slot < ADC_READERS && !opened; ++slot)
+    {
+        if (Readers[slot] == NULL)
+        {
+            Readers[slot] = reader;
+            reader->slot = (uint8_t) slot;
+            reader->next = Sequence_Base + Stats.blocks + Stats.lost;
+            opened = 1;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (opened)
+    {
+        /* A wake-up left over from the slot's last reader. */
+        xSemaphoreTake(Reader_Wake[reader->slot], 0);
+    }
+    return opened;
+}
+
+/* -- Close Reader -- */
+void adc_reader_close(AdcReader *reader)
+{
+    taskENTER_CRITICAL();
+    Readers[reader->slot] = NULL;
+    taskEXIT_CRITICAL();
+}
+
+/* -- Take Block -- */
+/* Looks again after every publish until a block at or past the reader's cursor is there. */
+const AdcBlock *adc_block_take(AdcReader *reader, TickType_t wait)
+{
+    const TickType_t start = xTaskGetTickCount();
+
+    while (1)
+    {
+        int32_t found = -1;
+
+        taskENTER_CRITICAL();
+        for (uint32_t i = 0; i < ADC_POOL_BLOCKS; ++i)
+        {
+            if (Published[i] && (int32_t) (Pool[i].sequence - reader->next) >= 0
+                && (found < 0 || (int32_t) (Pool[i].sequence - Pool[found].sequence) < 0))
+            {
+                found = (int32_t) i;
+            }
+        }
+        if (found >= 0)
+        {
+            Holders[found]++;
+            Taken[found] = 1;
+            reader->next = Pool[found].sequence + 1U;
+        }
+        taskEXIT_CRITICAL();
+
+        if (found >= 0)
+        {
+            return &Pool[found];
+        }
+
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= wait || xSemaphoreTake(Reader_Wake[reader->slot], wait - elapsed) != pdPASS)
+        {
+            return NULL;
+        }
+    }
+}
+
+/* -- Release Block -- */
+void adc_block_release(const AdcBlock *block)
+{
+    taskENTER_CRITICAL();
+    Holders[block - Pool]--;
+    taskEXIT_CRITICAL();
+}
+
+void adc_set_period_us(uint32_t period_us)
+{
+    Period_Us = (period_us < ADC_MIN_PERIOD_US) ? ADC_MIN_PERIOD_US : period_us;
+    xTaskNotify(Adc_Task_Handle, ADC_NOTIFY_RESTART, eSetBits);
+}
+
+uint32_t adc_get_period_us(void)
+{
+    return Period_Us;
+}
+
+void adc_get_stats(AdcStats *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = Stats;
+    taskEXIT_CRITICAL();
+}
+
+void adc_reset_stats(void)
+{
+    taskENTER_CRITICAL();
+    Sequence_Base += Stats.blocks + Stats.lost;
+    Stats = (AdcStats) { 0 };
+    taskEXIT_CRITICAL();
+}
+
+void adc_get_channel_stats(AdcChannelStats stats[ADC_CHANNELS], TickType_t *since)
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, Channel_Stats, sizeof(Channel_Stats));
+    *since = Channel_Stats_Since;
+    taskEXIT_CRITICAL();
+}
+
+void adc_reset_channel_stats(void)
+{
+    Channel_Stats_Reset = 1;
+}
+
+/* -- Set Oversampling -- */
+uint8_t adc_set_oversampling(uint32_t channel, uint32_t ratio)
+{
+    for (uint32_t shift = 0; shift <= ADC_DSP_OVERSAMPLE_MAX_SHIFT; ++shift)
+    {
+        if (channel < ADC_CHANNELS && ratio == (1UL << (2U * shift)))
+        {
+            Oversample_Shift[channel] = (uint8_t) shift;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void adc_get_oversampling(AdcOversampleStats stats[ADC_CHANNELS])
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, Oversample_Stats, sizeof(Oversample_Stats));
+    taskEXIT_CRITICAL();
+}
+
+void adc_reset_oversampling_stats(void)
+{
+    Oversample_Reset = 1;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              ADC IRQ Handlers                              */
+/* -------------------------------------------------------------------------- */
+
+/* -- DMA2 Stream4 IRQ -- */
+/* A half whose bit is still set when it completes again was refilled before the task read it. */
+void DMA2_Stream4_IRQHandler(void)
+{
+    IRQ_STATS_ENTER(IRQ_STAT_ADC_DMA);
+
+    BaseType_t woken = pdFALSE;
+    uint32_t done = 0;
+    uint32_t previous;
+
+    if (LL_DMA_IsActiveFlag_HT4(DMA2))
+    {
+        LL_DMA_ClearFlag_HT4(DMA2);
+        done |= ADC_NOTIFY_HALF(0);
+    }
+    if (LL_DMA_IsActiveFlag_TC4(DMA2))
+    {
+        LL_DMA_ClearFlag_TC4(DMA2);
+        done |= ADC_NOTIFY_HALF(1);
+    }
+    if (LL_DMA_IsActiveFlag_TE4(DMA2))
+    {
+        LL_DMA_ClearFlag_TE4(DMA2);
+        Stats.dma_errors++;
+        done |= ADC_NOTIFY_RESTART;
+    }
+
+    Stats.irqs++;
+    xTaskNotifyAndQueryFromISR(Adc_Task_Handle, done, eSetBits, &previous, &woken);
+    if (previous & done & ADC_NOTIFY_HALVES)
+    {
+        Stats.lost++;
+    }
+
+    IRQ_STATS_EXIT(IRQ_STAT_ADC_DMA);
+    portYIELD_FROM_ISR(woken);
+}
+
+/* -- ADC IRQ -- */
+/* Overrun: the DMA missed a conversion and ADC1 has stopped requesting; the task restarts it. */
+void ADC_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (LL_ADC_IsActiveFlag_OVR(ADC1))
+    {
+        LL_ADC_ClearFlag_OVR(ADC1);
+        Stats.overruns++;
+        xTaskNotifyFromISR(Adc_Task_Handle, ADC_NOTIFY_RESTART, eSetBits, &woken);
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 ADC Command                                */
+/* -------------------------------------------------------------------------- */
+
+/* -- LSB to mV -- */
+/* A Q`shift` LSB figure in tenths of a millivolt, for %.1q. */
+static inline uint32_t lsb_to_tenth_mv(const uint64_t lsb, const uint32_t shift)
+{
+    return (uint32_t) ((lsb * ADC_VREF_MV * 10U / 4095U) >> shift);
+}
+
+static inline void put_le16(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t) value;
+    out[1] = (uint8_t) (value >> 8);
+}
+
+static inline void put_le32(uint8_t *out, uint32_t value)
+{
+    put_le16(out, value);
+    put_le16(out + 2, value >> 16);
+}
+
+/* -- Channel Statistics -- */
+static CLI_STATUS adc_channel_stats(void)
+{
+    AdcChannelStats stats[ADC_CHANNELS];
+    TickType_t since;
+
+    adc_get_channel_stats(stats, &since);
+
+    uart_tx_lock();
+    cli_printf("Since reset: %.1q s\r\n", (int) ((xTaskGetTickCount() - since) * portTICK_PERIOD_MS / 100U));
+    cli_printf("%-3s | %10s | %4s | %4s | %8s | %8s | %9s\r\n", "Ch", "samples", "min", "max", "mean mV", "rms mV",
+               "ac rms mV");
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        if (stats[ch].count == 0)
+        {
+            cli_printf("IN%lu | %10u | %4s | %4s | %8s | %8s | %9s\r\n", (unsigned long) ch, 0U, "-", "-", "-", "-", "-");
+            continue;
+        }
+        cli_printf("IN%lu | %10llu | %4u | %4u | %8.1q | %8.1q | %9.1q\r\n", (unsigned long) ch,
+                   (unsigned long long) stats[ch].count, stats[ch].min, stats[ch].max,
+                   (int) lsb_to_tenth_mv(adc_stats_mean_q16(&stats[ch]), 16),
+                   (int) lsb_to_tenth_mv(adc_stats_rms_q8(&stats[ch]), 8),
+                   (int) lsb_to_tenth_mv(adc_stats_ac_rms_q8(&stats[ch]), 8));
+    }
+    uart_tx_unlock();
+
+    return CLI_OK;
+}
 
-    Adc_Raw_t raw_values[RING_BUFFER_SIZE][BUFFER_SIZE] = {0};
-    uint8_t CurrentBuffer = 0;
+/* -- Oversampling -- */
+/* Results are left-aligned to 16 bits whatever the ratio, so one scale turns them into millivolts. */
+static CLI_STATUS adc_oversampling(void)
+{
+    const uint32_t period_us = adc_get_period_us();
+    AdcOversampleStats stats[ADC_CHANNELS];
 
-    HAL_ADC_Start_IT(&hadc1);
+    adc_get_oversampling(stats);
 
-    while(1)
+    uart_tx_lock();
+    cli_printf("%-3s | %5s | %4s | %9s | %10s | %10s | %10s\r\n", "Ch", "ratio", "bits", "results/s", "results",
+               "cyc/result", "latest mV");
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
     {
-        if( xTaskNotifyWait(0, 0xFFFFFFFF, &Notify, portMAX_DELAY) != pdPASS || Notify != DEF_NOTIFICATION_VAL)
+        uint32_t bits = 12;
+
+        for (uint32_t ratio = stats[ch].ratio; ratio > 1; ratio >>= 2)
+        {
+            bits++;
+        }
+
+        if (stats[ch].ratio == 1)
         {
+            cli_printf("IN%lu | %5s | %4lu | %9s | %10s | %10s | %10s\r\n", (unsigned long) ch, "off",
+                       (unsigned long) bits, "-", "-", "-", "-");
             continue;
         }
+        cli_printf("IN%lu | %5lu | %4lu | %9.1q | %10lu | %10lu | %10.3q\r\n", (unsigned long) ch,
+                   (unsigned long) stats[ch].ratio, (unsigned long) bits,
+                   (int) (10000000U / (period_us * stats[ch].ratio)), (unsigned long) stats[ch].results,
+                   (unsigned long) ((stats[ch].results != 0) ? stats[ch].cycles / stats[ch].results : 0),
+                   (int) ((uint64_t) stats[ch].latest * ADC_VREF_MV * 1000U / 0xFFF0U));
+    }
+    uart_tx_unlock();
 
-        SEGGER_SYSVIEW_Print("Conversion Complete\r\n");
+    return CLI_OK;
+}
 
-        raw_values[CurrentBuffer][index] = latest_conv_val;
+/* -- FFT Gather -- */
+/* ADC_DSP_FFT_SIZE samples of one channel from consecutive blocks into Fft_Samples, starting over after a gap. */
+static CLI_STATUS fft_gather(uint32_t channel, uint32_t *period_us)
+{
+    const TickType_t block_ticks = pdMS_TO_TICKS(adc_get_period_us() * ADC_BLOCK_SCANS / 1000U);
+    const uint32_t max_blocks = 4U * (ADC_DSP_FFT_SIZE / ADC_BLOCK_SCANS + 1U);
+    uint32_t collected = 0, blocks = 0, sequence = 0;
+    AdcReader reader;
 
-        xQueueSend(Adc_to_cdc_queue, raw_values[CurrentBuffer]+index, 0);
+    /* Only samples from now on. */
+    if (!adc_reader_open(&reader))
+    {
+        cli_print("All ADC readers busy\r\n");
+        return CLI_FAILED;
+    }
 
-        index++;
+    while (collected < ADC_DSP_FFT_SIZE)
+    {
+        const AdcBlock *const block = adc_block_take(&reader, 2U * block_ticks + 1U);
+        if (block == NULL || ++blocks > max_blocks)
+        {
+            if (block != NULL)
+            {
+                adc_block_release(block);
+            }
+            adc_reader_close(&reader);
+            cli_print((block == NULL) ? "No block in the last two block periods\r\n" : "Too many blocks lost\r\n");
+            return CLI_FAILED;
+        }
 
-        if(index == BUFFER_SIZE)
+        if (collected != 0 && (block->sequence != sequence + 1U || block->period_us != *period_us))
         {
-            CurrentBuffer = CurrentBuffer == 0;
+            collected = 0;
         }
+        const uint32_t take = (ADC_DSP_FFT_SIZE - collected < ADC_BLOCK_SCANS) ? ADC_DSP_FFT_SIZE - collected
+                                                                                : ADC_BLOCK_SCANS;
+        memcpy(&Fft_Samples[collected], block->samples[channel], take * sizeof(uint16_t));
+        collected += take;
+        sequence = block->sequence;
+        *period_us = block->period_us;
+        adc_block_release(block);
     }
+    adc_reader_close(&reader);
+
+    return CLI_OK;
 }
 
-void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+/* -- FFT From Capture -- */
+/* The whole of the last triggered capture into Fft_Samples: it is exactly one transform long. */
+static CLI_STATUS fft_from_capture(uint32_t *channel, uint32_t *period_us)
 {
-    latest_conv_val = HAL_ADC_GetValue(hadc);
-    xTaskNotify(Adc_Task_Handle, DEF_NOTIFICATION_VAL, eNoAction);
+    AdcCaptureInfo info;
+
+    if (adc_capture_read(&info, Fft_Samples, 0, ADC_DSP_FFT_SIZE) != ADC_DSP_FFT_SIZE)
+    {
+        cli_print("No capture to transform, see \"capture\"\r\n");
+        return CLI_FAILED;
+    }
+    if (info.gaps != 0)
+    {
+        cli_printf("The capture spans %lu lost blocks\r\n", (unsigned long) info.gaps);
+        return CLI_FAILED;
+    }
+
+    *channel = info.channel;
+    *period_us = info.period_us;
+    return CLI_OK;
 }
 
+/* -- FFT Run -- */
+/* Transforms ADC_DSP_FFT_SIZE samples of one channel, live or from the capture, and lists the strongest local
+ * maxima. The Hann window halves a tone, so a bin's magnitude times 4 is the tone's Q15 amplitude, and bin 0
+ * times 2 is the mean. Fft_Lock held. */
+static CLI_STATUS adc_fft_run(uint32_t channel, uint32_t peaks, uint8_t from_capture)
+{
+    uint32_t period_us = 0;
+    uint32_t found[ADC_FFT_MAX_PEAKS];
+    uint32_t found_count = 0;
 
-#endif
+    Fft_Period_Us = 0;
+    if ((from_capture ? fft_from_capture(&channel, &period_us) : fft_gather(channel, &period_us)) != CLI_OK)
+    {
+        return CLI_FAILED;
+    }
+
+    const uint32_t start = DWT->CYCCNT;
+    adc_dsp_fft_window(Fft_Samples, Fft_Data);
+    const uint32_t windowed = DWT->CYCCNT;
+    adc_dsp_fft(Fft_Data);
+    const uint32_t transformed = DWT->CYCCNT;
+    adc_dsp_fft_magnitudes(Fft_Data, Fft_Magnitudes);
+    const uint32_t end = DWT->CYCCNT;
+
+    Fft_Channel = (uint8_t) channel;
+    Fft_Period_Us = period_us;
+
+    /* Largest local maxima first; DC and Nyquist are left out. */
+    while (found_count < peaks)
+    {
+        uint32_t best = 0;
+
+        for (uint32_t k = 1; k < ADC_DSP_FFT_BINS - 1U; ++k)
+        {
+            uint32_t i = 0;
+
+            if (Fft_Magnitudes[k] <= Fft_Magnitudes[k - 1] || Fft_Magnitudes[k] < Fft_Magnitudes[k + 1]
+                || (best != 0 && Fft_Magnitudes[k] <= Fft_Magnitudes[best]))
+            {
+                continue;
+            }
+            while (i < found_count && found[i] != k)
+            {
+                i++;
+            }
+            best = (i == found_count) ? k : best;
+        }
+        if (best == 0)
+        {
+            break;
+        }
+        found[found_count++] = best;
+    }
+
+    /* Bin k sits at k cycles per window. */
+    const uint64_t window_us = (uint64_t) ADC_DSP_FFT_SIZE * period_us;
+    const int32_t mean = (int16_t) Fft_Data[adc_dsp_fft_bin(0)];
+
+    uart_tx_lock();
+    cli_printf("FFT     : IN%lu, %u samples at %lu us%s, %.2q Hz per bin, Hann window\r\n", (unsigned long) channel,
+               ADC_DSP_FFT_SIZE, (unsigned long) period_us, from_capture ? " from the capture" : "",
+               (int) (100000000ULL / window_us));
+    cli_printf("Cycles  : %lu window, %lu FFT (%lu us), %lu magnitudes\r\n", (unsigned long) (windowed - start),
+               (unsigned long) (transformed - windowed),
+               (unsigned long) ((transformed - windowed) / (SystemCoreClock / 1000000U)), (unsigned long) (end - transformed));
+    /* mean LSB = 2048 + 2 * bin 0 / 16, in Q3. */
+    cli_printf("DC      : %.1q mV\r\n", (int) lsb_to_tenth_mv((uint64_t) (2048 * 8 + mean), 3));
+    cli_printf("%4s | %4s | %9s | %12s\r\n", "Peak", "bin", "Hz", "amplitude mV");
+    for (uint32_t i = 0; i < found_count; ++i)
+    {
+        /* amplitude LSB = 4 * magnitude / 16, in Q2. */
+        cli_printf("%4lu | %4lu | %9.1q | %12.1q\r\n", (unsigned long) (i + 1U), (unsigned long) found[i],
+                   (int) (found[i] * 10000000ULL / window_us),
+                   (int) lsb_to_tenth_mv(Fft_Magnitudes[found[i]], 2));
+    }
+    uart_tx_unlock();
+
+    return CLI_OK;
+}
+
+/* -- FFT -- */
+/* One transform at a time: a second `adc fft` waits for the first, so the spectrum kept is always a whole one. */
+static CLI_STATUS adc_fft(uint32_t channel, uint32_t peaks, uint8_t from_capture)
+{
+    xSemaphoreTake(Fft_Lock, portMAX_DELAY);
+    const CLI_STATUS status = adc_fft_run(channel, peaks, from_capture);
+    xSemaphoreGive(Fft_Lock);
+
+    return status;
+}
+
+/* -- FFT Spectrum Record -- */
+/* Magnitudes of the last `adc fft` from bin `offset` on, ADC_FFT_DUMP_BINS at most per response, little endian:
+ *
+ *      0   u8   format (ADC_FFT_DUMP_FORMAT)
+ *      1   u8   channel
+ *      2   u16  FFT size
+ *      4   u32  sample period, us
+ *      8   u16  first bin in this record
+ *      10  u16  bins in this record
+ *      12  ...  u16 magnitudes, Q15
+ *
+ * The record buffer is shared too, so Fft_Lock is held until it is sent.
+ */
+static CLI_STATUS adc_fft_spectrum(uint32_t offset)
+{
+    static uint8_t record[ADC_FFT_DUMP_HEADER + ADC_FFT_DUMP_BINS * 2U];
+
+    if (cli_proto_mode() != CLI_PROTO_BINARY)
+    {
+        cli_print("adc fft spectrum needs the binary protocol, see \"proto\"\r\n");
+        return CLI_FAILED;
+    }
+
+    xSemaphoreTake(Fft_Lock, portMAX_DELAY);
+    if (Fft_Period_Us == 0 || offset >= ADC_DSP_FFT_BINS)
+    {
+        cli_print((Fft_Period_Us == 0) ? "No spectrum, run \"adc fft\" first\r\n" : "Offset past the spectrum\r\n");
+        xSemaphoreGive(Fft_Lock);
+        return CLI_FAILED;
+    }
+
+    const uint32_t count = (ADC_DSP_FFT_BINS - offset < ADC_FFT_DUMP_BINS) ? ADC_DSP_FFT_BINS - offset
+                                                                             : ADC_FFT_DUMP_BINS;
+
+    record[0] = ADC_FFT_DUMP_FORMAT;
+    record[1] = Fft_Channel;
+    put_le16(&record[2], ADC_DSP_FFT_SIZE);
+    put_le32(&record[4], Fft_Period_Us);
+    put_le16(&record[8], offset);
+    put_le16(&record[10], count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        put_le16(&record[ADC_FFT_DUMP_HEADER + 2U * i], Fft_Magnitudes[offset + i]);
+    }
+
+    cli_printn((const char*) record, ADC_FFT_DUMP_HEADER + 2U * count);
+    xSemaphoreGive(Fft_Lock);
+
+    return CLI_OK;
+}
+
+/* -- ADC Status -- */
+static CLI_STATUS adc_status(void)
+{
+    const uint32_t period_us = adc_get_period_us();
+    const TickType_t block_ticks = pdMS_TO_TICKS(period_us * ADC_BLOCK_SCANS / 1000U);
+    AdcStats stats;
+    AdcReader reader;
+
+    /* Wait for a fresh block, so the figures below are current. */
+    if (!adc_reader_open(&reader))
+    {
+        cli_print("All ADC readers busy\r\n");
+        return CLI_FAILED;
+    }
+    const AdcBlock *const block = adc_block_take(&reader, 2U * block_ticks + 1U);
+    adc_reader_close(&reader);
+
+    adc_get_stats(&stats);
+
+    uart_tx_lock();
+    cli_printf("Period  : %lu us (%lu scans/s), %u channels, %u scans per block\r\n", (unsigned long) period_us,
+               (unsigned long) (1000000U / period_us), ADC_CHANNELS, ADC_BLOCK_SCANS);
+    cli_printf("Blocks  : %lu published, %lu lost, %lu unread, %lu overruns, %lu DMA errors\r\n",
+               (unsigned long) stats.blocks, (unsigned long) stats.lost, (unsigned long) stats.dropped,
+               (unsigned long) stats.overruns, (unsigned long) stats.dma_errors);
+    if (stats.blocks != 0)
+    {
+        cli_printf("Task    : %lu cycles per block on average, %lu at most; %lu DMA interrupts\r\n",
+                   (unsigned long) (stats.task_cycles / stats.blocks), (unsigned long) stats.task_cycles_max,
+                   (unsigned long) stats.irqs);
+    }
+
+    if (block == NULL)
+    {
+        cli_print("No block in the last two block periods\r\n");
+        uart_tx_unlock();
+        return CLI_FAILED;
+    }
+
+    for (uint32_t ch = 0; ch < ADC_CHANNELS; ++ch)
+    {
+        int32_t low = INT16_MAX, high = INT16_MIN;
+        uint32_t sum = 0, min = UINT16_MAX, max = 0;
+
+        for (uint32_t i = 0; i < ADC_FILTERED_SCANS; ++i)
+        {
+            low = (block->filtered[ch][i] < low) ? block->filtered[ch][i] : low;
+            high = (block->filtered[ch][i] > high) ? block->filtered[ch][i] : high;
+        }
+
+        for (uint32_t scan = 0; scan < ADC_BLOCK_SCANS; ++scan)
+        {
+            const uint32_t sample = block->samples[ch][scan];
+
+            sum += sample;
+            min = (sample < min) ? sample : min;
+            max = (sample > max) ? sample : max;
+        }
+        /* Q15 full scale is half of VREF either side of mid-scale. */
+        cli_printf("IN%lu     : mean %4lu, min %4lu, max %4lu (%lu mV); filtered %ld .. %ld mV\r\n", (unsigned long) ch,
+                   (unsigned long) (sum / ADC_BLOCK_SCANS), (unsigned long) min, (unsigned long) max,
+                   (unsigned long) (sum / ADC_BLOCK_SCANS * ADC_VREF_MV / 4095U),
+                   (long) (low * (int32_t) (ADC_VREF_MV / 2U) / 32768), (long) (high * (int32_t) (ADC_VREF_MV / 2U) / 32768));
+    }
+    uart_tx_unlock();
+
+    adc_block_release(block);
+    return CLI_OK;
+}
+
+/* -- ADC Command -- */
+static CLI_STATUS adc_command(const CliArgs *args)
+{
+    if (!args->arg[0].present)
+    {
+        return adc_status();
+    }
+
+    const uint8_t reset = args->arg[1].present && args->arg[1].keyword == 1;
+    const uint8_t spectrum = args->arg[1].present && args->arg[1].keyword == 2;
+    const uint8_t capture = args->arg[1].present && args->arg[1].keyword == 3;
+
+    if (args->arg[0].value == 2) // fft
+    {
+        if (spectrum)
+        {
+            return adc_fft_spectrum(args->arg[2].present ? (uint32_t) args->arg[2].value : 0U);
+        }
+        if (!args->arg[1].present || reset
+            || (args->arg[2].present && (args->arg[2].value < 1 || args->arg[2].value > (int32_t) ADC_FFT_MAX_PEAKS)))
+        {
+            cli_printf("Usage: adc fft <0..%u|capture> [1..%u] | adc fft spectrum <offset>\r\n", ADC_CHANNELS - 1U,
+                       ADC_FFT_MAX_PEAKS);
+            return CLI_FAILED;
+        }
+        return adc_fft((uint32_t) args->arg[1].value, args->arg[2].present ? (uint32_t) args->arg[2].value : ADC_FFT_PEAKS,
+                       capture);
+    }
+
+    if (args->arg[0].value == 0) // stats
+    {
+        if (args->arg[1].present && !reset)
+        {
+            cli_print("Usage: adc stats [reset]\r\n");
+            return CLI_FAILED;
+        }
+        if (reset)
+        {
+            adc_reset_channel_stats();
+            cli_print("Channel statistics cleared from the next block\r\n");
+            return CLI_OK;
+        }
+        return adc_channel_stats();
+    }
+
+    if (reset)
+    {
+        adc_reset_oversampling_stats();
+        cli_print("Oversampling counters cleared from the next block\r\n");
+        return CLI_OK;
+    }
+    if (!args->arg[1].present)
+    {
+        return adc_oversampling();
+    }
+    if (spectrum || capture || !args->arg[2].present || !adc_set_oversampling((uint32_t) args->arg[1].value, (uint32_t) args->arg[2].value))
+    {
+        cli_printf("Usage: adc oversample <0..%u> <1|4|16|64|%u>\r\n", ADC_CHANNELS - 1U, ADC_OVERSAMPLE_MAX_RATIO);
+        return CLI_FAILED;
+    }
+
+    if (args->arg[2].value == 1)
+    {
+        cli_printf("IN%ld oversampling off from the next block\r\n", (long) args->arg[1].value);
+    }
+    else
+    {
+        cli_printf("IN%ld oversampled %ld times from the next block\r\n", (long) args->arg[1].value,
+                   (long) args->arg[2].value);
+    }
+    return CLI_OK;
+}
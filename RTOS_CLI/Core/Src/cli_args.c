@@ -0,0 +1,190 @@
+/*
+ * cli_args.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Command line tokenizer and argument schemas. The line buffer is split once,
+ *  in place, into argv slices; each command's CliArgSpec table then converts
+ *  and range-checks those tokens before the handler is called, so handlers
+ *  only ever see validated numbers, enum indices and colour masks.
+ */
+
+/* -- Standard Library -- */
+#include <errno.h>
+#include <stdlib.h>
+#include <strings.h>
+
+/* -- User Library -- */
+#include "cli_args.h"
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+static inline uint8_t is_separator(const char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+/* -- Find Choice -- */
+/* Index of `token` in `choices` (case-insensitive), or -1. */
+static inline int find_choice(const CliArgSpec *spec, const char *token)
+{
+    for (uint8_t i = 0; i < spec->choice_count; ++i)
+    {
+        if (strcasecmp(token, spec->choices[i]) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/* -- Convert Integer -- */
+/* Whole-token decimal conversion; returns 0 on junk, overflow or a value outside the spec's range. */
+static inline uint8_t convert_int(const CliArgSpec *spec, const char *token, int32_t *value)
+{
+    char *end = NULL;
+
+    errno = 0;
+    const long number = strtol(token, &end, 10);
+
+    if (end == token || *end != '\0' || errno == ERANGE || number < spec->min || number > spec->max)
+    {
+        return 0;
+    }
+
+    *value = (int32_t) number;
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Argument Functions                            */
+/* -------------------------------------------------------------------------- */
+
+/* -- Tokenize Line -- */
+size_t cli_tokenize(char *line, CliArgs *args)
+{
+    args->argc = 0;
+
+    while (*line != '\0')
+    {
+        while (is_separator(*line))
+        {
+            *line++ = '\0';
+        }
+
+        if (*line == '\0')
+        {
+            break;
+        }
+
+        if (args->argc == CLI_MAX_ARGS)
+        {
+            /* argv[] keeps the first CLI_MAX_ARGS; argc says there were more, for the caller to refuse the line. */
+            args->argc = CLI_MAX_ARGS + 1U;
+            return args->argc;
+        }
+
+        args->argv[args->argc++] = line;
+
+        while (*line != '\0' && !is_separator(*line))
+        {
+            line++;
+        }
+    }
+
+    return args->argc;
+}
+
+/* -- Parse Arguments -- */
+/* Walks the schema once; argv[0] is the command word and is not part of it. */
+CLI_ARGS_STATUS cli_args_parse(const CliArgSpec *spec, size_t count, CliArgs *args, size_t *failed)
+{
+    size_t token = 1;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        CliArg *const arg = &args->arg[i];
+        *arg = (CliArg) { 0 };
+        *failed = i;
+
+        if (spec[i].type == CLI_ARG_COLORS)
+        {
+            /* Greedy: takes names until the first token that is not one. */
+            int choice;
+            while (token < args->argc && (choice = find_choice(&spec[i], args->argv[token])) >= 0)
+            {
+                if (arg->text == NULL)
+                {
+                    arg->text = args->argv[token];
+                }
+                arg->value |= (int32_t) (1U << choice);
+                token++;
+            }
+
+            arg->present = (arg->text != NULL);
+            if (!arg->present && !spec[i].optional)
+            {
+                if (token < args->argc)
+                {
+                    arg->text = args->argv[token];
+                    return CLI_ARGS_INVALID;
+                }
+                return CLI_ARGS_MISSING;
+            }
+            continue;
+        }
+
+        if (token >= args->argc)
+        {
+            if (spec[i].optional)
+            {
+                continue;
+            }
+            return CLI_ARGS_MISSING;
+        }
+
+        const char *const text = args->argv[token];
+        const int choice = find_choice(&spec[i], text);
+        arg->text = text;
+
+        switch (spec[i].type)
+        {
+            case CLI_ARG_INT:
+                if (choice >= 0)
+                {
+                    arg->keyword = (uint8_t) (choice + 1);
+                }
+                else if (!convert_int(&spec[i], text, &arg->value))
+                {
+                    return CLI_ARGS_INVALID;
+                }
+                break;
+
+            case CLI_ARG_ENUM:
+                if (choice < 0)
+                {
+                    return CLI_ARGS_INVALID;
+                }
+                arg->value = choice;
+                break;
+
+            default:
+                break;
+        }
+
+        arg->present = 1;
+        token++;
+    }
+
+    if (token < args->argc)
+    {
+        *failed = token;
+        return CLI_ARGS_TOO_MANY;
+    }
+
+    return CLI_ARGS_OK;
+}
@@ -0,0 +1,516 @@
+/*
+ * cli_bench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  On-target micro-benchmarks. Each case runs in a freshly created worker task
+ *  so its stack high-water mark measures exactly what the code under test
+ *  used; cycles come from the DWT cycle counter and are averaged over
+ *  BENCH_ITERATIONS calls.
+ */
+
+/* -- Standard Library -- */
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* -- User Library -- */
+#include "adc_task.h"
+#include "cli_bench.h"
+#include "cli_format.h"
+#include "cli_registry.h"
+#include "settings_task.h"
+#include "uart_cli.h"
+
+typedef size_t (*bench_fn)(void);
+
+typedef struct
+{
+    const char *name;
+    bench_fn candidate;     /* Our implementation */
+    bench_fn reference;     /* What it replaces */
+} BenchCase;
+
+typedef struct
+{
+    bench_fn fn;
+    TaskHandle_t owner;
+    uint32_t cycles;
+} BenchRun;
+
+/* -------------------------------------------------------------------------- */
+/*                              printf Cases                                  */
+/* -------------------------------------------------------------------------- */
+
+static void null_sink(void *context, const char *data, size_t len)
+{
+    (void) context;
+    (void) data;
+    (void) len;
+}
+
+static size_t cli_format_null(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const size_t len = cli_vformat(null_sink, NULL, format, args);
+    va_end(args);
+    return len;
+}
+
+/* The old cli_printf minus the UART write. */
+static size_t newlib_format(const char *format, ...)
+{
+    char print_buffer[100];
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(print_buffer, sizeof(print_buffer), format, args);
+    va_end(args);
+    return (size_t) len;
+}
+
+static size_t int_cli(void)       { return cli_format_null("%d", -123456); }
+static size_t int_newlib(void)    { return newlib_format("%d", -123456); }
+static size_t hex_cli(void)       { return cli_format_null("%08lX", 0xBEEFUL); }
+static size_t hex_newlib(void)    { return newlib_format("%08lX", 0xBEEFUL); }
+static size_t row_cli(void)       { return cli_format_null("%-10s | %6.2q | %17d |\r\n", "CLI Task", 1234, 508); }
+static size_t row_newlib(void)    { return newlib_format("%-10s | %6.2f | %17d |\r\n", "CLI Task", 12.34f, 508); }
+
+static const BenchCase Printf_Cases[] = {
+    { .name = "%d",              .candidate = int_cli, .reference = int_newlib },
+    { .name = "%08lX",           .candidate = hex_cli, .reference = hex_newlib },
+    { .name = "cpu_monitor row", .candidate = row_cli, .reference = row_newlib },
+};
+
+/* -------------------------------------------------------------------------- */
+/*                          Settings Queue Cases                              */
+/* -------------------------------------------------------------------------- */
+
+/* Depth SettingsQueue had while the settings task read its changes from a queue. */
+#define BENCH_QUEUE_LENGTH  (10U)
+
+/* Settings as it was before the tagged union: every message carried a 255-byte buffer. */
+typedef struct
+{
+    CONFIGS config_id;
+    uint8_t Buffer[UINT8_MAX];
+} LegacySettings;
+
+static QueueHandle_t Settings_Bench_Queue;
+static QueueHandle_t Legacy_Bench_Queue;
+
+/* One message in and out, built the way the senders build it. */
+static size_t settings_compact(void)
+{
+    Settings message = { .config_id = UART_CONFIG, .baud_rate = 115200 };
+
+    xQueueSend(Settings_Bench_Queue, &message, 0);
+    xQueueReceive(Settings_Bench_Queue, &message, 0);
+    return sizeof(message);
+}
+
+static size_t settings_legacy(void)
+{
+    LegacySettings message = { .config_id = UART_CONFIG, .Buffer = { 0 } };
+    const uint32_t baud_rate = 115200;
+
+    memcpy(message.Buffer, &baud_rate, sizeof(baud_rate));
+    xQueueSend(Legacy_Bench_Queue, &message, 0);
+    xQueueReceive(Legacy_Bench_Queue, &message, 0);
+    return sizeof(message);
+}
+
+static const BenchCase Settings_Cases[] = {
+    { .name = "send + receive", .candidate = settings_compact, .reference = settings_legacy },
+};
+
+/* -------------------------------------------------------------------------- */
+/*                              ADC DSP Cases                                 */
+/* -------------------------------------------------------------------------- */
+
+/* Each ADC period is measured for this long, after the restart settles. */
+#define BENCH_ADC_MS        (1000U)
+
+/* Blocks run through both filter chains by the bit-exactness check. */
+#define BENCH_DSP_BLOCKS    (50U)
+
+/* One ADC channel block, the same sizes as in the ADC task. */
+static uint16_t Dsp_Samples[ADC_BLOCK_SCANS];
+static int16_t  Dsp_Q15[ADC_BLOCK_SCANS];
+static int16_t  Dsp_Decimated[ADC_FILTERED_SCANS];
+static int16_t  Dsp_Out[ADC_BLOCK_SCANS];
+static uint16_t Dsp_Oversampled[ADC_OVERSAMPLED_SCANS];
+
+/* Complex Q15, as adc_dsp_fft() takes it; the second one only for the _ref check, which leaves a spectrum of
+ * noise in the first for the timed cases. */
+static uint32_t Dsp_Fft[2][ADC_DSP_FFT_SIZE];
+
+static AdcDcBlock Dsp_Dc;
+static AdcCic     Dsp_Cic;
+static AdcFir     Dsp_Fir;
+static AdcOversampler Dsp_Oversampler;
+
+static size_t to_q15_simd(void)     { adc_dsp_to_q15(Dsp_Samples, Dsp_Out, ADC_BLOCK_SCANS); return ADC_BLOCK_SCANS; }
+static size_t to_q15_ref(void)      { adc_dsp_to_q15_ref(Dsp_Samples, Dsp_Out, ADC_BLOCK_SCANS); return ADC_BLOCK_SCANS; }
+static size_t dc_block_simd(void)   { adc_dsp_dc_block(&Dsp_Dc, Dsp_Q15, Dsp_Out, ADC_BLOCK_SCANS); return ADC_BLOCK_SCANS; }
+static size_t dc_block_ref(void)    { adc_dsp_dc_block_ref(&Dsp_Dc, Dsp_Q15, Dsp_Out, ADC_BLOCK_SCANS); return ADC_BLOCK_SCANS; }
+static size_t cic_simd(void)        { return adc_dsp_cic(&Dsp_Cic, Dsp_Q15, Dsp_Out, ADC_BLOCK_SCANS); }
+static size_t cic_ref(void)         { return adc_dsp_cic_ref(&Dsp_Cic, Dsp_Q15, Dsp_Out, ADC_BLOCK_SCANS); }
+static size_t fir_simd(void)        { adc_dsp_fir(&Dsp_Fir, Dsp_Decimated, Dsp_Out, ADC_FILTERED_SCANS); return ADC_FILTERED_SCANS; }
+static size_t fir_ref(void)         { adc_dsp_fir_ref(&Dsp_Fir, Dsp_Decimated, Dsp_Out, ADC_FILTERED_SCANS); return ADC_FILTERED_SCANS; }
+static size_t oversample_simd(void) { return adc_dsp_oversample(&Dsp_Oversampler, Dsp_Samples, Dsp_Oversampled, ADC_BLOCK_SCANS); }
+static size_t oversample_ref(void)  { return adc_dsp_oversample_ref(&Dsp_Oversampler, Dsp_Samples, Dsp_Oversampled, ADC_BLOCK_SCANS); }
+
+/* Nothing is below code 0, so the whole block is searched: a capture's cost per block while it waits. */
+static size_t trigger_simd(void)    { return adc_dsp_find_trigger(Dsp_Samples, ADC_BLOCK_SCANS, 0, 0, ADC_TRIGGER_BELOW); }
+static size_t trigger_ref(void)     { return adc_dsp_find_trigger_ref(Dsp_Samples, ADC_BLOCK_SCANS, 0, 0, ADC_TRIGGER_BELOW); }
+
+/* In place, so the data shrinks from call to call; the M4's cycle counts do not depend on it. */
+static size_t fft_simd(void)        { adc_dsp_fft(Dsp_Fft[0]); return ADC_DSP_FFT_SIZE; }
+static size_t fft_ref(void)         { adc_dsp_fft_ref(Dsp_Fft[0]); return ADC_DSP_FFT_SIZE; }
+
+static const BenchCase Dsp_Cases[] = {
+    { .name = "to_q15 x100",     .candidate = to_q15_simd,   .reference = to_q15_ref },
+    { .name = "dc_block x100",   .candidate = dc_block_simd, .reference = dc_block_ref },
+    { .name = "cic x100",        .candidate = cic_simd,      .reference = cic_ref },
+    { .name = "fir16 x25",       .candidate = fir_simd,      .reference = fir_ref },
+    { .name = "oversample x100", .candidate = oversample_simd, .reference = oversample_ref },
+    { .name = "trigger x100",    .candidate = trigger_simd,  .reference = trigger_ref },
+    { .name = "fft1024",         .candidate = fft_simd,      .reference = fft_ref },
+};
+
+/* -- Bench Samples -- */
+/* Full-scale noise, so that the saturating paths are exercised too. */
+static void bench_dsp_samples(uint32_t *seed)
+{
+    for (uint32_t i = 0; i < ADC_BLOCK_SCANS; ++i)
+    {
+        *seed = *seed * 1664525U + 1013904223U;
+        Dsp_Samples[i] = (uint16_t) (*seed >> 20);
+    }
+}
+
+/* -- DSP Mismatches -- */
+/* Runs the ADC task's filter chain with the kernels and with the _ref versions; returns the outputs that differ. */
+static uint32_t bench_dsp_mismatches(void)
+{
+    static AdcDcBlock dc[2];
+    static AdcCic cic[2];
+    static AdcFir fir[2];
+    static int16_t stage[2][ADC_BLOCK_SCANS];
+    static int16_t out[2][ADC_FILTERED_SCANS];
+    static AdcOversampler os[2];
+    static uint16_t oversampled[2][ADC_OVERSAMPLED_SCANS];
+    static uint16_t fft_samples[ADC_DSP_FFT_SIZE];
+    uint32_t seed = 1, mismatches = 0;
+    size_t decimated[2], results[2];
+
+    for (uint32_t k = 0; k < 2; ++k)
+    {
+        adc_dsp_dc_block_init(&dc[k]);
+        adc_dsp_cic_init(&cic[k]);
+        adc_dsp_fir_init(&fir[k], ADC_DSP_LOWPASS);
+        adc_dsp_oversample_init(&os[k], 2);
+    }
+
+    for (uint32_t block = 0; block < BENCH_DSP_BLOCKS; ++block)
+    {
+        bench_dsp_samples(&seed);
+
+        adc_dsp_to_q15(Dsp_Samples, stage[0], ADC_BLOCK_SCANS);
+        adc_dsp_dc_block(&dc[0], stage[0], stage[0], ADC_BLOCK_SCANS);
+        decimated[0] = adc_dsp_cic(&cic[0], stage[0], stage[0], ADC_BLOCK_SCANS);
+        adc_dsp_fir(&fir[0], stage[0], out[0], decimated[0]);
+
+        adc_dsp_to_q15_ref(Dsp_Samples, stage[1], ADC_BLOCK_SCANS);
+        adc_dsp_dc_block_ref(&dc[1], stage[1], stage[1], ADC_BLOCK_SCANS);
+        decimated[1] = adc_dsp_cic_ref(&cic[1], stage[1], stage[1], ADC_BLOCK_SCANS);
+        adc_dsp_fir_ref(&fir[1], stage[1], out[1], decimated[1]);
+
+        mismatches += (decimated[0] != decimated[1]);
+        for (uint32_t i = 0; i < ADC_FILTERED_SCANS; ++i)
+        {
+            mismatches += (out[0][i] != out[1][i]);
+        }
+
+        /* Ratio 16 does not divide the block, so partial sums cross block edges. */
+        results[0] = adc_dsp_oversample(&os[0], Dsp_Samples, oversampled[0], ADC_BLOCK_SCANS);
+        results[1] = adc_dsp_oversample_ref(&os[1], Dsp_Samples, oversampled[1], ADC_BLOCK_SCANS);
+        mismatches += (results[0] != results[1]);
+        for (uint32_t i = 0; i < results[0] && i < results[1]; ++i)
+        {
+            mismatches += (oversampled[0][i] != oversampled[1][i]);
+        }
+
+        /* Every trigger, from an odd and an even start, at a level that fires somewhere in most blocks. */
+        for (ADC_TRIGGER trigger = ADC_TRIGGER_RISING; trigger <= ADC_TRIGGER_BELOW; ++trigger)
+        {
+            const uint16_t level = (uint16_t) (4000U + block);
+
+            for (uint32_t start = 0; start < 2; ++start)
+            {
+                mismatches += (adc_dsp_find_trigger(&Dsp_Samples[start], ADC_BLOCK_SCANS - start, 2048, level, trigger) !=
+                               adc_dsp_find_trigger_ref(&Dsp_Samples[start], ADC_BLOCK_SCANS - start, 2048, level, trigger));
+            }
+        }
+
+        /* The blocks end to end, as `adc fft` takes them. */
+        if (block * ADC_BLOCK_SCANS < ADC_DSP_FFT_SIZE)
+        {
+            const uint32_t take = (ADC_DSP_FFT_SIZE - block * ADC_BLOCK_SCANS < ADC_BLOCK_SCANS)
+                                  ? ADC_DSP_FFT_SIZE - block * ADC_BLOCK_SCANS : ADC_BLOCK_SCANS;
+
+            memcpy(&fft_samples[block * ADC_BLOCK_SCANS], Dsp_Samples, take * sizeof(uint16_t));
+        }
+    }
+
+    adc_dsp_fft_window(fft_samples, Dsp_Fft[0]);
+    memcpy(Dsp_Fft[1], Dsp_Fft[0], sizeof(Dsp_Fft[1]));
+    adc_dsp_fft(Dsp_Fft[0]);
+    adc_dsp_fft_ref(Dsp_Fft[1]);
+    for (uint32_t i = 0; i < ADC_DSP_FFT_SIZE; ++i)
+    {
+        mismatches += (Dsp_Fft[0][i] != Dsp_Fft[1][i]);
+    }
+
+    return mismatches;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Bench Runner                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -- Bench Worker Task -- */
+/* Runs one warm-up call, then times BENCH_ITERATIONS calls and reports back to the CLI task. */
+static void bench_worker(void *Arguments)
+{
+    BenchRun *const run = Arguments;
+
+    run->fn();
+
+    const uint32_t start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; ++i)
+    {
+        run->fn();
+    }
+    run->cycles = (DWT->CYCCNT - start) / BENCH_ITERATIONS;
+
+    xTaskNotifyGive(run->owner);
+    vTaskSuspend(NULL);
+}
+
+/* -- Measure One Function -- */
+/* Returns pdFALSE if the worker could not be created. `stack_bytes` is the worker's peak stack use. */
+static BaseType_t bench_measure(bench_fn fn, uint32_t *cycles, uint32_t *stack_bytes)
+{
+    BenchRun run = { .fn = fn, .owner = xTaskGetCurrentTaskHandle() };
+    TaskHandle_t worker = NULL;
+
+    if (xTaskCreate(bench_worker, "Bench", BENCH_STACK_WORDS, &run, uxTaskPriorityGet(NULL), &worker) != pdPASS)
+    {
+        return pdFALSE;
+    }
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    *cycles = run.cycles;
+    *stack_bytes = (BENCH_STACK_WORDS - uxTaskGetStackHighWaterMark(worker)) * sizeof(StackType_t);
+
+    vTaskDelete(worker);
+    return pdTRUE;
+}
+
+/* -- Run Case Table -- */
+static void bench_run_cases(const BenchCase *cases, size_t count, const char *candidate, const char *reference)
+{
+    cli_printf("%-16s | %-20s | %-20s\r\n", "case", candidate, reference);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t ours = 0, ours_stack = 0, theirs = 0, theirs_stack = 0;
+
+        if (!bench_measure(cases[i].candidate, &ours, &ours_stack) ||
+            !bench_measure(cases[i].reference, &theirs, &theirs_stack))
+        {
+            cli_print("Not enough heap for the bench task\r\n");
+            return;
+        }
+
+        cli_printf("%-16s | %8lu cyc %5lu B | %8lu cyc %5lu B\r\n", cases[i].name,
+                   (unsigned long) ours, (unsigned long) ours_stack,
+                   (unsigned long) theirs, (unsigned long) theirs_stack);
+    }
+}
+
+/* -- Create Bench Queue -- */
+/* A SettingsQueue-sized queue; returns the heap it took, queue control block included, or 0 on failure. */
+static size_t bench_queue_create(QueueHandle_t *queue, size_t item_size)
+{
+    const size_t before = xPortGetFreeHeapSize();
+
+    *queue = xQueueCreate(BENCH_QUEUE_LENGTH, item_size);
+    return (*queue != NULL) ? before - xPortGetFreeHeapSize() : 0;
+}
+
+/* -- Settings Bench -- */
+static void bench_settings(void)
+{
+    const size_t compact_heap = bench_queue_create(&Settings_Bench_Queue, sizeof(Settings));
+    const size_t legacy_heap = bench_queue_create(&Legacy_Bench_Queue, sizeof(LegacySettings));
+
+    if (compact_heap != 0 && legacy_heap != 0)
+    {
+        cli_printf("%-16s | %5u B, %5u B heap  | %5u B, %5u B heap\r\n", "message / queue",
+                   (unsigned) sizeof(Settings), (unsigned) compact_heap,
+                   (unsigned) sizeof(LegacySettings), (unsigned) legacy_heap);
+        bench_run_cases(Settings_Cases, sizeof(Settings_Cases) / sizeof(Settings_Cases[0]), "tagged union", "255 B buffer");
+    }
+    else
+    {
+        cli_print("Not enough heap for the bench queues\r\n");
+    }
+
+    if (Settings_Bench_Queue != NULL)
+    {
+        vQueueDelete(Settings_Bench_Queue);
+        Settings_Bench_Queue = NULL;
+    }
+    if (Legacy_Bench_Queue != NULL)
+    {
+        vQueueDelete(Legacy_Bench_Queue);
+        Legacy_Bench_Queue = NULL;
+    }
+}
+
+/* -- ADC Bench -- */
+/* Sustained acquisition at shorter and shorter periods, with every block taken and released as a reader
+ * would. The period in force before the bench is restored afterwards. */
+static void bench_adc(void)
+{
+    static const uint32_t periods_us[] = { 200, 100, 50, 20, ADC_MIN_PERIOD_US };
+    const uint32_t restore_us = adc_get_period_us();
+    const AdcBlock *block;
+    AdcReader reader;
+
+    cli_printf("%-9s | %9s | %6s | %5s | %6s | %9s | %9s | %6s\r\n",
+               "period", "scans/s", "blocks", "lost", "unread", "irq/s", "cyc/block", "load");
+
+    for (size_t i = 0; i < sizeof(periods_us) / sizeof(periods_us[0]); ++i)
+    {
+        uint32_t taken = 0;
+        AdcStats stats;
+
+        adc_set_period_us(periods_us[i]);
+        vTaskDelay(pdMS_TO_TICKS(10));
+        adc_reset_stats();
+        if (!adc_reader_open(&reader))
+        {
+            cli_print("All ADC readers busy\r\n");
+            break;
+        }
+
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t length = pdMS_TO_TICKS(BENCH_ADC_MS);
+        TickType_t elapsed = 0;
+
+        while (elapsed < length)
+        {
+            block = adc_block_take(&reader, length - elapsed);
+            if (block != NULL)
+            {
+                taken += (block->period_us == periods_us[i]);
+                adc_block_release(block);
+            }
+            elapsed = xTaskGetTickCount() - start;
+        }
+        adc_reader_close(&reader);
+        adc_get_stats(&stats);
+
+        const uint32_t ms = (uint32_t) (elapsed * portTICK_PERIOD_MS);
+        const uint64_t budget = (uint64_t) SystemCoreClock / 1000U * ms;
+
+        cli_printf("%6lu us | %9lu | %6lu | %5lu | %6lu | %9lu | %9lu | %3lu.%02lu%%\r\n",
+                   (unsigned long) periods_us[i],
+                   (unsigned long) ((uint64_t) taken * ADC_BLOCK_SCANS * 1000U / ms),
+                   (unsigned long) taken, (unsigned long) stats.lost, (unsigned long) stats.dropped,
+                   (unsigned long) ((uint64_t) stats.irqs * 1000U / ms),
+                   (unsigned long) ((stats.blocks != 0) ? stats.task_cycles / stats.blocks : 0),
+                   (unsigned long) (stats.task_cycles * 100U / budget),
+                   (unsigned long) (stats.task_cycles * 10000U / budget % 100U));
+    }
+
+    adc_set_period_us(restore_us);
+
+    /* The old adc_task took an EOC interrupt, a queue send and a task wake-up for every conversion. */
+    cli_printf("Per-conversion interrupts would need %lu irq/s at %lu us and %lu irq/s at %lu us\r\n",
+               (unsigned long) (ADC_CHANNELS * 1000000U / periods_us[0]), (unsigned long) periods_us[0],
+               (unsigned long) (ADC_CHANNELS * 1000000U / ADC_MIN_PERIOD_US), (unsigned long) ADC_MIN_PERIOD_US);
+}
+
+/* -- DSP Bench -- */
+static void bench_dsp(void)
+{
+    uint32_t seed = 7;
+    const uint32_t mismatches = bench_dsp_mismatches();
+
+    bench_dsp_samples(&seed);
+    adc_dsp_to_q15_ref(Dsp_Samples, Dsp_Q15, ADC_BLOCK_SCANS);
+    adc_dsp_cic_init(&Dsp_Cic);
+    adc_dsp_cic_ref(&Dsp_Cic, Dsp_Q15, Dsp_Decimated, ADC_BLOCK_SCANS);
+    adc_dsp_dc_block_init(&Dsp_Dc);
+    adc_dsp_fir_init(&Dsp_Fir, ADC_DSP_LOWPASS);
+    adc_dsp_oversample_init(&Dsp_Oversampler, 2);
+
+    cli_printf("Filter chain over %u blocks: %s (%lu outputs differ)\r\n", BENCH_DSP_BLOCKS,
+               (mismatches == 0) ? "bit-exact" : "MISMATCH", (unsigned long) mismatches);
+    bench_run_cases(Dsp_Cases, sizeof(Dsp_Cases) / sizeof(Dsp_Cases[0]), "SIMD", "portable");
+}
+
+static const char *const Bench_Names[] = { "printf", "settings", "adc", "dsp" };
+
+static const CliArgSpec Bench_Args[] =
+{
+    { "name", CLI_ARG_ENUM, .choices = Bench_Names, .choice_count = CLI_ARG_COUNT(Bench_Names) },
+};
+
+CLI_COMMAND_ARGS("bench", cli_bench, ALL, "Run micro-benchmarks", Bench_Args);
+
+/* -- Bench Command -- */
+/* `bench printf`: cli_vformat against newlib vsnprintf. `bench settings`: SettingsQueue messages against the
+ * old 255-byte buffer layout. `bench adc`: sustained ADC acquisition across sample periods. `bench dsp`: the
+ * adc_dsp.c kernels against their portable versions. */
+CLI_STATUS cli_bench(const CliArgs *args)
+{
+    switch (args->arg[0].value)
+    {
+        case 0: // printf
+            bench_run_cases(Printf_Cases, sizeof(Printf_Cases) / sizeof(Printf_Cases[0]), "cli", "newlib");
+            break;
+
+        case 1: // settings
+            bench_settings();
+            break;
+
+        case 2: // adc
+            bench_adc();
+            break;
+
+        case 3: // dsp
+            bench_dsp();
+            break;
+
+        default:
+            return CLI_FAILED;
+    }
+
+    return CLI_OK;
+}
@@ -0,0 +1,396 @@
+/*
+ * cli_format.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Streaming printf replacement for the CLI. Literal text between conversions
+ *  is handed to the sink as one run, every converted field as at most a few
+ *  more, so output length is unbounded and the only scratch space is the
+ *  digit buffer of a single number. No float math is involved anywhere, so
+ *  the calling task never touches the FPU registers and newlib's float printf
+ *  is not needed.
+ */
+
+/* -- Standard Library -- */
+#include <stdint.h>
+#include <string.h>
+
+/* -- User Library -- */
+#include "cli_format.h"
+
+typedef enum
+{
+    LEN_INT, LEN_CHAR, LEN_SHORT, LEN_LONG, LEN_LONG_LONG, LEN_SIZE
+} LENGTH_MODIFIER;
+
+typedef struct
+{
+    cli_format_sink sink;
+    void *context;
+    size_t count;
+} Emitter;
+
+typedef struct
+{
+    uint8_t left;       /* '-' */
+    uint8_t zero;       /* '0' */
+    char    sign;       /* '+' or ' ', 0 when absent */
+    int     width;
+    int     precision;  /* -1 when absent */
+} FieldSpec;
+
+/* Longest number: 64-bit octal would be 22, decimal needs 20 digits. */
+#define DIGITS_MAX  (24)
+
+static const char Lower_Digits[] = "0123456789abcdef";
+static const char Upper_Digits[] = "0123456789ABCDEF";
+static const char Spaces[] = "                ";
+static const char Zeros[]  = "0000000000000000";
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+static inline void emit(Emitter *out, const char *data, size_t len)
+{
+    if (len != 0)
+    {
+        out->sink(out->context, data, len);
+        out->count += len;
+    }
+}
+
+/* -- Emit Padding -- */
+/* Sends `count` copies of the space or zero run, 16 at a time. */
+static inline void emit_fill(Emitter *out, const char *fill, int count)
+{
+    while (count > 0)
+    {
+        const int run = (count < (int) sizeof(Spaces) - 1) ? count : (int) sizeof(Spaces) - 1;
+        emit(out, fill, (size_t) run);
+        count -= run;
+    }
+}
+
+/* -- Convert Digits -- */
+/* Writes `value` backwards ending at `end` and returns the first digit. 32-bit values avoid the 64-bit divide helper. */
+static inline char* convert_digits(char *end, uint64_t value, unsigned base, const char *digits)
+{
+    char *p = end;
+
+    if (base == 16)
+    {
+        do
+        {
+            *--p = digits[value & 0xF];
+            value >>= 4;
+        } while (value != 0);
+    }
+    else if (value <= UINT32_MAX)
+    {
+        uint32_t small = (uint32_t) value;
+        do
+        {
+            *--p = digits[small % 10U];
+            small /= 10U;
+        } while (small != 0);
+    }
+    else
+    {
+        do
+        {
+            *--p = digits[value % 10U];
+            value /= 10U;
+        } while (value != 0);
+    }
+
+    return p;
+}
+
+/* -- Emit Text Field -- */
+static void emit_text(Emitter *out, const FieldSpec *spec, const char *text, size_t len)
+{
+    const int pad = spec->width - (int) len;
+
+    if (!spec->left)
+    {
+        emit_fill(out, Spaces, pad);
+    }
+    emit(out, text, len);
+    if (spec->left)
+    {
+        emit_fill(out, Spaces, pad);
+    }
+}
+
+/* -- Emit Number Field -- */
+/* `fraction` >= 0 selects fixed point: that many of the low digits go after the decimal point. */
+static void emit_number(Emitter *out, const FieldSpec *spec, uint64_t magnitude, uint8_t negative,
+                        unsigned base, const char *digit_set, int fraction)
+{
+    char buffer[DIGITS_MAX];
+    char *const end = buffer + sizeof(buffer);
+    char *first = end;
+    int precision_zeros = 0;
+
+    if (fraction >= 0)
+    {
+        if (fraction > DIGITS_MAX - 2)
+        {
+            fraction = DIGITS_MAX - 2;
+        }
+
+        first = convert_digits(end, magnitude, base, digit_set);
+        while (end - first < fraction + 1)
+        {
+            *--first = '0';
+        }
+    }
+    else if (magnitude != 0 || spec->precision != 0)
+    {
+        first = convert_digits(end, magnitude, base, digit_set);
+        precision_zeros = spec->precision - (int) (end - first);
+    }
+
+    if (precision_zeros < 0)
+    {
+        precision_zeros = 0;
+    }
+
+    const char sign = negative ? '-' : spec->sign;
+    const int digits = (int) (end - first);
+    const int body = digits + precision_zeros + (sign != 0) + (fraction > 0);
+    const int pad = spec->width - body;
+
+    /* As in C, '0' is ignored with '-' and when a precision is given for an integer. */
+    const uint8_t zero_pad = spec->zero && !spec->left && (spec->precision < 0 || fraction >= 0);
+
+    if (!spec->left && !zero_pad)
+    {
+        emit_fill(out, Spaces, pad);
+    }
+    if (sign != 0)
+    {
+        emit(out, &sign, 1);
+    }
+    if (zero_pad)
+    {
+        emit_fill(out, Zeros, pad);
+    }
+    emit_fill(out, Zeros, precision_zeros);
+
+    if (fraction > 0)
+    {
+        emit(out, first, (size_t) (digits - fraction));
+        emit(out, ".", 1);
+        emit(out, end - fraction, (size_t) fraction);
+    }
+    else
+    {
+        emit(out, first, (size_t) digits);
+    }
+
+    if (spec->left)
+    {
+        emit_fill(out, Spaces, pad);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Formatter                                     */
+/* -------------------------------------------------------------------------- */
+
+/* -- Streaming vprintf -- */
+/* Walks `format` once; unknown conversions are copied through unchanged so mistakes stay visible. */
+size_t cli_vformat(cli_format_sink sink, void *context, const char *format, va_list args)
+{
+    Emitter out = { .sink = sink, .context = context, .count = 0 };
+    const char *run = format;
+
+    while (*format != '\0')
+    {
+        if (*format != '%')
+        {
+            format++;
+            continue;
+        }
+
+        emit(&out, run, (size_t) (format - run));
+        const char *const directive = format++;
+
+        FieldSpec spec = { .precision = -1 };
+        LENGTH_MODIFIER length = LEN_INT;
+
+        /* Flags */
+        for (;; format++)
+        {
+            if (*format == '-')
+                spec.left = 1;
+            else if (*format == '0')
+                spec.zero = 1;
+            else if (*format == '+')
+                spec.sign = '+';
+            else if (*format == ' ' && spec.sign == 0)
+                spec.sign = ' ';
+            else
+                break;
+        }
+
+        /* Width */
+        if (*format == '*')
+        {
+            spec.width = va_arg(args, int);
+            if (spec.width < 0)
+            {
+                spec.left = 1;
+                spec.width = -spec.width;
+            }
+            format++;
+        }
+        else
+        {
+            while (*format >= '0' && *format <= '9')
+            {
+                spec.width = spec.width * 10 + (*format++ - '0');
+            }
+        }
+
+        /* Precision */
+        if (*format == '.')
+        {
+            format++;
+            spec.precision = 0;
+
+            if (*format == '*')
+            {
+                spec.precision = va_arg(args, int);
+                format++;
+            }
+            else
+            {
+                while (*format >= '0' && *format <= '9')
+                {
+                    spec.precision = spec.precision * 10 + (*format++ - '0');
+                }
+            }
+        }
+
+        /* Length */
+        if (*format == 'h')
+        {
+            length = LEN_SHORT;
+            if (*++format == 'h')
+            {
+                length = LEN_CHAR;
+                format++;
+            }
+        }
+        else if (*format == 'l')
+        {
+            length = LEN_LONG;
+            if (*++format == 'l')
+            {
+                length = LEN_LONG_LONG;
+                format++;
+            }
+        }
+        else if (*format == 'z')
+        {
+            length = LEN_SIZE;
+            format++;
+        }
+
+        switch (*format)
+        {
+            case 'd':
+            case 'i':
+            case 'q':
+            {
+                long long value;
+
+                switch (length)
+                {
+                    case LEN_CHAR:      value = (signed char) va_arg(args, int);  break;
+                    case LEN_SHORT:     value = (short) va_arg(args, int);        break;
+                    case LEN_LONG:      value = va_arg(args, long);               break;
+                    case LEN_LONG_LONG: value = va_arg(args, long long);          break;
+                    case LEN_SIZE:      value = (long long) va_arg(args, size_t); break;
+                    default:            value = va_arg(args, int);                break;
+                }
+
+                const uint8_t negative = value < 0;
+                const uint64_t magnitude = negative ? 0U - (uint64_t) value : (uint64_t) value;
+                const int fraction = (*format == 'q') ? (spec.precision < 0 ? 0 : spec.precision) : -1;
+
+                emit_number(&out, &spec, magnitude, negative, 10, Lower_Digits, fraction);
+                break;
+            }
+
+            case 'u':
+            case 'x':
+            case 'X':
+            {
+                unsigned long long value;
+
+                switch (length)
+                {
+                    case LEN_CHAR:      value = (unsigned char) va_arg(args, unsigned);  break;
+                    case LEN_SHORT:     value = (unsigned short) va_arg(args, unsigned); break;
+                    case LEN_LONG:      value = va_arg(args, unsigned long);             break;
+                    case LEN_LONG_LONG: value = va_arg(args, unsigned long long);        break;
+                    case LEN_SIZE:      value = va_arg(args, size_t);                    break;
+                    default:            value = va_arg(args, unsigned);                  break;
+                }
+
+                spec.sign = 0;
+                emit_number(&out, &spec, value, 0, (*format == 'u') ? 10 : 16,
+                            (*format == 'X') ? Upper_Digits : Lower_Digits, -1);
+                break;
+            }
+
+            case 'c':
+            {
+                const char c = (char) va_arg(args, int);
+                emit_text(&out, &spec, &c, 1);
+                break;
+            }
+
+            case 's':
+            {
+                const char *text = va_arg(args, const char*);
+                if (text == NULL)
+                {
+                    text = "(null)";
+                }
+
+                size_t len = 0;
+                while (text[len] != '\0' && (spec.precision < 0 || len < (size_t) spec.precision))
+                {
+                    len++;
+                }
+
+                emit_text(&out, &spec, text, len);
+                break;
+            }
+
+            case '%':
+                emit(&out, "%", 1);
+                break;
+
+            case '\0':
+                /* Dangling '%' at the end: print what was there. */
+                emit(&out, directive, (size_t) (format - directive));
+                return out.count;
+
+            default:
+                emit(&out, directive, (size_t) (format + 1 - directive));
+                break;
+        }
+
+        run = ++format;
+    }
+
+    emit(&out, run, (size_t) (format - run));
+    return out.count;
+}
@@ -0,0 +1,165 @@
+/*
+ * cli_frame.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Frame codec for the binary CLI protocol: COBS byte stuffing, so 0x00 only
+ *  ever appears as the frame delimiter, and a CRC-16 over each frame. No RTOS
+ *  or HAL dependencies; the host client links the same file.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- User Library -- */
+#include "cli_frame.h"
+
+/* -- Global Variables -- */
+
+/* CRC-16/CCITT-FALSE, one nibble at a time: 32 bytes of table instead of 512. */
+static const uint16_t Crc16_Nibble[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/* -------------------------------------------------------------------------- */
+/*                               Codec Functions                              */
+/* -------------------------------------------------------------------------- */
+
+uint16_t cli_frame_crc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        crc = (uint16_t) ((crc << 4) ^ Crc16_Nibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t) ((crc << 4) ^ Crc16_Nibble[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+
+    return crc;
+}
+
+/* -- COBS Encode -- */
+/* Each block starts with a code byte: the distance to the next zero (or 0xFF for a full 254-byte run without one). */
+size_t cli_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_at = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (src[i] == 0)
+        {
+            dst[code_at] = code;
+            code_at = out++;
+            code = 1;
+            continue;
+        }
+
+        dst[out++] = src[i];
+        if (++code == 0xFF)
+        {
+            dst[code_at] = code;
+            code_at = out++;
+            code = 1;
+        }
+    }
+
+    dst[code_at] = code;
+    return out;
+}
+
+/* -- COBS Decode -- */
+/* Output never overtakes input, so decoding in place is safe. */
+size_t cli_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < len)
+    {
+        const uint8_t code = src[in++];
+
+        if (code == 0 || in + code - 1U > len)
+        {
+            return 0;
+        }
+
+        for (uint8_t i = 1; i < code; ++i)
+        {
+            if (src[in] == 0)
+            {
+                return 0;
+            }
+            dst[out++] = src[in++];
+        }
+
+        if (code != 0xFF && in < len)
+        {
+            dst[out++] = 0;
+        }
+    }
+
+    return out;
+}
+
+/* -- Pack Frame -- */
+size_t cli_frame_pack(const CliFrame *frame, uint8_t *raw, uint8_t *out)
+{
+    size_t payload_len = frame->payload_len;
+
+    if (payload_len > CLI_FRAME_MAX_PAYLOAD)
+    {
+        payload_len = CLI_FRAME_MAX_PAYLOAD;
+    }
+
+    raw[0] = (uint8_t) frame->id;
+    raw[1] = (uint8_t) (frame->id >> 8);
+    raw[2] = frame->type;
+    raw[3] = frame->status;
+
+    if (payload_len != 0 && frame->payload != raw + CLI_FRAME_HEADER_SIZE)
+    {
+        memmove(raw + CLI_FRAME_HEADER_SIZE, frame->payload, payload_len);
+    }
+
+    const size_t body = CLI_FRAME_HEADER_SIZE + payload_len;
+    const uint16_t crc = cli_frame_crc16(raw, body);
+    raw[body] = (uint8_t) crc;
+    raw[body + 1] = (uint8_t) (crc >> 8);
+
+    const size_t encoded = cli_cobs_encode(raw, body + CLI_FRAME_CRC_SIZE, out);
+    out[encoded] = CLI_FRAME_DELIMITER;
+    return encoded + 1;
+}
+
+/* -- Unpack Frame -- */
+CLI_FRAME_STATUS cli_frame_unpack(uint8_t *data, size_t len, CliFrame *frame)
+{
+    *frame = (CliFrame) { 0 };
+
+    const size_t decoded = cli_cobs_decode(data, len, data);
+
+    if (decoded < CLI_FRAME_HEADER_SIZE + CLI_FRAME_CRC_SIZE || decoded > CLI_FRAME_MAX)
+    {
+        return CLI_FRAME_MALFORMED;
+    }
+
+    const size_t body = decoded - CLI_FRAME_CRC_SIZE;
+
+    frame->id = (uint16_t) (data[0] | (data[1] << 8));
+    frame->type = data[2];
+    frame->status = data[3];
+    frame->payload = data + CLI_FRAME_HEADER_SIZE;
+    frame->payload_len = body - CLI_FRAME_HEADER_SIZE;
+
+    if (cli_frame_crc16(data, body) != (uint16_t) (data[body] | (data[body + 1] << 8)))
+    {
+        return CLI_FRAME_BAD_CRC;
+    }
+
+    return CLI_FRAME_OK;
+}
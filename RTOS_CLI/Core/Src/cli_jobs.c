@@ -0,0 +1,358 @@
+/*
+ * cli_jobs.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Command handlers run on a small pool of worker tasks instead of inside the
+ *  CLI task, so input keeps being echoed and parsed while a long command
+ *  streams its output. The CLI task waits CLI_JOB_DETACH_MS for each job:
+ *  quick commands look exactly as before, anything slower is detached, gets
+ *  a job id and can be listed with `jobs` and stopped with `kill <id>`.
+ *
+ *  Killing is cooperative. A handler that loops checks cli_job_sleep(); a
+ *  task holding the TX lock or a queue cannot be deleted safely from outside.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* -- User Library -- */
+#include "cli_jobs.h"
+#include "cli_registry.h"
+#include "uart_tx.h"
+
+typedef enum
+{
+    JOB_FREE,
+    JOB_QUEUED,
+    JOB_RUNNING,
+    JOB_DONE,
+}JOB_STATE;
+
+typedef struct
+{
+    uint16_t id;
+    volatile JOB_STATE state;
+    volatile uint8_t cancelled;
+    volatile uint8_t detached;      /* Nobody waits for it: the worker reports and frees the slot */
+    CLI_STATUS status;
+    const CliStruct *cmd;
+    TickType_t started;
+    CliArgs args;                   /* argv[] and arg[].text point into line[] */
+    char line[MAX_CMD_LEN];
+} CliJob;
+
+typedef struct
+{
+    TaskHandle_t task;
+    SemaphoreHandle_t wake;         /* Given by `kill` to cut a cli_job_sleep() short */
+    CliJob *volatile job;
+} CliWorker;
+
+/* -- Function Declarations -- */
+
+/* `jobs`: list queued and running jobs. */
+static CLI_STATUS jobs_command(const CliArgs*);
+
+/* `kill <id>`: ask a job to stop. */
+static CLI_STATUS kill_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+static CliJob    Jobs[CLI_JOB_SLOTS];
+static CliWorker Workers[CLI_JOB_WORKERS];
+
+static QueueHandle_t     Job_Queue;
+static SemaphoreHandle_t Job_Done;      /* Given when the job the CLI task waits for finishes */
+static uint16_t          Job_Next_Id;
+
+static const char *const Job_State_Names[] = { "free", "queued", "running", "done" };
+
+static const CliArgSpec Kill_Args[] =
+{
+    { "id", CLI_ARG_INT, .min = 1, .max = UINT16_MAX },
+};
+
+CLI_COMMAND_ENTRY("jobs", jobs_command, ALL, "List background jobs", NULL, 0, CLI_INLINE);
+CLI_COMMAND_ENTRY("kill", kill_command, ALL, "Stop a background job", Kill_Args, CLI_ARG_COUNT(Kill_Args), CLI_INLINE);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Current Worker -- */
+/* NULL when called from anything but a job worker (e.g. the CLI task in binary mode). */
+static inline CliWorker* current_worker(void)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    for (uint32_t i = 0; i < CLI_JOB_WORKERS; ++i)
+    {
+        if (Workers[i].task == self)
+        {
+            return &Workers[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* -- Copy Arguments -- */
+/* Packs the tokens into the job's own line and moves every pointer over, so the CLI can reuse its buffer at once. */
+static inline void copy_args(CliJob *job, const CliArgs *args)
+{
+    size_t used = 0;
+
+    job->args = *args;
+
+    for (size_t i = 0; i < args->argc; ++i)
+    {
+        const size_t len = strlen(args->argv[i]) + 1;
+
+        memcpy(job->line + used, args->argv[i], len);
+        job->args.argv[i] = job->line + used;
+        used += len;
+
+        for (size_t arg = 0; arg < CLI_MAX_ARGS; ++arg)
+        {
+            if (args->arg[arg].text == args->argv[i])
+            {
+                job->args.arg[arg].text = job->args.argv[i];
+            }
+        }
+    }
+}
+
+/* -- Print Job Line -- */
+/* `id state seconds command args...`, rebuilt from the job's argv. */
+static inline void print_job(const CliJob *job)
+{
+    uart_tx_lock();
+    cli_printf("%5u  %-8s %5lu s  ", job->id, Job_State_Names[job->state],
+               (unsigned long) ((xTaskGetTickCount() - job->started) * portTICK_PERIOD_MS / 1000U));
+    for (size_t i = 0; i < job->args.argc; ++i)
+    {
+        cli_printf("%s%s", i ? " " : "", job->args.argv[i]);
+    }
+    cli_print(job->cancelled ? " (killed)\r\n" : "\r\n");
+    uart_tx_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                Job Workers                                 */
+/* -------------------------------------------------------------------------- */
+
+/* -- Job Worker Task -- */
+/* Takes jobs off the queue in order. A detached job is reported and freed here; otherwise the CLI task collects it. */
+static void job_worker(void *Arguments)
+{
+    CliWorker *const worker = Arguments;
+    CliJob *job;
+
+    while (1)
+    {
+        xQueueReceive(Job_Queue, &job, portMAX_DELAY);
+
+        xSemaphoreTake(worker->wake, 0);
+        worker->job = job;
+
+        if (job->cancelled)
+        {
+            job->status = CLI_FAILED;
+        }
+        else
+        {
+            job->state = JOB_RUNNING;
+            job->status = job->cmd->handler(&job->args);
+        }
+
+        worker->job = NULL;
+
+        taskENTER_CRITICAL();
+        job->state = JOB_DONE;
+        const uint8_t detached = job->detached;
+        taskEXIT_CRITICAL();
+
+        if (!detached)
+        {
+            xSemaphoreGive(Job_Done);
+            continue;
+        }
+
+        cli_printf("[%u] %s %s\r\n", job->id, job->cmd->command,
+                   job->cancelled ? "killed" : (job->status == CLI_OK ? "done" : "failed"));
+        job->state = JOB_FREE;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Job Functions                                */
+/* -------------------------------------------------------------------------- */
+
+/* -- Jobs Init -- */
+void cli_jobs_init(void)
+{
+    Job_Queue = xQueueCreate(CLI_JOB_SLOTS, sizeof(CliJob*));
+    Job_Done = xSemaphoreCreateBinary();
+    assert_param(Job_Queue != NULL && Job_Done != NULL);
+
+    for (uint32_t i = 0; i < CLI_JOB_WORKERS; ++i)
+    {
+        char name[configMAX_TASK_NAME_LEN] = "CLI Job 0";
+        name[8] = (char) ('0' + i);
+
+        Workers[i].wake = xSemaphoreCreateBinary();
+        assert_param(Workers[i].wake != NULL);
+        assert_param(xTaskCreate(job_worker, name, CLI_JOB_STACK_WORDS, &Workers[i], CLI_JOB_PRIORITY, &Workers[i].task) == pdPASS);
+    }
+}
+
+/* -- Run Job -- */
+/* Called by the CLI task only, which is therefore the only one claiming free slots. */
+CLI_STATUS cli_job_run(const CliStruct *cmd, const CliArgs *args)
+{
+    CliJob *job = NULL;
+
+    for (uint32_t i = 0; i < CLI_JOB_SLOTS && job == NULL; ++i)
+    {
+        if (Jobs[i].state == JOB_FREE)
+        {
+            job = &Jobs[i];
+        }
+    }
+
+    if (job == NULL)
+    {
+        cli_print("All job slots busy, see \"jobs\"\r\n");
+        return CLI_FAILED;
+    }
+
+    if (++Job_Next_Id == 0)
+    {
+        Job_Next_Id = 1;
+    }
+
+    copy_args(job, args);
+    job->id = Job_Next_Id;
+    job->cmd = cmd;
+    job->cancelled = 0;
+    job->detached = 0;
+    job->started = xTaskGetTickCount();
+    job->state = JOB_QUEUED;
+
+    xSemaphoreTake(Job_Done, 0);
+    xQueueSend(Job_Queue, &job, 0);
+
+    if (xSemaphoreTake(Job_Done, pdMS_TO_TICKS(CLI_JOB_DETACH_MS)) != pdPASS)
+    {
+        /* Decide under the same lock the worker finishes with, so exactly one side frees the slot. */
+        taskENTER_CRITICAL();
+        const uint8_t finished = (job->state == JOB_DONE);
+        job->detached = !finished;
+        taskEXIT_CRITICAL();
+
+        if (!finished)
+        {
+            cli_printf("[%u] %s %s in background\r\n", job->id, cmd->command,
+                       job->state == JOB_QUEUED ? "queued" : "running");
+            return CLI_OK;
+        }
+    }
+
+    const CLI_STATUS status = job->status;
+    job->state = JOB_FREE;
+    return status;
+}
+
+/* -- Active Jobs -- */
+/* A detached job that is done still has its `[id] done` line to print before the worker frees the slot. */
+uint32_t cli_jobs_active(void)
+{
+    uint32_t active = 0;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < CLI_JOB_SLOTS; ++i)
+    {
+        active += (Jobs[i].state == JOB_QUEUED || Jobs[i].state == JOB_RUNNING
+                   || (Jobs[i].state == JOB_DONE && Jobs[i].detached));
+    }
+    taskEXIT_CRITICAL();
+
+    return active;
+}
+
+/* -- Job Sleep -- */
+uint8_t cli_job_sleep(TickType_t ticks)
+{
+    CliWorker *const worker = current_worker();
+
+    if (worker == NULL || worker->job == NULL)
+    {
+        vTaskDelay(ticks);
+        return 0;
+    }
+
+    xSemaphoreTake(worker->wake, ticks);
+    return worker->job->cancelled;
+}
+
+/* -- Jobs Command -- */
+static CLI_STATUS jobs_command(const CliArgs*)
+{
+    if (cli_jobs_active() == 0)
+    {
+        cli_print("No jobs\r\n");
+        return CLI_OK;
+    }
+
+    cli_printf("%5s  %-8s %7s  %s\r\n", "ID", "State", "Time", "Command");
+    for (uint32_t i = 0; i < CLI_JOB_SLOTS; ++i)
+    {
+        if (Jobs[i].state == JOB_QUEUED || Jobs[i].state == JOB_RUNNING)
+        {
+            print_job(&Jobs[i]);
+        }
+    }
+
+    return CLI_OK;
+}
+
+/* -- Kill Command -- */
+/* Marks the job; a queued job is skipped by its worker, a running one is woken from cli_job_sleep(). */
+static CLI_STATUS kill_command(const CliArgs *args)
+{
+    const uint16_t id = (uint16_t) args->arg[0].value;
+
+    for (uint32_t i = 0; i < CLI_JOB_SLOTS; ++i)
+    {
+        CliJob *const job = &Jobs[i];
+
+        if (job->id != id || (job->state != JOB_QUEUED && job->state != JOB_RUNNING))
+        {
+            continue;
+        }
+
+        job->cancelled = 1;
+        for (uint32_t w = 0; w < CLI_JOB_WORKERS; ++w)
+        {
+            if (Workers[w].job == job)
+            {
+                xSemaphoreGive(Workers[w].wake);
+            }
+        }
+        return CLI_OK;
+    }
+
+    cli_printf("No job %u\r\n", id);
+    return CLI_FAILED;
+}
@@ -0,0 +1,211 @@
+/*
+ * cli_proto.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Binary machine protocol on USART1. After `proto binary` every request is a
+ *  COBS frame carrying one command line and a request id; the command runs
+ *  through the same registry and argument schemas as the text CLI, and all
+ *  of its cli_print/cli_printf output is captured into the response frame
+ *  with the same id. Requests may be sent back to back: the RX ring holds
+ *  them while earlier ones run and they are answered strictly in order.
+ *
+ *  Entering binary mode emits a lone delimiter so the host can discard the
+ *  echoed text before it. `proto text` (sent as a request) switches back.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+
+/* -- User Library -- */
+#include "cli_jobs.h"
+#include "cli_proto.h"
+#include "cli_registry.h"
+#include "uart_cli.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+
+typedef struct
+{
+    uint8_t *data;
+    size_t len;
+    uint8_t truncated;
+} ProtoCapture;
+
+/* -- Function Declarations -- */
+
+/* `proto text|binary` command. */
+static CLI_STATUS proto_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+static volatile CLI_PROTO_MODE Proto_Mode = CLI_PROTO_TEXT;
+
+static uint8_t Proto_Rx[CLI_FRAME_MAX_ENCODED];
+static uint8_t Proto_Tx_Raw[CLI_FRAME_MAX];
+static uint8_t Proto_Tx[CLI_FRAME_MAX_ENCODED];
+static char    Proto_Line[MAX_CMD_LEN];
+
+static const char *const Proto_Modes[] = { "text", "binary" };
+
+static const CliArgSpec Proto_Args[] =
+{
+    { "mode", CLI_ARG_ENUM, .choices = Proto_Modes, .choice_count = CLI_ARG_COUNT(Proto_Modes) },
+};
+
+CLI_COMMAND_ENTRY("proto", proto_command, ALL, "Switch USART1 between text and binary framed mode",
+                  Proto_Args, CLI_ARG_COUNT(Proto_Args), CLI_INLINE);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Capture Sink -- */
+/* Appends command output straight into the response payload area; whatever does not fit is counted as truncated. */
+static void capture_output(void *context, const char *data, size_t len)
+{
+    ProtoCapture *const capture = context;
+    const size_t space = CLI_FRAME_MAX_PAYLOAD - capture->len;
+
+    if (len > space)
+    {
+        len = space;
+        capture->truncated = 1;
+    }
+
+    memcpy(capture->data + capture->len, data, len);
+    capture->len += len;
+}
+
+/* -- Send Response -- */
+static inline void send_response(uint16_t id, uint8_t status, size_t payload_len)
+{
+    const CliFrame response =
+    {
+        .id = id,
+        .type = CLI_FRAME_RESPONSE,
+        .status = status,
+        .payload = Proto_Tx_Raw + CLI_FRAME_HEADER_SIZE,
+        .payload_len = payload_len,
+    };
+
+    uart_tx_write(Proto_Tx, cli_frame_pack(&response, Proto_Tx_Raw, Proto_Tx));
+}
+
+/* -- Handle Request Frame -- */
+/* Validates one received frame, runs its command with output captured and answers it. */
+static void handle_frame(size_t len, uint8_t overflow)
+{
+    CliFrame request;
+
+    if (len == 0)
+    {
+        /* Back-to-back delimiters: the host resynchronising. */
+        return;
+    }
+
+    const CLI_FRAME_STATUS status = overflow ? CLI_FRAME_MALFORMED : cli_frame_unpack(Proto_Rx, len, &request);
+
+    if (status != CLI_FRAME_OK)
+    {
+        send_response(overflow ? 0 : request.id, status, 0);
+        return;
+    }
+
+    if (request.type != CLI_FRAME_REQUEST || request.payload_len >= sizeof(Proto_Line))
+    {
+        send_response(request.id, CLI_FRAME_MALFORMED, 0);
+        return;
+    }
+
+    memcpy(Proto_Line, request.payload, request.payload_len);
+    Proto_Line[request.payload_len] = '\0';
+
+    ProtoCapture capture = { .data = Proto_Tx_Raw + CLI_FRAME_HEADER_SIZE };
+
+    cli_set_output(capture_output, &capture);
+    const CLI_STATUS result = cli_execute(Proto_Line);
+    cli_set_output(NULL, NULL);
+
+    send_response(request.id,
+                  (uint8_t) ((result == CLI_OK ? CLI_FRAME_OK : CLI_FRAME_FAILED) | (capture.truncated ? CLI_FRAME_TRUNCATED : 0)),
+                  capture.len);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Protocol Functions                            */
+/* -------------------------------------------------------------------------- */
+
+CLI_PROTO_MODE cli_proto_mode(void)
+{
+    return Proto_Mode;
+}
+
+/* -- Binary Session -- */
+/* Frames are peeked straight into Proto_Rx and consumed up to their delimiter; the reader only wakes per frame. */
+void cli_proto_session(void)
+{
+    const uint8_t sync = CLI_FRAME_DELIMITER;
+    size_t len = 0;
+    uint8_t overflow = 0;
+
+    uart_rx_set_terminator(CLI_FRAME_DELIMITER);
+    uart_tx_write(&sync, 1);
+
+    while (Proto_Mode == CLI_PROTO_BINARY)
+    {
+        if (uart_rx_lines_pending() == 0)
+        {
+            uart_rx_wait(UART_RX_RING_SIZE, portMAX_DELAY);
+            continue;
+        }
+
+        if (len == sizeof(Proto_Rx))
+        {
+            /* Too long to be a frame: drop what we have and skip to its delimiter. */
+            overflow = 1;
+            len = 0;
+        }
+
+        uint8_t *const chunk = Proto_Rx + len;
+        size_t count = uart_rx_peek(chunk, sizeof(Proto_Rx) - len);
+        const uint8_t *const end = memchr(chunk, CLI_FRAME_DELIMITER, count);
+
+        if (end != NULL)
+        {
+            count = (size_t) (end - chunk) + 1;
+        }
+        uart_rx_read(chunk, count);
+
+        if (end == NULL)
+        {
+            len += count;
+            continue;
+        }
+
+        handle_frame(len + count - 1, overflow);
+        len = 0;
+        overflow = 0;
+    }
+
+    uart_rx_set_terminator(UART_RX_TERMINATOR);
+}
+
+/* -- Proto Command -- */
+/* Only flips the mode; the CLI task starts or leaves the session once the current command has been answered.
+ * Background jobs print straight to the UART, which would corrupt the framing, so they must be gone first. */
+static CLI_STATUS proto_command(const CliArgs *args)
+{
+    if (args->arg[0].value == 1 && cli_jobs_active() != 0)
+    {
+        cli_print("Stop background jobs first, see \"jobs\"\r\n");
+        return CLI_FAILED;
+    }
+
+    Proto_Mode = (args->arg[0].value == 1) ? CLI_PROTO_BINARY : CLI_PROTO_TEXT;
+    return CLI_OK;
+}
@@ -0,0 +1,116 @@
+/*
+ * cli_registry.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Command registry. Modules drop CliStruct entries into the `cli_commands`
+ *  linker section with CLI_COMMAND(); the linker brackets the section with
+ *  __start_cli_commands / __stop_cli_commands. On first boot the entries are
+ *  indexed by name once, after which every lookup is a binary search on the
+ *  whole command token.
+ */
+
+/* -- Standard Library -- */
+#include <ctype.h>
+#include <strings.h>
+
+/* -- User Library -- */
+#include "cli_registry.h"
+
+/* -- Extern Variables -- */
+extern const CliStruct __start_cli_commands[];
+extern const CliStruct __stop_cli_commands[];
+
+/* -- Global Variables -- */
+
+static const CliStruct *Sorted_Commands[CLI_MAX_COMMANDS];
+static size_t Command_Count;
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Compare Token with Name -- */
+/* strcasecmp() for a token that is not NUL terminated: <0, 0 or >0 as `token` sorts before, equal or after `name`. */
+static inline int token_compare(const char *token, size_t len, const char *name)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        const int diff = tolower((unsigned char) token[i]) - tolower((unsigned char) name[i]);
+        if (diff != 0 || name[i] == '\0')
+        {
+            return (diff != 0) ? diff : 1;
+        }
+    }
+
+    /* Token exhausted: equal only if the name ends here too. */
+    return (name[len] == '\0') ? 0 : -1;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Registry Functions                            */
+/* -------------------------------------------------------------------------- */
+
+/* -- Registry Init -- */
+/* Insertion sort of pointers into the flash entries; n is small and this runs once. */
+size_t cli_registry_init(void)
+{
+    const size_t total = (size_t) (__stop_cli_commands - __start_cli_commands);
+
+    Command_Count = 0;
+
+    for (size_t i = 0; i < total && i < CLI_MAX_COMMANDS; ++i)
+    {
+        const CliStruct *const entry = &__start_cli_commands[i];
+        size_t slot = Command_Count++;
+
+        while (slot > 0 && strcasecmp(Sorted_Commands[slot - 1]->command, entry->command) > 0)
+        {
+            Sorted_Commands[slot] = Sorted_Commands[slot - 1];
+            slot--;
+        }
+        Sorted_Commands[slot] = entry;
+    }
+
+    return total - Command_Count;
+}
+
+/* -- Registry Lookup -- */
+const CliStruct* cli_registry_find(const char *token, size_t len)
+{
+    size_t low = 0;
+    size_t high = Command_Count;
+
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+        const int order = token_compare(token, len, Sorted_Commands[mid]->command);
+
+        if (order == 0)
+        {
+            return Sorted_Commands[mid];
+        }
+
+        if (order < 0)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+size_t cli_registry_count(void)
+{
+    return Command_Count;
+}
+
+const CliStruct* cli_registry_at(size_t index)
+{
+    return (index < Command_Count) ? Sorted_Commands[index] : NULL;
+}
@@ -0,0 +1,229 @@
+/*
+ * cpu_monitor.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Per-interval CPU load. Every CPU_MONITOR_PERIOD_MS the run time counters
+ *  of all tasks are read and each task's share of that interval is stored in
+ *  a short history, so a task that starts spinning shows up at once instead
+ *  of being averaged against the whole uptime.
+ *
+ *  Counters are only ever subtracted from their previous value, which stays
+ *  correct across a wrap of the 32-bit TIM2 clock, and with the 64-bit DWT
+ *  clock one interval (1.44e8 cycles at 144 MHz) still fits in 32 bits.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* -- User Library -- */
+#include "cpu_monitor.h"
+
+/* Largest interval, in run time clock ticks, whose load still fits `busy * 10000` in 32 bits. */
+#define LOAD_MAX_TOTAL      (UINT32_MAX / 10000U)
+
+typedef struct
+{
+    UBaseType_t number;             /* xTaskNumber, unique for the life of the task */
+    uint8_t used;
+    uint8_t seen;                   /* Found in the current sample */
+    uint16_t samples;
+    uint16_t stack_free;
+    configRUN_TIME_COUNTER_TYPE run_time;   /* Counter at the previous sample */
+    char name[configMAX_TASK_NAME_LEN];
+    uint16_t history[CPU_MONITOR_HISTORY];
+} CpuMonitorSlot;
+
+/* -- Global Variables -- */
+
+static CpuMonitorSlot Slots[CPU_MONITOR_MAX_TASKS];
+static TaskStatus_t   Task_Status[CPU_MONITOR_MAX_TASKS];
+
+static uint32_t History_Head;       /* Next history entry written, shared by all slots */
+static configRUN_TIME_COUNTER_TYPE Last_Total;
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Interval Load -- */
+/* `busy` as hundredths of a percent of `total`, without a 64-bit division. */
+static inline uint16_t interval_load(uint32_t busy, uint32_t total)
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    /* Counters are read one task at a time, so a task can appear a little busier than the interval. */
+    if (busy > total)
+    {
+        busy = total;
+    }
+
+    while (total > LOAD_MAX_TOTAL)
+    {
+        total >>= 1;
+        busy >>= 1;
+    }
+
+    return (uint16_t) (busy * 10000U / total);
+}
+
+/* -- Find Slot -- */
+/* Slot already tracking task `number`, or NULL. */
+static inline CpuMonitorSlot* find_slot(UBaseType_t number)
+{
+    for (uint32_t i = 0; i < CPU_MONITOR_MAX_TASKS; ++i)
+    {
+        if (Slots[i].used && Slots[i].number == number)
+        {
+            return &Slots[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* -- Claim Slot -- */
+/* Starts tracking a new task; only the baseline is taken, its first interval is partial. NULL when all are taken. */
+static inline CpuMonitorSlot* claim_slot(const TaskStatus_t *status)
+{
+    for (uint32_t i = 0; i < CPU_MONITOR_MAX_TASKS; ++i)
+    {
+        CpuMonitorSlot *const slot = &Slots[i];
+
+        if (!slot->used)
+        {
+            slot->used = 1;
+            slot->number = status->xTaskNumber;
+            slot->samples = 0;
+            slot->run_time = status->ulRunTimeCounter;
+            strncpy(slot->name, status->pcTaskName, sizeof(slot->name) - 1);
+            slot->name[sizeof(slot->name) - 1] = '\0';
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+/* -- Take Sample -- */
+/* Runs above every task that reads the history, and readers suspend the scheduler, so no lock is needed here. */
+static inline void take_sample(void)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    const UBaseType_t count = uxTaskGetSystemState(Task_Status, CPU_MONITOR_MAX_TASKS, &total);
+    const uint32_t elapsed = (uint32_t) (total - Last_Total);
+
+    Last_Total = total;
+
+    for (uint32_t i = 0; i < CPU_MONITOR_MAX_TASKS; ++i)
+    {
+        Slots[i].seen = 0;
+    }
+
+    for (UBaseType_t i = 0; i < count; ++i)
+    {
+        CpuMonitorSlot *slot = find_slot(Task_Status[i].xTaskNumber);
+
+        if (slot == NULL)
+        {
+            slot = claim_slot(&Task_Status[i]);
+            if (slot == NULL)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            slot->history[History_Head] = interval_load((uint32_t) (Task_Status[i].ulRunTimeCounter - slot->run_time), elapsed);
+            slot->run_time = Task_Status[i].ulRunTimeCounter;
+            if (slot->samples < CPU_MONITOR_HISTORY)
+            {
+                slot->samples++;
+            }
+        }
+
+        slot->stack_free = (uint16_t) Task_Status[i].usStackHighWaterMark;
+        slot->seen = 1;
+    }
+
+    /* Deleted tasks give their slot back. */
+    for (uint32_t i = 0; i < CPU_MONITOR_MAX_TASKS; ++i)
+    {
+        Slots[i].used &= Slots[i].seen;
+    }
+
+    History_Head = (History_Head + 1U) % CPU_MONITOR_HISTORY;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Monitor Functions                             */
+/* -------------------------------------------------------------------------- */
+
+/* -- CPU Monitor Task -- */
+void cpu_monitor_task(void * Arguments)
+{
+    TickType_t wake = xTaskGetTickCount();
+
+    while (1)
+    {
+        take_sample();
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(CPU_MONITOR_PERIOD_MS));
+    }
+}
+
+/* -- CPU Monitor Snapshot -- */
+size_t cpu_monitor_snapshot(CpuMonitorTask *tasks, size_t max)
+{
+    size_t written = 0;
+
+    vTaskSuspendAll();
+
+    for (uint32_t i = 0; i < CPU_MONITOR_MAX_TASKS && written < max; ++i)
+    {
+        const CpuMonitorSlot *const slot = &Slots[i];
+        CpuMonitorTask *const task = &tasks[written];
+
+        if (!slot->used)
+        {
+            continue;
+        }
+
+        memcpy(task->name, slot->name, sizeof(task->name));
+        task->samples = slot->samples;
+        task->stack_free = slot->stack_free;
+        task->last = task->min = task->avg = task->peak = 0;
+
+        uint32_t sum = 0;
+        for (uint32_t k = 0; k < slot->samples; ++k)
+        {
+            const uint16_t load = slot->history[(History_Head + CPU_MONITOR_HISTORY - 1U - k) % CPU_MONITOR_HISTORY];
+
+            if (k == 0)
+            {
+                task->last = task->min = task->peak = load;
+            }
+            task->min  = (load < task->min)  ? load : task->min;
+            task->peak = (load > task->peak) ? load : task->peak;
+            sum += load;
+        }
+
+        if (slot->samples != 0)
+        {
+            task->avg = (uint16_t) (sum / slot->samples);
+        }
+
+        written++;
+    }
+
+    xTaskResumeAll();
+
+    return written;
+}
@@ -0,0 +1,164 @@
+/*
+ * irq_stats.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Storage and the `irqstat` command for the interrupt histograms; the
+ *  entry/exit hooks themselves are inline in irq_stats.h.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- User Library -- */
+#include "irq_stats.h"
+
+#if IRQ_STATS_ENABLE
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* -- User Library -- */
+#include "cli_registry.h"
+#include "uart_cli.h"
+#include "uart_tx.h"
+
+/* -- Function Declarations -- */
+
+/* `irqstat [reset]`: print or clear the interrupt histograms. */
+static CLI_STATUS irqstat_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+IrqStats Irq_Stats[IRQ_STAT_COUNT];
+
+static const char *const Irq_Names[IRQ_STAT_COUNT] =
+{
+    "USART1", "DMA2 S2 RX", "DMA2 S7 TX", "TIM1", "TIM3", "ADC DMA",
+};
+
+static const char *const Irqstat_Modes[] = { "reset" };
+
+static const CliArgSpec Irqstat_Args[] =
+{
+    { "reset", CLI_ARG_ENUM, .optional = 1, .choices = Irqstat_Modes, .choice_count = 1 },
+};
+
+CLI_COMMAND_ARGS("irqstat", irqstat_command, ALL, "Interrupt time / period / jitter histograms", Irqstat_Args);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Cycles to Microseconds -- */
+/* Hundredths of a microsecond, for %.2q. */
+static inline uint32_t cycles_to_us100(const uint64_t cycles)
+{
+    return (uint32_t) (cycles * 100U / (SystemCoreClock / 1000000U));
+}
+
+/* -- Print Histogram -- */
+/* Non-empty buckets only, as `lower bound:count`; bounds are in cycles with k = 1024, M = 1024k. */
+static inline void print_histogram(const char *name, const uint32_t *buckets)
+{
+    uint32_t shown = 0;
+
+    cli_printf("  %-8s:", name);
+
+    for (uint32_t k = 0; k < IRQ_STATS_BUCKETS; ++k)
+    {
+        if (buckets[k] == 0)
+        {
+            continue;
+        }
+
+        const unsigned long bound = 1UL << k;
+        shown++;
+        if (k >= 20)
+        {
+            cli_printf(" %luM:%lu", bound >> 20, (unsigned long) buckets[k]);
+        }
+        else if (k >= 10)
+        {
+            cli_printf(" %luk:%lu", bound >> 10, (unsigned long) buckets[k]);
+        }
+        else
+        {
+            cli_printf(" %lu:%lu", bound, (unsigned long) buckets[k]);
+        }
+    }
+
+    cli_print(shown ? "\r\n" : " -\r\n");
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               IRQ Statistics                               */
+/* -------------------------------------------------------------------------- */
+
+/* -- IRQ Stats Init -- */
+void irq_stats_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* -- IRQ Stats Get -- */
+/* Handlers above configMAX_SYSCALL_INTERRUPT_PRIORITY can still land mid-copy; that only skews one sample. */
+void irq_stats_get(IRQ_STAT_ID id, IrqStats *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = Irq_Stats[id];
+    taskEXIT_CRITICAL();
+}
+
+/* -- IRQ Stats Reset -- */
+void irq_stats_reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(Irq_Stats, 0, sizeof(Irq_Stats));
+    taskEXIT_CRITICAL();
+}
+
+/* -- IRQ Stat Command -- */
+static CLI_STATUS irqstat_command(const CliArgs *args)
+{
+    IrqStats stats;
+
+    if (args->arg[0].present)
+    {
+        irq_stats_reset();
+        return CLI_OK;
+    }
+
+    uart_tx_lock();
+    cli_printf("Cycles at %lu MHz, buckets are [2^k, 2^(k+1)) cycles\r\n", (unsigned long) (SystemCoreClock / 1000000U));
+
+    for (uint32_t id = 0; id < IRQ_STAT_COUNT; ++id)
+    {
+        irq_stats_get((IRQ_STAT_ID) id, &stats);
+
+        if (stats.count == 0)
+        {
+            cli_printf("%-10s: no entries\r\n", Irq_Names[id]);
+            continue;
+        }
+
+        const uint64_t average = stats.cycles / stats.count;
+        cli_printf("%-10s: %lu entries, avg %lu cycles (%.2q us), max %lu cycles (%.2q us)\r\n", Irq_Names[id],
+                   (unsigned long) stats.count, (unsigned long) average, (int) cycles_to_us100(average),
+                   (unsigned long) stats.cycles_max, (int) cycles_to_us100(stats.cycles_max));
+        print_histogram("time", stats.duration);
+        print_histogram("period", stats.period);
+        print_histogram("jitter", stats.jitter);
+    }
+    uart_tx_unlock();
+
+    return CLI_OK;
+}
+
+#endif /* IRQ_STATS_ENABLE */
@@ -0,0 +1,362 @@
+/*
+ * led_engine.c
+ *
+ *  Created on: May 30, 2025
+ *      Author: Ashish Bansal
+ *
+ *  One software timer drives every blinking LED. Each expiry toggles the LEDs
+ *  whose deadline has come, moves each deadline on by exactly one period and
+ *  re-arms the timer for the earliest remaining deadline. A late expiry only
+ *  delays that one toggle; the next deadline is still counted from the
+ *  previous one.
+ *
+ *  Re-arming goes through the timer command queue and cannot block in the
+ *  timer service task, so it fails when that queue is full. The timer is
+ *  auto-reload for that case: the kernel reloads it on expiry without a
+ *  command, so a lost re-arm only makes the next toggle late, and the
+ *  expiry after it tries again.
+ *
+ *  LEDs with any other pattern are played by TIM4 and DMA (led_pwm.c) and
+ *  take no part here; when no LED blinks the timer is left stopped.
+ *
+ *  LED state is changed only by the timer service task: requests arrive
+ *  through xTimerPendFunctionCall(), so no writer needs a lock. `led` reads
+ *  it from a CLI worker, and copies it in a critical section so that the
+ *  timer service task cannot change it halfway through.
+ */
+
+/* -- Standard Library -- */
+#include <stdlib.h>
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "gpio.h"
+#include "stm32f4xx_ll_gpio.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/* -- User Library -- */
+#include "cli_registry.h"
+#include "led_engine.h"
+#include "settings_task.h"
+#include "uart_cli.h"
+#include "uart_tx.h"
+
+typedef struct
+{
+    GPIO_TypeDef *port;
+    uint16_t      pin;
+    LED_PATTERN   pattern;
+    TickType_t    period;   /* Ticks between toggles */
+    TickType_t    next;     /* Tick of the next toggle */
+}LedChannel;
+
+/* -- Function Declarations -- */
+
+static void led_timer_callback(TimerHandle_t timer);
+static void led_apply_requests(void *requests, uint32_t count);
+
+/* `led [pattern] [colour]... [period_ms] [levels]`: show or set LED patterns. */
+static CLI_STATUS led_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+/* Deadlines start at 0, so the first expiry turns every LED on together. */
+static LedChannel Leds[LED_COUNT] =
+{
+    [BLUE]   = { .port = BLUE_LED_GPIO_Port,   .pin = BLUE_LED_Pin,   .period = pdMS_TO_TICKS(LED_DEFAULT_RATE_MS) },
+    [RED]    = { .port = RED_LED_GPIO_Port,    .pin = RED_LED_Pin,    .period = pdMS_TO_TICKS(LED_DEFAULT_RATE_MS) },
+    [ORANGE] = { .port = ORANGE_LED_GPIO_Port, .pin = ORANGE_LED_Pin, .period = pdMS_TO_TICKS(LED_DEFAULT_RATE_MS) },
+    [GREEN]  = { .port = GREEN_LED_GPIO_Port,  .pin = GREEN_LED_Pin,  .period = pdMS_TO_TICKS(LED_DEFAULT_RATE_MS) },
+};
+
+const char *const COLOR_NAMES[LED_COUNT] = { "BLUE", "RED", "ORANGE", "GREEN"};
+
+const char *const LED_PATTERN_NAMES[LED_PATTERN_COUNT] = { "blink", "breathe", "heartbeat", "custom" };
+
+/* Shared by every PWM LED: one frame table, one period. Custom levels are the last ones given. */
+static uint32_t Pwm_Period_Ms = LED_DEFAULT_PATTERN_MS;
+static uint8_t  Custom_Levels[LED_CUSTOM_MAX_LEVELS];
+static uint8_t  Custom_Level_Count;
+
+static TimerHandle_t     Led_Timer;
+static SemaphoreHandle_t Led_Applied;
+static BaseType_t        Led_Rearmed;   /* Result of the last re-arm in led_apply_requests() */
+
+static const CliArgSpec Led_Args[] =
+{
+    { "pattern",   CLI_ARG_ENUM,   .optional = 1, .choices = LED_PATTERN_NAMES, .choice_count = LED_PATTERN_COUNT },
+    { "colour",    CLI_ARG_COLORS, .optional = 1, .choices = COLOR_NAMES, .choice_count = LED_COUNT },
+    { "period_ms", CLI_ARG_INT,    .optional = 1, .min = 1, .max = 60000 },
+    { "levels",    CLI_ARG_TEXT,   .optional = 1 },
+};
+
+CLI_COMMAND_ARGS("led", led_command, GUEST, "Show or set LED blink / PWM patterns", Led_Args);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Due -- */
+/* Tick comparison that survives the tick counter wrapping. */
+static inline BaseType_t led_due(const LedChannel *led, const TickType_t now)
+{
+    return (int32_t) (now - led->next) >= 0;
+}
+
+/* -- Service LEDs -- */
+/* Toggles every due blinking LED and re-arms the timer for the nearest deadline. Timer service task only.
+ * Returns pdFAIL when the timer command queue was full and the timer kept its old period. */
+static inline BaseType_t led_service(void)
+{
+    const TickType_t now = xTaskGetTickCount();
+    TickType_t wait = portMAX_DELAY;
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        LedChannel *const led = &Leds[colour];
+
+        if (led->pattern != LED_PATTERN_BLINK)
+        {
+            continue;
+        }
+
+        if (led_due(led, now))
+        {
+            LL_GPIO_TogglePin(led->port, led->pin);
+            led->next += led->period;
+
+            /* More than a whole period behind (debugger halt, long critical section, back from PWM): restart
+             * from now rather than toggling in a burst to catch up. */
+            if (led_due(led, now))
+            {
+                led->next = now + led->period;
+            }
+        }
+
+        if (led->next - now < wait)
+        {
+            wait = led->next - now;
+        }
+    }
+
+    if (wait == portMAX_DELAY)
+    {
+        return xTimerStop(Led_Timer, 0);
+    }
+
+    return xTimerChangePeriod(Led_Timer, wait, 0);
+}
+
+/* -- Parse Levels -- */
+/* "0,40,100": 2 to LED_CUSTOM_MAX_LEVELS percentages. Returns the count, 0 when malformed. */
+static inline uint8_t parse_levels(const char *text, uint8_t *levels)
+{
+    uint8_t count = 0;
+
+    while (*text != '\0')
+    {
+        char *end;
+        const unsigned long level = strtoul(text, &end, 10);
+
+        if (end == text || level > 100 || count == LED_CUSTOM_MAX_LEVELS || (*end != ',' && *end != '\0'))
+        {
+            return 0;
+        }
+
+        levels[count++] = (uint8_t) level;
+        text = (*end == ',') ? end + 1 : end;
+    }
+
+    return (count >= 2) ? count : 0;
+}
+
+/* -- Update Channels -- */
+/* A new blink interval counts from each LED's last toggle, so a shorter one can be due straight away. Returns
+ * nonzero when the PWM frame table needs rebuilding. */
+static inline uint8_t led_update_channels(const LedRequest *req)
+{
+    const LED_PATTERN pattern = (req->pattern < LED_PATTERN_COUNT) ? (LED_PATTERN) req->pattern : LED_PATTERN_BLINK;
+    uint8_t pwm_changed = (pattern != LED_PATTERN_BLINK);
+
+    if (pattern == LED_PATTERN_BLINK)
+    {
+        const TickType_t period = (pdMS_TO_TICKS(req->period_ms) != 0) ? pdMS_TO_TICKS(req->period_ms) : 1;
+
+        for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+        {
+            if (req->colour_mask & BIT(colour))
+            {
+                pwm_changed |= (Leds[colour].pattern != LED_PATTERN_BLINK);
+                Leds[colour].next = Leds[colour].next - Leds[colour].period + period;
+                Leds[colour].period = period;
+            }
+        }
+    }
+    else
+    {
+        Pwm_Period_Ms = req->period_ms;
+        if (pattern == LED_PATTERN_CUSTOM)
+        {
+            Custom_Level_Count = (req->level_count <= LED_CUSTOM_MAX_LEVELS) ? req->level_count : LED_CUSTOM_MAX_LEVELS;
+            memcpy(Custom_Levels, req->levels, Custom_Level_Count);
+        }
+    }
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        if (req->colour_mask & BIT(colour))
+        {
+            Leds[colour].pattern = pattern;
+        }
+    }
+
+    return pwm_changed;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 LED Engine                                 */
+/* -------------------------------------------------------------------------- */
+
+/* -- LED Engine Init -- */
+void led_engine_init(void)
+{
+    led_pwm_init();
+
+    Led_Applied = xSemaphoreCreateBinary();
+    assert_param(Led_Applied != NULL);
+
+    Led_Timer = xTimerCreate("LED", 1, pdTRUE, NULL, led_timer_callback);
+    assert_param(Led_Timer != NULL);
+    assert_param(xTimerStart(Led_Timer, 0) == pdPASS);
+}
+
+/* -- LED Engine Apply -- */
+/* Blocks so that `requests` can live on the caller's stack. A re-arm the timer service task could not queue is
+ * redone from here, where waiting for room in the command queue is allowed; a 1-tick period services the LEDs
+ * straight away and re-arms from there. */
+void led_engine_apply(const LedRequest *requests, size_t count)
+{
+    xTimerPendFunctionCall(led_apply_requests, (void*) requests, (uint32_t) count, portMAX_DELAY);
+    xSemaphoreTake(Led_Applied, portMAX_DELAY);
+
+    if (Led_Rearmed == pdFAIL)
+    {
+        xTimerChangePeriod(Led_Timer, 1, portMAX_DELAY);
+    }
+}
+
+/* -- LED Timer Callback -- */
+static void led_timer_callback(TimerHandle_t timer)
+{
+    (void) timer;
+    (void) led_service();
+}
+
+/* -- Apply Requests -- */
+/* All of them land in this one timer service call, between two LED toggles. Any change to a PWM LED rebuilds
+ * the whole frame table once, restarting the other PWM LEDs' cycle too. */
+static void led_apply_requests(void *requests, uint32_t count)
+{
+    const LedRequest *const reqs = (const LedRequest*) requests;
+    LED_PATTERN patterns[LED_COUNT];
+    uint8_t pwm_changed = 0;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        pwm_changed |= led_update_channels(&reqs[i]);
+    }
+
+    if (pwm_changed)
+    {
+        for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+        {
+            patterns[colour] = Leds[colour].pattern;
+        }
+        led_pwm_play(patterns, Pwm_Period_Ms, Custom_Levels, Custom_Level_Count);
+    }
+
+    Led_Rearmed = led_service();
+    xSemaphoreGive(Led_Applied);
+}
+
+/* -- LED Command -- */
+/* With no arguments prints each LED's pattern; otherwise submits an LED_CONFIG change to the settings task. PWM
+ * patterns share one period, so the last one given applies to all of them. */
+static CLI_STATUS led_command(const CliArgs *args)
+{
+    const CliArg *const pattern = &args->arg[0];
+    const CliArg *const period = &args->arg[2];
+    const CliArg *const levels = &args->arg[3];
+    Settings led_settings = { .config_id = LED_CONFIG };
+    LedRequest *const request = &led_settings.led;
+
+    if (!pattern->present)
+    {
+        LedChannel leds[LED_COUNT];
+        uint32_t pwm_period_ms;
+
+        taskENTER_CRITICAL();
+        memcpy(leds, Leds, sizeof(leds));
+        pwm_period_ms = Pwm_Period_Ms;
+        taskEXIT_CRITICAL();
+
+        uart_tx_lock();
+        cli_printf("PWM period: %lu ms\r\n", (unsigned long) pwm_period_ms);
+        for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+        {
+            if (leds[colour].pattern == LED_PATTERN_BLINK)
+            {
+                cli_printf("%-7s: blink every %lu ms\r\n", COLOR_NAMES[colour],
+                           (unsigned long) (leds[colour].period * portTICK_PERIOD_MS));
+            }
+            else
+            {
+                cli_printf("%-7s: %-9s duty %.1q%%\r\n", COLOR_NAMES[colour], LED_PATTERN_NAMES[leds[colour].pattern],
+                           (int) (led_pwm_duty(colour) * 1000U / LED_PWM_STEPS));
+            }
+        }
+        uart_tx_unlock();
+        return CLI_OK;
+    }
+
+    request->pattern = (uint8_t) pattern->value;
+    request->colour_mask = args->arg[1].present ? (uint8_t) args->arg[1].value
+                                               : BIT(BLUE) | BIT(RED) | BIT(ORANGE) | BIT(GREEN);
+
+    if (request->pattern == LED_PATTERN_BLINK)
+    {
+        request->period_ms = period->present ? (uint32_t) period->value : LED_DEFAULT_RATE_MS;
+    }
+    else
+    {
+        request->period_ms = period->present ? (uint32_t) period->value : LED_DEFAULT_PATTERN_MS;
+        if (request->period_ms < LED_PATTERN_MIN_PERIOD_MS || request->period_ms > LED_PATTERN_MAX_PERIOD_MS)
+        {
+            cli_printf("Pattern period is %u to %u ms\r\n", LED_PATTERN_MIN_PERIOD_MS, LED_PATTERN_MAX_PERIOD_MS);
+            return CLI_FAILED;
+        }
+    }
+
+    if (request->pattern == LED_PATTERN_CUSTOM)
+    {
+        request->level_count = levels->present ? parse_levels(levels->text, request->levels) : 0;
+        if (request->level_count == 0)
+        {
+            cli_printf("Levels are 2 to %u comma separated percentages, e.g. 0,20,100\r\n", LED_CUSTOM_MAX_LEVELS);
+            return CLI_FAILED;
+        }
+    }
+    else if (levels->present)
+    {
+        cli_print("Levels only apply to the custom pattern\r\n");
+        return CLI_FAILED;
+    }
+
+    return settings_report(settings_submit(&led_settings));
+}
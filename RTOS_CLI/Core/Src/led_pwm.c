@@ -0,0 +1,223 @@
+/*
+ * led_pwm.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  TIM4 runs PWM at LED_PWM_FRAME_HZ with LED_PWM_STEPS compare steps. Every
+ *  update event requests a DMA burst (DCR: base CCR1, 4 transfers) through
+ *  TIM4->DMAR, and DMA1 Stream6 / channel 2 (TIM4_UP) feeds it from the frame
+ *  table in circular mode. The compare registers are preloaded, so each frame
+ *  takes effect on the update after it is written: one period late, never
+ *  mid-period.
+ *
+ *  Patterns are worked out as perceived brightness in permille and squared
+ *  on the way into the table (gamma 2), so a linear fade looks linear.
+ *
+ *  The frame table is only rewritten with the stream stopped; called from the
+ *  timer service task through led_engine.c.
+ */
+
+/* -- STM32 Library -- */
+#include "main.h"
+#include "stm32f4xx_ll_bus.h"
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_gpio.h"
+#include "stm32f4xx_ll_tim.h"
+
+/* -- User Library -- */
+#include "led_pwm.h"
+
+/* TIM4 sits on APB1 (HCLK / 4); APB1 timers run at twice PCLK1. */
+#define LED_PWM_TIMER_CLOCK_HZ  (SystemCoreClock / 2U)
+
+#define LED_PWM_CHANNELS        (4U)
+#define LED_PWM_DMA_STREAM      LL_DMA_STREAM_6
+
+typedef struct
+{
+    GPIO_TypeDef *port;
+    uint32_t      pin;
+    uint32_t      channel;      /* LL_TIM_CHANNEL_CHx */
+    uint8_t       index;        /* Column in the frame table: CCR1 .. CCR4 */
+}LedPwmChannel;
+
+/* -- Global Variables -- */
+
+static const LedPwmChannel Channels[LED_COUNT] =
+{
+    [GREEN]  = { GREEN_LED_GPIO_Port,  GREEN_LED_Pin,  LL_TIM_CHANNEL_CH1, 0 },
+    [ORANGE] = { ORANGE_LED_GPIO_Port, ORANGE_LED_Pin, LL_TIM_CHANNEL_CH2, 1 },
+    [RED]    = { RED_LED_GPIO_Port,    RED_LED_Pin,    LL_TIM_CHANNEL_CH3, 2 },
+    [BLUE]   = { BLUE_LED_GPIO_Port,   BLUE_LED_Pin,   LL_TIM_CHANNEL_CH4, 3 },
+};
+
+/* Read by DMA1, so it must stay out of CCM RAM. */
+static uint16_t Frames[LED_PWM_MAX_FRAMES][LED_PWM_CHANNELS];
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Pulse -- */
+/* Triangle of height `peak` over [start, start + width) permille of the period, 0 elsewhere. */
+static inline uint32_t pulse(const uint32_t phase, const uint32_t start, const uint32_t width, const uint32_t peak)
+{
+    if (phase < start || phase >= start + width)
+    {
+        return 0;
+    }
+
+    const uint32_t offset = phase - start;
+    const uint32_t rise = (offset < width / 2U) ? offset : width - offset;
+
+    return peak * rise / (width / 2U);
+}
+
+/* -- Pattern Level -- */
+/* Perceived brightness of `frame` out of `frames`, in permille. */
+static inline uint32_t pattern_level(const LED_PATTERN pattern, const uint32_t frame, const uint32_t frames,
+                                     const uint8_t *levels, const uint8_t level_count)
+{
+    const uint32_t phase = frame * 1000U / frames;
+
+    switch (pattern)
+    {
+        case LED_PATTERN_BREATHE:
+            return (phase < 500U) ? phase * 2U : (1000U - phase) * 2U;
+
+        case LED_PATTERN_HEARTBEAT:
+            return pulse(phase, 0, 120, 1000) + pulse(phase, 200, 120, 600);
+
+        case LED_PATTERN_CUSTOM:
+        {
+            if (level_count == 0)
+            {
+                return 0;
+            }
+
+            /* Wraps from the last level back to the first, so the cycle has no jump. */
+            const uint32_t position = frame * level_count * 1000U / frames;
+            const uint32_t from = levels[position / 1000U] * 10U;
+            const uint32_t to = levels[(position / 1000U + 1U) % level_count] * 10U;
+            const uint32_t fraction = position % 1000U;
+
+            return (from * (1000U - fraction) + to * fraction) / 1000U;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+/* -- Stop Stream -- */
+static inline void led_pwm_stop(void)
+{
+    LL_TIM_DisableDMAReq_UPDATE(TIM4);
+    LL_DMA_DisableStream(DMA1, LED_PWM_DMA_STREAM);
+    while (LL_DMA_IsEnabledStream(DMA1, LED_PWM_DMA_STREAM))
+        ;
+    LL_TIM_DisableCounter(TIM4);
+    LL_TIM_CC_DisableChannel(TIM4, LL_TIM_CHANNEL_CH1 | LL_TIM_CHANNEL_CH2 | LL_TIM_CHANNEL_CH3 | LL_TIM_CHANNEL_CH4);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  LED PWM                                   */
+/* -------------------------------------------------------------------------- */
+
+/* -- LED PWM Init -- */
+void led_pwm_init(void)
+{
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM4);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+    LL_TIM_SetPrescaler(TIM4, LED_PWM_TIMER_CLOCK_HZ / (LED_PWM_FRAME_HZ * LED_PWM_STEPS) - 1U);
+    LL_TIM_SetAutoReload(TIM4, LED_PWM_STEPS - 1U);
+    LL_TIM_EnableARRPreload(TIM4);
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        LL_TIM_OC_SetMode(TIM4, Channels[colour].channel, LL_TIM_OCMODE_PWM1);
+        LL_TIM_OC_EnablePreload(TIM4, Channels[colour].channel);
+    }
+
+    LL_TIM_ConfigDMABurst(TIM4, LL_TIM_DMABURST_BASEADDR_CCR1, LL_TIM_DMABURST_LENGTH_4TRANSFERS);
+
+    LL_DMA_DisableStream(DMA1, LED_PWM_DMA_STREAM);
+    while (LL_DMA_IsEnabledStream(DMA1, LED_PWM_DMA_STREAM))
+        ;
+
+    LL_DMA_SetChannelSelection(DMA1, LED_PWM_DMA_STREAM, LL_DMA_CHANNEL_2);
+    LL_DMA_ConfigTransfer(DMA1, LED_PWM_DMA_STREAM,
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH |
+                          LL_DMA_MODE_CIRCULAR |
+                          LL_DMA_PERIPH_NOINCREMENT |
+                          LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_HALFWORD |
+                          LL_DMA_MDATAALIGN_HALFWORD |
+                          LL_DMA_PRIORITY_LOW);
+    LL_DMA_DisableFifoMode(DMA1, LED_PWM_DMA_STREAM);
+    LL_DMA_SetPeriphAddress(DMA1, LED_PWM_DMA_STREAM, (uintptr_t) &TIM4->DMAR);
+    LL_DMA_SetMemoryAddress(DMA1, LED_PWM_DMA_STREAM, (uintptr_t) Frames);
+}
+
+/* -- LED PWM Play -- */
+void led_pwm_play(const LED_PATTERN pattern[LED_COUNT], uint32_t period_ms, const uint8_t *levels, uint8_t level_count)
+{
+    uint32_t frames = period_ms * LED_PWM_FRAME_HZ / 1000U;
+    uint32_t channels = 0;
+
+    frames = (frames == 0) ? 1 : (frames > LED_PWM_MAX_FRAMES) ? LED_PWM_MAX_FRAMES : frames;
+
+    led_pwm_stop();
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        const LedPwmChannel *const ch = &Channels[colour];
+
+        if (pattern[colour] == LED_PATTERN_BLINK)
+        {
+            LL_GPIO_SetPinMode(ch->port, ch->pin, LL_GPIO_MODE_OUTPUT);
+            continue;
+        }
+
+        for (uint32_t frame = 0; frame < frames; ++frame)
+        {
+            const uint32_t level = pattern_level(pattern[colour], frame, frames, levels, level_count);
+            Frames[frame][ch->index] = (uint16_t) (level * level * LED_PWM_STEPS / 1000000U);
+        }
+
+        channels |= ch->channel;
+        LL_GPIO_SetAFPin_8_15(ch->port, ch->pin, LL_GPIO_AF_2);
+        LL_GPIO_SetPinMode(ch->port, ch->pin, LL_GPIO_MODE_ALTERNATE);
+    }
+
+    if (channels == 0)
+    {
+        return;
+    }
+
+    LL_DMA_ClearFlag_TC6(DMA1);
+    LL_DMA_ClearFlag_HT6(DMA1);
+    LL_DMA_ClearFlag_TE6(DMA1);
+    LL_DMA_SetDataLength(DMA1, LED_PWM_DMA_STREAM, frames * LED_PWM_CHANNELS);
+    LL_DMA_EnableStream(DMA1, LED_PWM_DMA_STREAM);
+
+    /* Load PSC/ARR and restart the count before update requests go to the DMA. */
+    LL_TIM_CC_EnableChannel(TIM4, channels);
+    LL_TIM_GenerateEvent_UPDATE(TIM4);
+    LL_TIM_EnableDMAReq_UPDATE(TIM4);
+    LL_TIM_EnableCounter(TIM4);
+}
+
+/* -- LED PWM Duty -- */
+uint32_t led_pwm_duty(COLOR colour)
+{
+    switch (Channels[colour].index)
+    {
+        case 0:  return LL_TIM_OC_GetCompareCH1(TIM4);
+        case 1:  return LL_TIM_OC_GetCompareCH2(TIM4);
+        case 2:  return LL_TIM_OC_GetCompareCH3(TIM4);
+        default: return LL_TIM_OC_GetCompareCH4(TIM4);
+    }
+}
@@ -0,0 +1,230 @@
+/*
+ * low_power.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Idle-time sleep. In tickless mode the kernel's vPortSuppressTicksAndSleep()
+ *  stops SysTick for as long as no task is due, sleeps with WFI and steps the
+ *  tick count by the time actually slept (SysTick reload arithmetic, so the
+ *  kernel clock does not drift). The core wakes for due tasks, for SysTick
+ *  reload limits (~116 ms at 144 MHz) and for interrupts: USART1 and its RX
+ *  DMA keep running in sleep mode, so typed input wakes the CLI as before.
+ *
+ *  CYCCNT stops with the core clock in WFI, but SysTick runs on through
+ *  sleep mode. Every sleep, of either kind, is timed on both; SysTick's
+ *  count less CYCCNT's is time CYCCNT missed, and goes to run_time.c, so
+ *  the run-time stats and irq_stats periods still add up to wall time.
+ *
+ *  The HAL TIM1 time base would otherwise wake the core every millisecond,
+ *  so once the scheduler runs it is stopped and HAL_GetTick() follows the
+ *  kernel tick instead.
+ *
+ *  Stop mode is not used: it halts SysTick and the USART clock, so it needs
+ *  the RTC wakeup timer and an EXTI line on the RX pin, and the first byte of
+ *  a command would be lost while the PLL restarts.
+ */
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* -- User Library -- */
+#include "cli_registry.h"
+#include "low_power.h"
+#include "run_time.h"
+#include "uart_cli.h"
+
+/* -- Function Declarations -- */
+
+/* `power [periodic|tickless]`: show wakeups per second, or switch the idle mode. */
+static CLI_STATUS power_command(const CliArgs*);
+
+/* -- Global Variables -- */
+
+static volatile LOW_POWER_MODE Mode = LOW_POWER_DEFAULT_MODE;
+
+/* Written by the idle task only. */
+static LowPowerStats Stats;
+static TickType_t    Window_Start;
+static uint32_t      Window_Wakeups;
+
+/* SysTick and CYCCNT as the core went to sleep. Idle task only. */
+static uint32_t Sleep_Systick;
+static uint32_t Sleep_Cyccnt;
+
+static uint32_t         Hal_Tick_Offset;
+static volatile uint8_t Hal_Tick_From_Kernel;
+
+static const char *const Mode_Names[] = { "periodic", "tickless" };
+
+static const CliArgSpec Power_Args[] =
+{
+    { "mode", CLI_ARG_ENUM, .optional = 1, .choices = Mode_Names, .choice_count = 2 },
+};
+
+CLI_COMMAND_ARGS("power", power_command, ALL, "Wakeups per second; set idle mode", Power_Args);
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Count Wakeup -- */
+/* Closes the rate window once at least a second of ticks has passed; long sleeps make it longer, not wrong. */
+static inline void count_wakeup(void)
+{
+    const TickType_t now = xTaskGetTickCount();
+    const TickType_t elapsed = now - Window_Start;
+
+    Stats.wakeups++;
+
+    if (elapsed >= configTICK_RATE_HZ)
+    {
+        Stats.per_second = (uint32_t) ((uint64_t) (Stats.wakeups - Window_Wakeups) * configTICK_RATE_HZ / elapsed);
+        Window_Wakeups = Stats.wakeups;
+        Window_Start = now;
+    }
+}
+
+/* -- Sleep Begin -- */
+static inline void sleep_begin(void)
+{
+    Sleep_Systick = SysTick->VAL;
+    Sleep_Cyccnt = DWT->CYCCNT;
+}
+
+/* -- Sleep End -- */
+/* SysTick counts down at the core clock and reloads from LOAD after reaching zero, which can only happen once per
+ * sleep: it wakes the core. Cycles it counted that CYCCNT did not were slept through. */
+static inline void sleep_end(const uint8_t wrapped)
+{
+    if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0)
+    {
+        return;
+    }
+
+    const uint32_t load = SysTick->LOAD;
+    /* Just restarted from zero: the first count loads LOAD. */
+    const uint32_t start = (Sleep_Systick != 0) ? Sleep_Systick : load + 1U;
+    const uint32_t counted = start - SysTick->VAL + (wrapped ? load + 1U : 0U);
+    const uint32_t awake = DWT->CYCCNT - Sleep_Cyccnt;
+
+    if (counted > awake)
+    {
+        run_time_add_sleep(counted - awake);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Low Power Functions                           */
+/* -------------------------------------------------------------------------- */
+
+/* -- Low Power Init -- */
+void low_power_init(void)
+{
+    Hal_Tick_Offset = uwTick;
+    HAL_SuspendTick();
+    Hal_Tick_From_Kernel = 1;
+}
+
+/* -- HAL Tick -- */
+/* Replaces the HAL's weak version. The kernel tick is stepped forward after every tickless sleep, so HAL
+ * timeouts stay right without TIM1 interrupting. */
+uint32_t HAL_GetTick(void)
+{
+    return Hal_Tick_From_Kernel ? Hal_Tick_Offset + (uint32_t) xTaskGetTickCount() : uwTick;
+}
+
+void low_power_set_mode(LOW_POWER_MODE mode)
+{
+    Mode = mode;
+}
+
+LOW_POWER_MODE low_power_get_mode(void)
+{
+    return Mode;
+}
+
+void low_power_get_stats(LowPowerStats *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = Stats;
+    taskEXIT_CRITICAL();
+}
+
+/* -- Idle Time -- */
+/* Called by the idle task with the scheduler suspended, before the tick is stopped. */
+uint32_t low_power_idle_time(uint32_t expected_idle_ticks)
+{
+    return (Mode == LOW_POWER_TICKLESS) ? expected_idle_ticks : 0;
+}
+
+/* -- Pre Sleep -- */
+/* Called right before WFI, interrupts masked, SysTick already counting the suppressed period. */
+void low_power_pre_sleep(void)
+{
+    sleep_begin();
+}
+
+/* -- Post Sleep -- */
+/* Called right after WFI returns, before the tick count is stepped. Interrupts are still masked, so a SysTick that
+ * reached zero is still pending; its COUNTFLAG is left for the port to read. */
+void low_power_post_sleep(uint32_t expected_idle_ticks)
+{
+    (void) expected_idle_ticks;
+
+    sleep_end((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0);
+
+    Stats.tickless_sleeps++;
+    count_wakeup();
+}
+
+/* -- Idle Hook -- */
+/* Periodic mode: sleep until the next interrupt, which is at most one tick away. In tickless mode the kernel
+ * sleeps right after this hook whenever two or more ticks are free, so nothing is done here. */
+void vApplicationIdleHook(void)
+{
+    if (Mode != LOW_POWER_PERIODIC)
+    {
+        return;
+    }
+
+    /* As in the port's tickless sleep, interrupts are masked so that the one that wakes the core waits until the
+     * sleep is measured; it still ends WFI. */
+    __disable_irq();
+    const uint8_t pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    sleep_begin();
+
+    __DSB();
+    __WFI();
+
+    sleep_end(!pending && (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0);
+    __enable_irq();
+
+    Stats.tick_sleeps++;
+    count_wakeup();
+}
+
+/* -- Power Command -- */
+static CLI_STATUS power_command(const CliArgs *args)
+{
+    LowPowerStats stats;
+
+    if (args->arg[0].present)
+    {
+        low_power_set_mode((LOW_POWER_MODE) args->arg[0].value);
+        return CLI_OK;
+    }
+
+    low_power_get_stats(&stats);
+
+    cli_printf("Idle mode : %s\r\n", Mode_Names[Mode]);
+    cli_printf("Wakeups/s : %lu\r\n", (unsigned long) stats.per_second);
+    cli_printf("Wakeups   : %lu (%lu tickless, %lu until next tick)\r\n", (unsigned long) stats.wakeups,
+               (unsigned long) stats.tickless_sleeps, (unsigned long) stats.tick_sleeps);
+
+    return CLI_OK;
+}
@@ -31,8 +31,13 @@
 #include "queue.h"
 #include "task.h"
 #include "tasks.h"
+#include "adc_task.h"
+#include "settings_store.h"
 #include "settings_task.h"
 #include "cpu_monitor.h"
+#include "irq_stats.h"
+#include "low_power.h"
+#include "led_engine.h"
 #include "semphr.h"
 /* USER CODE END Includes */
 
@@ -54,10 +59,8 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-volatile xQueueHandle User_Uart_Queue = NULL;
-extern volatile xQueueHandle SettingsQueue;
 //volatile xQueueHandle Adc_to_cdc_queue;
-xTaskHandle Adc_Task_Handle = NULL;
+TaskHandle_t Adc_Task_Handle = NULL;
 
 /* USER CODE END PV */
 
@@ -81,6 +84,9 @@ int main(void)
 
   /* USER CODE BEGIN 1 */
 //    __enable_irq();
+#if IRQ_STATS_ENABLE
+    irq_stats_init();   // Cycle counter for the interrupt histograms, before the HAL time base starts
+#endif
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -106,22 +112,27 @@ int main(void)
   MX_TIM2_Init();
   MX_TIM3_Init();
   /* USER CODE BEGIN 2 */
+#if !configRUN_TIME_STATS_USE_DWT
     HAL_TIM_Base_Start(&htim2); // This timer is used for CPU Monitoring Live RUN Time Use
+#endif
     HAL_NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_4);   //ensure proper priority grouping for freeRTOS
     SEGGER_SYSVIEW_Conf();
 
-    User_Uart_Queue = xQueueCreate(50, sizeof(char));
-    SettingsQueue = xQueueCreate(10, sizeof(Settings));
+    settings_store_init();      // Index the saved settings; the settings task applies them once it runs
+    adc_init();                 // ADC1, TIM3 and DMA2 Stream4 configured but stopped until the ADC task runs
 //    Adc_to_cdc_queue = xQueueCreate(50, sizeof(uint16_t));
 
+    // The settings task waits for the CLI task to bring USART1 and uart_tx up before it restores a saved baud
+    // rate over them: at the same priority the one created first runs first.
+    assert_param(xTaskCreate(setting_task, "Setting Task", 512, NULL, tskIDLE_PRIORITY + 3, &Setting_Task_Handle) == pdPASS);
     assert_param(xTaskCreate(Cli_Task, "CLI Task", 512, NULL, tskIDLE_PRIORITY + 3, NULL) == pdPASS);
-    assert_param(xTaskCreate(setting_task, "Setting Task", 512, NULL, tskIDLE_PRIORITY + 3, NULL) == pdPASS);
-//    assert_param(xTaskCreate(adc_task, "ADC Task", 512, NULL, tskIDLE_PRIORITY + 2, &Adc_Task_Handle) == pdPASS);
+    assert_param(xTaskCreate(cpu_monitor_task, "CPU Mon", CPU_MONITOR_STACK_WORDS, NULL, CPU_MONITOR_PRIORITY, NULL) == pdPASS);
+    assert_param(xTaskCreate(adc_task, "ADC Task", ADC_TASK_STACK_WORDS, NULL, ADC_TASK_PRIORITY, &Adc_Task_Handle) == pdPASS);
 
-    create_led_tasks();
-    HAL_TIM_Base_Start(&htim2); // This timer is used for CPU Monitoring Live RUN Time Use
+    led_engine_init();
 
 //    SEGGER_SYSVIEW_Start();      // Start trace recording
+    low_power_init();           // TIM1 time base off from here, HAL_GetTick() follows the kernel tick
     vTaskStartScheduler();
   /* USER CODE END 2 */
 
@@ -0,0 +1,85 @@
+/*
+ * run_time.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Clock behind the FreeRTOS run-time stats (portGET_RUN_TIME_COUNTER_VALUE).
+ *
+ *  With configRUN_TIME_STATS_USE_DWT the DWT cycle counter is used. CYCCNT is
+ *  32 bits and wraps every ~30 s at 144 MHz, so each read adds the cycles
+ *  since the previous read to a 64-bit total. That stays exact as long as the
+ *  counter is read at least once per wrap: every context switch reads it, and
+ *  the CPU monitor task does so once a second even when nothing else runs.
+ *
+ *  CYCCNT stops while the core sleeps in WFI, so low_power.c measures each
+ *  sleep against SysTick, which keeps counting, and credits it here. The
+ *  clock read is run_time_cycles(), CYCCNT with those cycles added, so idle
+ *  time is charged to the idle task instead of vanishing from the total.
+ *
+ *  Otherwise TIM2, prescaled to 1 MHz and started in main(), is read as is;
+ *  it runs through sleep by itself.
+ */
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* -- User Library -- */
+#include "run_time.h"
+
+/* -- Global Variables -- */
+
+volatile uint32_t Run_Time_Slept_Cycles;
+
+/* -- Add Sleep -- */
+void run_time_add_sleep(uint32_t cycles)
+{
+    Run_Time_Slept_Cycles += cycles;
+}
+
+#if configRUN_TIME_STATS_USE_DWT
+
+static uint64_t Run_Time_Cycles;
+static uint32_t Last_Cyccnt;
+
+/* -- Run Time Init -- */
+/* Called by vTaskStartScheduler(). */
+void run_time_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    Last_Cyccnt = run_time_cycles();
+}
+
+/* -- Run Time Now -- */
+/* Cycles since run_time_init(). Called from tasks and from the PendSV context switch, so the update is masked. */
+uint64_t run_time_now(void)
+{
+    const UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    const uint32_t now = run_time_cycles();
+    Run_Time_Cycles += (uint32_t) (now - Last_Cyccnt);
+    Last_Cyccnt = now;
+    const uint64_t cycles = Run_Time_Cycles;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return cycles;
+}
+
+#else
+
+void run_time_init(void)
+{
+}
+
+uint32_t run_time_now(void)
+{
+    return TIM2->CNT;
+}
+
+#endif /* configRUN_TIME_STATS_USE_DWT */
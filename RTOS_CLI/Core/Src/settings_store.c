@@ -0,0 +1,466 @@
+/*
+ * settings_store.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Settings log in flash sectors 1 and 2. One sector is active at a time:
+ *
+ *    sector : [magic][generation] record record ... 0xFF...
+ *    record : [key:16][length:16][crc32] value, padded to a word with 0xFF
+ *
+ *  A changed value is appended as a new record, so flash is only programmed,
+ *  never erased, until the active sector fills up. Compaction then erases the
+ *  other sector, copies the latest record of each key across and writes that
+ *  sector's header with the next generation. The two sectors take turns, which
+ *  spreads the erases evenly over both.
+ *
+ *  Writes are ordered so that a reset at any point leaves a readable store:
+ *  a record's value and CRC go first and its key/length word last, so a torn
+ *  record reads as the end of the log; a sector header's generation goes
+ *  first and its magic last, so a torn compaction leaves the old sector
+ *  active. At boot the sector with the newer generation wins and one pass
+ *  over it records the offset of the latest valid record of every key.
+ *
+ *  Sector erase takes hundreds of milliseconds on the single-bank F407 and
+ *  stalls every flash read meanwhile, interrupts included, so it only ever
+ *  happens from settings_store_put(), settings_store_compact() and
+ *  settings_store_clear(), in task context.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+/* -- User Library -- */
+#include "settings_store.h"
+
+#define STORE_MAGIC         (0x31564B53U)   /* "SKV1" */
+#define RECORD_END_KEY      (0xFFFFU)       /* Erased key/length word: nothing written from here on */
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t generation;
+}SectorHeader;
+
+typedef struct
+{
+    uint16_t key;
+    uint16_t length;
+    uint32_t crc;           /* CRC-32 over key, length and value */
+}RecordHeader;
+
+/* -- Extern Variables -- */
+
+/* Linker script: start of the SETTINGS region. The host build backs it with a file (host_flash.c). */
+extern uint8_t _settings_flash_start[];
+
+/* -- Global Variables -- */
+
+static const uint32_t Flash_Sectors[2] = { FLASH_SECTOR_1, FLASH_SECTOR_2 };
+
+/* CRC-32 (reflected 0xEDB88320), a nibble at a time. */
+static const uint32_t Crc_Table[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+};
+
+/* Guarded by Store_Lock once the scheduler runs. */
+static uint8_t            Active = SETTINGS_STORE_NO_SECTOR;
+static uint32_t           Write_Offset = SETTINGS_STORE_SECTOR_SIZE;
+static uint16_t           Index[SETTINGS_STORE_MAX_KEYS];   /* Offset of each key's latest record, 0 when unset */
+static SettingsStoreStats Stats = { .active_sector = SETTINGS_STORE_NO_SECTOR };
+static SemaphoreHandle_t  Store_Lock;
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Sector Base -- */
+static inline uint8_t *sector_base(const uint8_t sector)
+{
+    return _settings_flash_start + sector * SETTINGS_STORE_SECTOR_SIZE;
+}
+
+/* -- Record At -- */
+static inline const RecordHeader *record_at(const uint8_t sector, const uint32_t offset)
+{
+    return (const RecordHeader*) (sector_base(sector) + offset);
+}
+
+/* -- Record Size -- */
+static inline uint32_t record_size(const uint32_t length)
+{
+    return sizeof(RecordHeader) + ((length + 3U) & ~3U);
+}
+
+/* -- CRC-32 -- */
+static inline uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t length)
+{
+    while (length--)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ Crc_Table[crc & 0x0FU];
+        crc = (crc >> 4) ^ Crc_Table[crc & 0x0FU];
+    }
+    return crc;
+}
+
+/* -- Record CRC -- */
+static inline uint32_t record_crc(const uint16_t key, const uint16_t length, const void *value)
+{
+    const uint16_t fields[2] = { key, length };
+    const uint32_t crc = crc32_update(0xFFFFFFFFU, (const uint8_t*) fields, sizeof(fields));
+
+    return ~crc32_update(crc, (const uint8_t*) value, length);
+}
+
+/* -- Is Blank -- */
+/* A reset mid-append can leave value words behind an erased key/length word; never program over them. */
+static inline BaseType_t is_blank(const uint8_t sector, const uint32_t offset, const uint32_t length)
+{
+    const uint32_t *const words = (const uint32_t*) (sector_base(sector) + offset);
+
+    for (uint32_t i = 0; i < length / 4U; ++i)
+    {
+        if (words[i] != 0xFFFFFFFFU)
+        {
+            return pdFALSE;
+        }
+    }
+    return pdTRUE;
+}
+
+/* -- Program Words -- */
+/* Flash must be unlocked. */
+static inline HAL_StatusTypeDef program_words(const uintptr_t address, const uint32_t *words, const uint32_t count)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+    for (uint32_t i = 0; i < count && status == HAL_OK; ++i)
+    {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4U, words[i]);
+    }
+    return status;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 Flash Access                               */
+/* -------------------------------------------------------------------------- */
+
+/* -- Erase Sector -- */
+static HAL_StatusTypeDef erase_sector(const uint8_t sector)
+{
+    FLASH_EraseInitTypeDef erase =
+    {
+        .TypeErase    = FLASH_TYPEERASE_SECTORS,
+        .Sector       = Flash_Sectors[sector],
+        .NbSectors    = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3,
+    };
+    uint32_t failed_sector;
+    HAL_StatusTypeDef status;
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASHEx_Erase(&erase, &failed_sector);
+    HAL_FLASH_Lock();
+
+    return status;
+}
+
+/* -- Write Record -- */
+/* Value and CRC first, key/length word last: until that word lands the scan sees the end of the log. */
+static BaseType_t write_record(const uint8_t sector, const uint32_t offset, const uint16_t key, const void *value,
+                               const uint16_t length)
+{
+    uint32_t payload[SETTINGS_STORE_MAX_VALUE / 4U];
+    const uintptr_t address = (uintptr_t) (sector_base(sector) + offset);
+    const RecordHeader header = { .key = key, .length = length, .crc = record_crc(key, length, value) };
+    uint32_t fields;
+    HAL_StatusTypeDef status;
+
+    memset(payload, 0xFF, sizeof(payload));
+    memcpy(payload, value, length);
+    memcpy(&fields, &header, sizeof(fields));
+
+    HAL_FLASH_Unlock();
+    status = program_words(address + sizeof(RecordHeader), payload, (length + 3U) / 4U);
+    if (status == HAL_OK)
+    {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + sizeof(fields), header.crc);
+    }
+    if (status == HAL_OK)
+    {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, fields);
+    }
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) ? pdPASS : pdFAIL;
+}
+
+/* -- Scan Sector -- */
+/* Indexes the latest valid record of each key. Returns where the next record goes. */
+static uint32_t scan_sector(const uint8_t sector)
+{
+    uint32_t offset = sizeof(SectorHeader);
+
+    while (offset + sizeof(RecordHeader) <= SETTINGS_STORE_SECTOR_SIZE)
+    {
+        const RecordHeader *const record = record_at(sector, offset);
+
+        if (record->key == RECORD_END_KEY)
+        {
+            break;
+        }
+
+        /* A length this wrong means the rest of the sector cannot be walked: append nothing more here, so the
+         * next put compacts the good records away from it. */
+        if (record->length > SETTINGS_STORE_MAX_VALUE || offset + record_size(record->length) > SETTINGS_STORE_SECTOR_SIZE)
+        {
+            Stats.bad_records++;
+            return SETTINGS_STORE_SECTOR_SIZE;
+        }
+
+        if (record->key < SETTINGS_STORE_MAX_KEYS && record->crc == record_crc(record->key, record->length, record + 1))
+        {
+            Index[record->key] = (uint16_t) offset;
+            Stats.records++;
+        }
+        else
+        {
+            Stats.bad_records++;
+        }
+
+        offset += record_size(record->length);
+    }
+
+    return offset;
+}
+
+/* -- Compact -- */
+/* Store_Lock held. The active sector stays the active one until the new header is complete. */
+static BaseType_t compact(void)
+{
+    const uint8_t target = (Active == 0) ? 1 : 0;
+    const uint32_t generation = (Active == SETTINGS_STORE_NO_SECTOR) ? 1U : Stats.generation + 1U;
+    const SectorHeader header = { .magic = STORE_MAGIC, .generation = generation };
+    uint16_t index[SETTINGS_STORE_MAX_KEYS] = { 0 };
+    uint32_t offset = sizeof(SectorHeader);
+    uint32_t records = 0;
+    HAL_StatusTypeDef status;
+
+    if (erase_sector(target) != HAL_OK)
+    {
+        return pdFAIL;
+    }
+
+    for (uint16_t key = 0; key < SETTINGS_STORE_MAX_KEYS; ++key)
+    {
+        if (Index[key] == 0)
+        {
+            continue;
+        }
+
+        const RecordHeader *const record = record_at(Active, Index[key]);
+        if (write_record(target, offset, key, record + 1, record->length) != pdPASS)
+        {
+            return pdFAIL;
+        }
+
+        index[key] = (uint16_t) offset;
+        offset += record_size(record->length);
+        records++;
+    }
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, (uintptr_t) sector_base(target) + 4U, header.generation);
+    if (status == HAL_OK)
+    {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, (uintptr_t) sector_base(target), header.magic);
+    }
+    HAL_FLASH_Lock();
+
+    if (status != HAL_OK)
+    {
+        return pdFAIL;
+    }
+
+    Active = target;
+    Write_Offset = offset;
+    memcpy(Index, index, sizeof(Index));
+    Stats.generation = generation;
+    Stats.records = records;
+    Stats.compactions++;
+
+    return pdPASS;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Settings Store                               */
+/* -------------------------------------------------------------------------- */
+
+/* -- Settings Store Init -- */
+void settings_store_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    const uint32_t start = DWT->CYCCNT;
+
+    Store_Lock = xSemaphoreCreateMutex();
+    assert_param(Store_Lock != NULL);
+
+    for (uint8_t sector = 0; sector < 2; ++sector)
+    {
+        const SectorHeader *const header = (const SectorHeader*) sector_base(sector);
+
+        if (header->magic != STORE_MAGIC)
+        {
+            continue;
+        }
+
+        if (Active == SETTINGS_STORE_NO_SECTOR || (int32_t) (header->generation - Stats.generation) > 0)
+        {
+            Active = sector;
+            Stats.generation = header->generation;
+        }
+    }
+
+    /* A blank store counts as full, so the first put formats a sector through compaction. */
+    if (Active != SETTINGS_STORE_NO_SECTOR)
+    {
+        Write_Offset = scan_sector(Active);
+    }
+
+    Stats.scan_cycles = DWT->CYCCNT - start;
+}
+
+/* -- Settings Store Get -- */
+size_t settings_store_get(uint16_t key, void *value, size_t size)
+{
+    size_t length = 0;
+
+    if (key >= SETTINGS_STORE_MAX_KEYS)
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(Store_Lock, portMAX_DELAY);
+    if (Index[key] != 0)
+    {
+        const RecordHeader *const record = record_at(Active, Index[key]);
+
+        length = record->length;
+        memcpy(value, record + 1, (length < size) ? length : size);
+    }
+    xSemaphoreGive(Store_Lock);
+
+    return length;
+}
+
+/* -- Settings Store Put -- */
+BaseType_t settings_store_put(uint16_t key, const void *value, size_t length)
+{
+    const uint32_t size = record_size(length);
+    BaseType_t result = pdPASS;
+
+    if (key >= SETTINGS_STORE_MAX_KEYS || length > SETTINGS_STORE_MAX_VALUE)
+    {
+        return pdFAIL;
+    }
+
+    xSemaphoreTake(Store_Lock, portMAX_DELAY);
+
+    if (Index[key] != 0)
+    {
+        const RecordHeader *const record = record_at(Active, Index[key]);
+
+        if (record->length == length && memcmp(record + 1, value, length) == 0)
+        {
+            xSemaphoreGive(Store_Lock);
+            return pdPASS;
+        }
+    }
+
+    if (Write_Offset + size > SETTINGS_STORE_SECTOR_SIZE || !is_blank(Active, Write_Offset, size))
+    {
+        result = compact();
+    }
+
+    if (result == pdPASS && Write_Offset + size <= SETTINGS_STORE_SECTOR_SIZE)
+    {
+        result = write_record(Active, Write_Offset, key, value, (uint16_t) length);
+        if (result == pdPASS)
+        {
+            Index[key] = (uint16_t) Write_Offset;
+            Stats.records++;
+        }
+
+        /* Whatever part of a failed record reached flash is skipped over by the blank check next time. */
+        Write_Offset += size;
+    }
+    else
+    {
+        result = pdFAIL;
+    }
+
+    xSemaphoreGive(Store_Lock);
+    return result;
+}
+
+/* -- Settings Store Compact -- */
+BaseType_t settings_store_compact(void)
+{
+    xSemaphoreTake(Store_Lock, portMAX_DELAY);
+    const BaseType_t result = compact();
+    xSemaphoreGive(Store_Lock);
+
+    return result;
+}
+
+/* -- Settings Store Clear -- */
+BaseType_t settings_store_clear(void)
+{
+    BaseType_t result = pdPASS;
+
+    xSemaphoreTake(Store_Lock, portMAX_DELAY);
+    for (uint8_t sector = 0; sector < 2; ++sector)
+    {
+        if (erase_sector(sector) != HAL_OK)
+        {
+            result = pdFAIL;
+        }
+    }
+
+    Active = SETTINGS_STORE_NO_SECTOR;
+    Write_Offset = SETTINGS_STORE_SECTOR_SIZE;
+    memset(Index, 0, sizeof(Index));
+    Stats.generation = 0;
+    Stats.records = 0;
+    xSemaphoreGive(Store_Lock);
+
+    return result;
+}
+
+/* -- Settings Store Get Stats -- */
+void settings_store_get_stats(SettingsStoreStats *stats)
+{
+    xSemaphoreTake(Store_Lock, portMAX_DELAY);
+    *stats = Stats;
+    stats->active_sector = Active;
+    stats->used = (Active == SETTINGS_STORE_NO_SECTOR) ? 0 : Write_Offset;
+    stats->keys = 0;
+    for (uint16_t key = 0; key < SETTINGS_STORE_MAX_KEYS; ++key)
+    {
+        stats->keys += (Index[key] != 0);
+    }
+    xSemaphoreGive(Store_Lock);
+}
@@ -4,55 +4,432 @@
  *  Created on: Jun 1, 2025
  *      Author: Ashish Bansal
  */
+#include <string.h>
 #include <usart.h>
 
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "task.h"
 #include "tasks.h"
+#include "cli_registry.h"
+#include "led_engine.h"
+#include "settings_store.h"
 #include "settings_task.h"
+#include "uart_cli.h"
+#include "uart_tx.h"
 
-volatile xQueueHandle SettingsQueue;
-volatile xQueueHandle Led_Blink_Queue[LED_COUNT];
+/* `settings [compact|clear]`: show the stored settings, or compact / erase the store. */
+static CLI_STATUS settings_command(const CliArgs*);
+
+TaskHandle_t Setting_Task_Handle;
+
+/* Latest value per key not yet applied; `Pending_Keys` has BIT(key) set for each. Written by submitters and
+ * emptied by the settings task, both inside a critical section. */
+static Settings Pending[SETTINGS_KEY_COUNT];
+static uint32_t Pending_Keys;
+
+/* The open batch, latest value per key as in `Pending`. Filled by CLI workers and emptied by the CLI task,
+ * both inside a critical section. */
+static Settings Staged[SETTINGS_KEY_COUNT];
+static uint32_t Staged_Keys;
+static uint8_t  Batch_Open;
+static uint8_t  Batch_Coalesced;
+
+static uint32_t Submitted;          /* Changes accepted by settings_submit_batch() */
+static uint32_t Batched;            /* Changes held in a batch, which settle into fewer submitted ones */
+static uint32_t Coalesced;          /* Pending or batched values replaced before they were applied */
+static uint32_t Passes;             /* Batches the settings task has applied */
+
+/* Time from the task starting to the stored settings being in effect. */
+static uint32_t Restore_Cycles;
+
+static const char *const Settings_Actions[] = { "compact", "clear" };
+
+static const CliArgSpec Settings_Args[] =
+{
+    { "action", CLI_ARG_ENUM, .optional = 1, .choices = Settings_Actions, .choice_count = 2 },
+};
+
+CLI_COMMAND_ARGS("settings", settings_command, ALL, "Show, compact or clear the saved settings", Settings_Args);
+
+/* -- Settings Keys -- */
+/* BIT(key) for every key a change writes, 0 when it writes none. */
+static inline uint32_t settings_keys(const Settings *settings)
+{
+    switch (settings->config_id)
+    {
+        case LED_CONFIG:
+            return (uint32_t) (settings->led.colour_mask & (BIT(LED_COUNT) - 1)) << SETTINGS_KEY_LED_FIRST;
+
+        case UART_CONFIG:
+            return BIT(SETTINGS_KEY_UART_BAUD);
+
+        default:
+            return 0;
+    }
+}
+
+/* -- Same LED Request -- */
+/* Field by field: the padding byte of a LedRequest is whatever its submitter's stack held. */
+static inline BaseType_t same_led_request(const LedRequest *a, const LedRequest *b)
+{
+    return a->pattern == b->pattern && a->period_ms == b->period_ms && a->level_count == b->level_count
+           && memcmp(a->levels, b->levels, (a->level_count <= LED_CUSTOM_MAX_LEVELS) ? a->level_count : LED_CUSTOM_MAX_LEVELS) == 0;
+}
+
+/* -- Store Keys -- */
+/* Puts `settings` in the slot of each key it writes, an LED change narrowed to that one LED. Returns the number
+ * of keys that already held a value. Critical section held. */
+static inline uint32_t store_keys(Settings *slots, uint32_t *slot_keys, const Settings *settings)
+{
+    const uint32_t keys = settings_keys(settings);
+    uint32_t replaced = 0;
+
+    for (uint32_t key = 0; key < SETTINGS_KEY_COUNT; ++key)
+    {
+        if (!(keys & BIT(key)))
+        {
+            continue;
+        }
+
+        replaced += ((*slot_keys & BIT(key)) != 0);
+
+        slots[key] = *settings;
+        if (settings->config_id == LED_CONFIG)
+        {
+            slots[key].led.colour_mask = BIT(key - SETTINGS_KEY_LED_FIRST);
+        }
+        *slot_keys |= BIT(key);
+    }
+
+    return replaced;
+}
+
+/* -- Settings Submit Batch -- */
+SETTINGS_SUBMIT settings_submit_batch(const Settings *settings, size_t count)
+{
+    SETTINGS_SUBMIT result = SETTINGS_SUBMITTED;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (settings_keys(&settings[i]) == 0)
+        {
+            return SETTINGS_INVALID;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t replaced = store_keys(Pending, &Pending_Keys, &settings[i]);
+
+        if (replaced != 0)
+        {
+            result = SETTINGS_COALESCED;
+            Coalesced += replaced;
+        }
+    }
+    Submitted += count;
+    taskEXIT_CRITICAL();
+
+    xTaskNotifyGive(Setting_Task_Handle);
+    return result;
+}
+
+/* -- Settings Submit -- */
+SETTINGS_SUBMIT settings_submit(const Settings *settings)
+{
+    if (settings_keys(settings) == 0)
+    {
+        return SETTINGS_INVALID;
+    }
+
+    taskENTER_CRITICAL();
+    if (Batch_Open)
+    {
+        const uint32_t replaced = store_keys(Staged, &Staged_Keys, settings);
+
+        Batch_Coalesced |= (replaced != 0);
+        Coalesced += replaced;
+        Batched++;
+        taskEXIT_CRITICAL();
+        return SETTINGS_BATCHED;
+    }
+    taskEXIT_CRITICAL();
+
+    return settings_submit_batch(settings, 1);
+}
+
+/* -- Settings Batch Begin -- */
+void settings_batch_begin(void)
+{
+    taskENTER_CRITICAL();
+    Staged_Keys = 0;
+    Batch_Coalesced = 0;
+    Batch_Open = 1;
+    taskEXIT_CRITICAL();
+}
+
+/* -- Settings Batch End -- */
+/* LEDs given the same request go back into one change, so `led blink 100` counts once as it would unbatched. */
+SETTINGS_SUBMIT settings_batch_end(void)
+{
+    Settings batch[SETTINGS_KEY_COUNT];
+    size_t count = 0;
+
+    taskENTER_CRITICAL();
+    const uint32_t keys = Staged_Keys;
+    const uint8_t coalesced = Batch_Coalesced;
+    for (uint32_t key = 0; key < SETTINGS_KEY_COUNT; ++key)
+    {
+        if (keys & BIT(key))
+        {
+            batch[key] = Staged[key];
+        }
+    }
+    Batch_Open = 0;
+    taskEXIT_CRITICAL();
+
+    for (uint32_t key = 0; key < SETTINGS_KEY_COUNT; ++key)
+    {
+        size_t merged = 0;
+
+        if (!(keys & BIT(key)))
+        {
+            continue;
+        }
+
+        while (key >= SETTINGS_KEY_LED_FIRST && merged < count
+               && !(batch[merged].config_id == LED_CONFIG && same_led_request(&batch[merged].led, &batch[key].led)))
+        {
+            merged++;
+        }
+
+        if (key >= SETTINGS_KEY_LED_FIRST && merged < count)
+        {
+            batch[merged].led.colour_mask |= batch[key].led.colour_mask;
+        }
+        else
+        {
+            batch[count++] = batch[key];
+        }
+    }
+
+    if (count == 0)
+    {
+        return SETTINGS_SUBMITTED;
+    }
+
+    const SETTINGS_SUBMIT result = settings_submit_batch(batch, count);
+    return (coalesced && result == SETTINGS_SUBMITTED) ? SETTINGS_COALESCED : result;
+}
+
+/* -- Settings Report -- */
+CLI_STATUS settings_report(const SETTINGS_SUBMIT result)
+{
+    if (result == SETTINGS_COALESCED)
+    {
+        cli_print("Coalesced: replaces a change not applied yet\r\n");
+    }
+
+    return (result != SETTINGS_INVALID) ? CLI_OK : CLI_FAILED;
+}
+
+/* -- Settings Apply -- */
+/* LEDs given the same request are merged back into one, and all of them go to the LED engine in one call. */
+static void settings_apply(const Settings *batch, const uint32_t keys)
+{
+    LedRequest leds[LED_COUNT];
+    size_t led_count = 0;
+
+    if (keys & BIT(SETTINGS_KEY_UART_BAUD))
+    {
+        /* Let queued output leave at the old rate before the divider changes under the DMA. */
+        uart_tx_flush(pdMS_TO_TICKS(500));
+
+        huart1.Init.BaudRate = batch[SETTINGS_KEY_UART_BAUD].baud_rate;
+        HAL_UART_Init(&huart1);
+    }
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        const uint32_t key = SETTINGS_KEY_LED_FIRST + colour;
+        size_t merged = 0;
+
+        if (!(keys & BIT(key)))
+        {
+            continue;
+        }
+
+        while (merged < led_count && !same_led_request(&leds[merged], &batch[key].led))
+        {
+            merged++;
+        }
+
+        if (merged == led_count)
+        {
+            leds[led_count++] = batch[key].led;
+        }
+        else
+        {
+            leds[merged].colour_mask |= BIT(colour);
+        }
+    }
+
+    if (led_count != 0)
+    {
+        led_engine_apply(leds, led_count);
+    }
+}
+
+/* -- Settings Save -- */
+/* One record per key, so a later change to one LED leaves the others' records valid. */
+static void settings_save(const Settings *batch, const uint32_t keys)
+{
+    if (keys & BIT(SETTINGS_KEY_UART_BAUD))
+    {
+        settings_store_put(SETTINGS_KEY_UART_BAUD, &batch[SETTINGS_KEY_UART_BAUD].baud_rate, sizeof(uint32_t));
+    }
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        const uint32_t key = SETTINGS_KEY_LED_FIRST + colour;
+
+        if (keys & BIT(key))
+        {
+            settings_store_put(key, &batch[key].led, sizeof(LedRequest));
+        }
+    }
+}
+
+/* -- Settings Restore -- */
+/* Applied directly rather than submitted, so nothing is written back. Records of the wrong size (a struct
+ * that changed between firmware versions) are ignored. */
+static void settings_restore(void)
+{
+    Settings batch[SETTINGS_KEY_COUNT];
+    uint32_t keys = 0;
+
+    if (settings_store_get(SETTINGS_KEY_UART_BAUD, &batch[SETTINGS_KEY_UART_BAUD].baud_rate, sizeof(uint32_t)) == sizeof(uint32_t)
+        && batch[SETTINGS_KEY_UART_BAUD].baud_rate != huart1.Init.BaudRate)
+    {
+        keys |= BIT(SETTINGS_KEY_UART_BAUD);
+    }
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        const uint32_t key = SETTINGS_KEY_LED_FIRST + colour;
+
+        if (settings_store_get(key, &batch[key].led, sizeof(LedRequest)) == sizeof(LedRequest))
+        {
+            batch[key].led.colour_mask = BIT(colour);
+            keys |= BIT(key);
+        }
+    }
+
+    settings_apply(batch, keys);
+}
 
 void setting_task(void*)
 {
-    Settings queue_settings;
+    Settings batch[SETTINGS_KEY_COUNT];
+
+    /* A restored baud rate would be lost to MX_USART1_UART_Init(), and uart_tx_flush() needs uart_tx_init(). No
+     * change can be submitted before the CLI task is up, so the first notification is always the CLI task's. */
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    const uint32_t start = DWT->CYCCNT;
+
+    settings_restore();
+    Restore_Cycles = DWT->CYCCNT - start;
 
     while (1)
     {
-        if (xQueueReceive(SettingsQueue, (uint8_t*) &queue_settings, portMAX_DELAY) != pdPASS)
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        taskENTER_CRITICAL();
+        const uint32_t keys = Pending_Keys;
+        for (uint32_t key = 0; key < SETTINGS_KEY_COUNT; ++key)
         {
-            continue;
+            if (keys & BIT(key))
+            {
+                batch[key] = Pending[key];
+            }
         }
+        Pending_Keys = 0;
+        taskEXIT_CRITICAL();
 
-        switch (queue_settings.config_id)
+        if (keys == 0)
         {
-            case LED_CONFIG:
-                uint8_t LedFlags = queue_settings.Buffer[0];
-                uint32_t Rate = *(uint32_t*)(queue_settings.Buffer + 1);
+            continue;
+        }
 
-                for (COLOR color = 0; color < LED_COUNT; ++color)
-                {
-                    if (LedFlags & (1 << color))
-                    {
-                        xQueueOverwrite(Led_Blink_Queue[color], &Rate);
-                    }
-                }
+        settings_apply(batch, keys);
+        settings_save(batch, keys);
+        Passes++;
+    }
+}
 
-                break;
+/* -- Cycles to Milliseconds -- */
+/* Hundredths of a millisecond, for %.2q. */
+static inline int cycles_to_ms100(const uint32_t cycles)
+{
+    return (int) ((uint64_t) cycles * 100U / (SystemCoreClock / 1000U));
+}
 
-            case UART_CONFIG:
-                uint32_t NewBaudRate = 0;
-                memcpy(&NewBaudRate, queue_settings.Buffer, sizeof(NewBaudRate));
+/* -- Settings Command -- */
+static CLI_STATUS settings_command(const CliArgs *args)
+{
+    SettingsStoreStats stats;
+    LedRequest led;
+    uint32_t baud_rate;
 
-                huart1.Init.BaudRate = NewBaudRate;
-                HAL_UART_Init(&huart1);
-                break;
+    if (args->arg[0].present)
+    {
+        const BaseType_t result = (args->arg[0].value == 0) ? settings_store_compact() : settings_store_clear();
 
-            case ADC_CONFIG:
-                break;
-            default:
-                break;
+        if (result != pdPASS)
+        {
+            cli_print("Flash erase / program failed\r\n");
+            return CLI_FAILED;
         }
+        return CLI_OK;
+    }
+
+    settings_store_get_stats(&stats);
+
+    uart_tx_lock();
+    if (stats.active_sector == SETTINGS_STORE_NO_SECTOR)
+    {
+        cli_print("Store   : blank, defaults in use\r\n");
+    }
+    else
+    {
+        cli_printf("Store   : flash sector %u, generation %lu, %lu / %u bytes\r\n", stats.active_sector + 1U,
+                   (unsigned long) stats.generation, (unsigned long) stats.used, SETTINGS_STORE_SECTOR_SIZE);
     }
+    cli_printf("Records : %lu (%lu keys), %lu bad, %lu compactions since boot\r\n", (unsigned long) stats.records,
+               (unsigned long) stats.keys, (unsigned long) stats.bad_records, (unsigned long) stats.compactions);
+    cli_printf("Boot    : scan %.2q ms, restore %.2q ms\r\n", cycles_to_ms100(stats.scan_cycles),
+               cycles_to_ms100(Restore_Cycles));
+    cli_printf("Submits : %lu, %lu held in batches, %lu coalesced, applied in %lu passes\r\n",
+               (unsigned long) Submitted, (unsigned long) Batched, (unsigned long) Coalesced, (unsigned long) Passes);
+
+    if (settings_store_get(SETTINGS_KEY_UART_BAUD, &baud_rate, sizeof(baud_rate)) == sizeof(baud_rate))
+    {
+        cli_printf("%-7s : %lu baud\r\n", "uart", (unsigned long) baud_rate);
+    }
+
+    for (COLOR colour = 0; colour < LED_COUNT; ++colour)
+    {
+        if (settings_store_get(SETTINGS_KEY_LED_FIRST + colour, &led, sizeof(led)) != sizeof(led)
+            || led.pattern >= LED_PATTERN_COUNT)
+        {
+            continue;
+        }
+        cli_printf("%-7s : %s, %lu ms\r\n", COLOR_NAMES[colour], LED_PATTERN_NAMES[led.pattern],
+                   (unsigned long) led.period_ms);
+    }
+    uart_tx_unlock();
+
+    return CLI_OK;
 }
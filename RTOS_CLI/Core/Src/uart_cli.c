@@ -11,6 +11,7 @@
 #include <ctype.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stdint.h>
 
 /* -- STM32 Library -- */
 #include "usart.h"
@@ -26,144 +27,237 @@
 
 /* -- User Library -- */
 #include "uart_cli.h"
+#include "cli_format.h"
+#include "cli_jobs.h"
+#include "cli_proto.h"
+#include "cli_registry.h"
+#include "cpu_monitor.h"
+#include "led_engine.h"
 #include "tasks.h"
 #include "settings_task.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
 
 /* -- Extern Variables -- */
 extern UART_HandleTypeDef hUSART1;
-extern volatile xQueueHandle User_Uart_Queue;
-extern volatile xQueueHandle SettingsQueue;
-extern xTaskHandle CpuMonitorHandler;
 extern RNG_HandleTypeDef hrng;
-extern const char COLOR_NAMES[LED_COUNT][10];
 
 /* -- Function Declarations -- */
 
 /* Returns a pointer to the static buffer containing the user’s input command. */
 static inline char* get_command_input(void);
 
-/* Transmit a single byte over the CLI UART using polling. */
+/* Queue a single byte on the CLI UART TX ring. */
 static inline void cli_tx_byte(const uint8_t);
 
 
-/* Compare user input to registered commands and invoke the matching handler. */
-static void command_handler(const char*);
+/* Default output sink: the TX ring. */
+static void cli_format_to_uart(void *context, const char *data, size_t len);
 
-/* Extracts the first integer found in `src_string`, returns it, and sets `length` to number of characters consumed. */
-long extract_number_from_string(const char *src_string, size_t *length);
+/* Look up a tokenized command and invoke its handler with the converted arguments. */
+static CLI_STATUS command_handler(CliArgs*);
+
+/* Run every `;`-separated command on one input line, counting them into the current batch. */
+static void run_command_line(char*);
+
+/* Print the batch summary (when more than one command ran) and the prompt. */
+static void end_batch(void);
 
 /* Print a list of all registered CLI commands and their descriptions. */
-static inline void list_commands(const char*);
+static inline CLI_STATUS list_commands(const CliArgs*);
 
 /* Generate and print a random number (possibly within a user-specified range). */
-void rand_data(const char*);
+CLI_STATUS rand_data(const CliArgs*);
 
-/* Parse LED color names and blink rate from `Arguments`, then queue a settings change. */
-void set_blink_rate(const char*);
+/* Queue a blink rate for the given LED colours (all LEDs when none are named). */
+CLI_STATUS set_blink_rate(const CliArgs*);
 
-/* Display CPU usage and free stack of all tasks, either once or continuously until ENTER is pressed. */
-void cpu_monitor(const char*);
+/* Display per-interval CPU load and free stack of all tasks, either once or continuously until killed. */
+CLI_STATUS cpu_monitor(const CliArgs*);
 
 /* Handle UART Settings */
-void uart_settings(const char*);
+CLI_STATUS uart_settings(const CliArgs*);
+
+typedef struct
+{
+    uint32_t commands;
+    uint32_t failed;
+    TickType_t start;
+    uint8_t prompt_owed;    /* A line ran since the last prompt */
+} CliBatch;
 
 /* -- Global Variables -- */
 
-const static CliStruct Command_Handlers[] = {
-    { .command = "list",           .handler = list_commands, .privilege_level = ALL,   .description = "List all commands" },
-    { .command = "uart",           .handler = uart_settings, .privilege_level = GUEST, .description = "Do uart settings from here" },
-    { .command = "set_blink_rate", .handler = set_blink_rate,.privilege_level = GUEST, .description = "Set LED Blink Speed" },
-    { .command = "rand_data",      .handler = rand_data,     .privilege_level = GUEST, .description = "Generate Random Data" },
-    { .command = "update",         .handler = NULL,          .privilege_level = ROOT,  .description = "Should Put Device in update mode" },
-    { .command = "cpu_monitor",    .handler = cpu_monitor,   .privilege_level = ALL,   .description = "Prints CPU Stats" },
+static CliArgs Line_Args;
+static CliBatch Batch = { .prompt_owed = 1 };
+
+static cli_format_sink Cli_Output = cli_format_to_uart;
+static void *Cli_Output_Context;
+
+static const char *const CPU_USAGE_Commands[] = { "once", "continue" };
+static const char *const UART_Keywords[]      = { "stats", "txmode" };
+static const char *const UART_Tx_Modes[]      = { "block", "drop" };
+
+static const CliArgSpec Rand_Data_Args[] =
+{
+    { "min", CLI_ARG_INT, .optional = 1, .min = INT32_MIN, .max = INT32_MAX },
+    { "max", CLI_ARG_INT, .optional = 1, .min = INT32_MIN, .max = INT32_MAX },
+};
+
+static const CliArgSpec Blink_Rate_Args[] =
+{
+    { "colour", CLI_ARG_COLORS, .optional = 1, .choices = COLOR_NAMES, .choice_count = LED_COUNT },
+    { "rate_ms", CLI_ARG_INT, .min = 1, .max = 60000 },
 };
 
-static const char* CPU_USAGE_Commands[] = { "once", "continue" };
+static const CliArgSpec Cpu_Monitor_Args[] =
+{
+    { "mode", CLI_ARG_ENUM, .choices = CPU_USAGE_Commands, .choice_count = 2 },
+};
+
+static const CliArgSpec Uart_Args[] =
+{
+    { "baud", CLI_ARG_INT, .min = 1200, .max = 921600, .choices = UART_Keywords, .choice_count = 2 },
+    { "mode", CLI_ARG_ENUM, .optional = 1, .choices = UART_Tx_Modes, .choice_count = 2 },
+};
+
+CLI_COMMAND("list",                list_commands,  ALL,   "List all commands");
+CLI_COMMAND_ARGS("uart",           uart_settings,  GUEST, "Do uart settings from here", Uart_Args);
+CLI_COMMAND_ARGS("set_blink_rate", set_blink_rate, GUEST, "Set LED Blink Speed", Blink_Rate_Args);
+CLI_COMMAND_ARGS("rand_data",      rand_data,      GUEST, "Generate Random Data", Rand_Data_Args);
+CLI_COMMAND("update",              NULL,           ROOT,  "Should Put Device in update mode");
+CLI_COMMAND_ARGS("cpu_monitor",    cpu_monitor,    ALL,   "Prints CPU Stats", Cpu_Monitor_Args);
 
 /* -------------------------------------------------------------------------- */
 /*                          Static Inline Function Group                      */
 /* -------------------------------------------------------------------------- */
 
 /* -- CLI UART TX Byte -- */
-/* Transmit a single byte over the CLI UART using polling. */
+/* Queue a single byte on the CLI UART TX ring. */
 static inline void cli_tx_byte(const uint8_t byte)
 {
-    while (!LL_USART_IsActiveFlag_TXE(USART1))
-        ;
-    LL_USART_TransmitData8(USART1, byte);
+    uart_tx_write(&byte, 1);
 }
 
 /* -- CLI Print String -- */
-/* Print a null-terminated string over the CLI UART by sending each byte. */
+/* Copy a null-terminated string into the TX ring (or the active output sink); the DMA sends it in the background. */
 void cli_print(const char *ptr)
 {
-    const size_t len = strlen(ptr);
-    for (size_t i = 0; i < len; ++i)
-    {
-        cli_tx_byte(ptr[i]);
-    }
+    Cli_Output(Cli_Output_Context, ptr, strlen(ptr));
 }
 
 /* -- CLI Print Fixed Length String -- */
-/* Print a buffer of length `len` over the CLI UART by sending each byte. */
+/* Copy a buffer of length `len` into the TX ring (or the active output sink); the DMA sends it in the background. */
 void cli_printn(const char *ptr, const size_t len)
 {
-    for (size_t i = 0; i < len; ++i)
-    {
-        cli_tx_byte(ptr[i]);
-    }
+    Cli_Output(Cli_Output_Context, ptr, len);
+}
+
+/* -- Redirect CLI Output -- */
+void cli_set_output(cli_format_sink sink, void *context)
+{
+    Cli_Output = (sink != NULL) ? sink : cli_format_to_uart;
+    Cli_Output_Context = context;
 }
 
 /* -- Get Command Input from User -- */
-/* Reads characters from the CLI queue until ENTER is pressed, handling backspace, and returns the resulting command string. */
+/* Reads characters from the RX ring until ENTER is pressed, handling backspace, and returns the resulting command string.
+ * The first key of a line wakes the task; after that it only wakes for the terminator, or after CLI_ECHO_TIMEOUT to echo. */
 static inline char* get_command_input(void)
 {
-    char received_char = 0;
     static char received_command[MAX_CMD_LEN] = { 0 };
+    uint8_t chunk[32];
+    char echo[sizeof(chunk) + 2];
     size_t index = 0;
+    uint8_t line_done = 0;
+    size_t trigger = 1;
+    TickType_t timeout = portMAX_DELAY;
 
-    cli_print("\r>>>> ");
-
-    do
+    while (!line_done)
     {
-        if (User_Uart_Queue != NULL)
-            xQueueReceive(User_Uart_Queue, &received_char, portMAX_DELAY);
+        if (uart_rx_wait(trigger, timeout) == 0)
+        {
+            /* Everything typed so far is echoed; sleep until the next key. */
+            trigger = 1;
+            timeout = portMAX_DELAY;
+            continue;
+        }
+
+        trigger = UART_RX_RING_SIZE;
+        timeout = pdMS_TO_TICKS(CLI_ECHO_TIMEOUT);
 
-        switch (received_char)
+        /* A line still incomplete after the hand-off latency is being typed, not pasted: the prompt the batch
+         * owes goes out before its first echo. */
+        if (Batch.prompt_owed && uart_rx_lines_pending() == 0)
         {
-            case BACK_SPACE:
-                cli_tx_byte(BACK_SPACE);
-                received_command[index--] = '\0';
-                break;
-
-            case ENTER:
-                received_command[index] = '\0';
-                cli_print("\r\n");
-                break;
-
-            default:
-                cli_tx_byte(received_char);
-                received_command[index++] = received_char;
-                break;
+            uart_rx_wait(UART_RX_RING_SIZE, uart_rx_latency());
+            if (uart_rx_lines_pending() == 0)
+            {
+                end_batch();
+            }
         }
 
-    } while (received_char != ENTER);
+        /* Consume at most up to the terminator; anything after it belongs to the next command. */
+        size_t count = uart_rx_peek(chunk, sizeof(chunk));
+        const uint8_t *end = memchr(chunk, ENTER, count);
+        if (end != NULL)
+        {
+            count = (size_t) (end - chunk) + 1;
+        }
+        uart_rx_read(chunk, count);
+
+        size_t echo_len = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            switch (chunk[i])
+            {
+                case BACK_SPACE:
+                    if (index > 0)
+                    {
+                        echo[echo_len++] = BACK_SPACE;
+                        received_command[--index] = '\0';
+                    }
+                    break;
+
+                case ENTER:
+                    received_command[index] = '\0';
+                    echo[echo_len++] = '\r';
+                    echo[echo_len++] = '\n';
+                    line_done = 1;
+                    break;
+
+                default:
+                    if (index < MAX_CMD_LEN - 1)
+                    {
+                        echo[echo_len++] = chunk[i];
+                        received_command[index++] = chunk[i];
+                    }
+                    break;
+            }
+        }
+
+        cli_printn(echo, echo_len);
+    }
 
     return received_command;
 }
 
 /* -- List All Registered Commands -- */
-/* Iterates through `Command_Handlers` and prints each command name and description. */
-static inline void list_commands(const char*)
+/* Iterates through the command registry in name order and prints each command name and description. */
+static inline CLI_STATUS list_commands(const CliArgs*)
 {
-    for (uint8_t iter = 0; iter < TOTAL_COMMANDS; ++iter)
+    for (size_t iter = 0; iter < cli_registry_count(); ++iter)
     {
+        const CliStruct *const cmd = cli_registry_at(iter);
+
         cli_printf("%d. %-10s: %s %s\r\n",
-                   iter + 1,
-                   Command_Handlers[iter].command,
-                   Command_Handlers[iter].description,
-                   Command_Handlers[iter].handler == NULL ? "(Not Implemented)" : "");
+                   (int) iter + 1,
+                   cmd->command,
+                   cmd->description,
+                   cmd->handler == NULL ? "(Not Implemented)" : "");
     }
+
+    return CLI_OK;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -171,42 +265,37 @@ static inline void list_commands(const char*)
 /* -------------------------------------------------------------------------- */
 
 /* -- CLI Task -- */
-/* FreeRTOS task that waits for a full command via UART interrupts and then dispatches it to the command handler. */
+/* FreeRTOS task that waits for a full command via UART interrupts and then dispatches it to the command handler.
+ * Lines that arrived while earlier ones ran are executed back to back; the prompt only returns once the input
+ * is drained, so a pasted batch costs the sender a single round trip. */
 void Cli_Task(void *Arguments)
 {
     MX_USART1_UART_Init();
-
-    LL_USART_EnableIT_RXNE(USART1);
-    NVIC_SetPriority(USART1_IRQn, 6);
-    NVIC_EnableIRQ(USART1_IRQn);
+    uart_tx_init();
+    uart_rx_init();
+    assert_param(cli_registry_init() == 0);
+    cli_jobs_init();
+    xTaskNotifyGive(Setting_Task_Handle);   // USART1 is up: the settings task may restore a saved baud rate
 
     while (1)
     {
-        command_handler(get_command_input());
-    }
-}
-
-/* -- Extract Number from String -- */
-/* Scans `src_string` for the first digit sequence, converts it to a long, and returns it.
- * Sets `length` to number of chars consumed. */
-long extract_number_from_string(const char *src_string, size_t *length)
-{
-    long number = __LONG_MAX__;
-    const char *follower = src_string;
-    char *endpointer = NULL;
+        if (cli_proto_mode() == CLI_PROTO_BINARY)
+        {
+            /* Requests are answered in frames from here on; no batch summary and no prompt. */
+            Batch = (CliBatch) { 0 };
+            cli_proto_session();
+            continue;
+        }
 
-    while (*follower != 0)
-    {
-        follower++;
-        if (isdigit((int)*follower))
+        /* The batch ends once no further line is buffered or on its way in. */
+        if (uart_rx_lines_pending() == 0 && uart_rx_wait(1, uart_rx_latency()) == 0)
         {
-            number = strtol(follower, &endpointer, 10);
-            *length = endpointer - src_string;
-            break;
+            end_batch();
         }
-    }
 
-    return number;
+        run_command_line(get_command_input());
+        Batch.prompt_owed = 1;
+    }
 }
 
 /* -- Generate a 32-bit Random Number from RNG Peripheral -- */
@@ -219,165 +308,106 @@ uint32_t random_gen(void)
 }
 
 /* -- Generate Random Data Command -- */
-/* Parses optional range arguments, generates a random value, and prints it. */
-void rand_data(const char *Arguments)
+/* `rand_data` prints a raw 32-bit value, `rand_data <min> <max>` one in [min, max). */
+CLI_STATUS rand_data(const CliArgs *args)
 {
-    long min = 0, max = 1;
-    long random_number = 0;
+    const CliArg *const min = &args->arg[0];
+    const CliArg *const max = &args->arg[1];
+    int64_t random_number = 0;
 
-    if (Arguments != NULL)
+    if (min->present)
     {
-        size_t len = 0;
-        min = extract_number_from_string(Arguments, &len);
-        max = extract_number_from_string(Arguments + len, &len);
-
-        if (min == __LONG_MAX__ || max == __LONG_MAX__)
+        if (!max->present)
         {
-            cli_printf("Unexpected Error %lX %lX\r\n", min, max);
-            return;
+            cli_print("Please provide both min and max\r\n");
+            return CLI_FAILED;
         }
-        else if (min > max)
+        else if (min->value >= max->value)
         {
             cli_print("Why the fuck is min greater than max value\r\n");
-            return;
+            return CLI_FAILED;
         }
 
-        random_number = random_gen() % (max - min) + min;
+        random_number = random_gen() % ((int64_t) max->value - min->value) + min->value;
     }
     else
     {
         random_number = random_gen();
     }
 
-    cli_printf("%ld\r\n", random_number);
+    cli_printf("%lld\r\n", (long long) random_number);
+    return CLI_OK;
 }
 
 /* -- Set Blink Rate Command -- */
-/* Parses color names and blink rate from `Arguments` then sends appropriate settings to `SettingsQueue`. */
-void set_blink_rate(const char *Arguments)
+/* Submits the colour mask and blink rate, both already validated by the schema, to the settings task. Named LEDs
+ * playing a PWM pattern go back to blinking. */
+CLI_STATUS set_blink_rate(const CliArgs *args)
 {
-    uint8_t ColorFlag = 0;
-    size_t ptr_indx = 0;
-    uint32_t blink_rate = 0;
-    const size_t arg_len = strlen(Arguments);
-
-    Settings blink_settings = { .config_id = LED_CONFIG, .Buffer = { 0 } };
-
-    if (isdigit((int)Arguments[1]))
-    {
-        ColorFlag = (1 << BLUE) | (1 << RED) | (1 << ORANGE) | (1 << GREEN);
-        blink_settings.Buffer[0] = ColorFlag;
-    }
-    else
+    const Settings blink_settings =
     {
-        while (ptr_indx < arg_len && !isdigit((int)Arguments[ptr_indx]))
+        .config_id = LED_CONFIG,
+        .led =
         {
-            while (Arguments[ptr_indx] == ' ')
-            {
-                ptr_indx++;
-            }
-
-            const size_t prev_index = ptr_indx;
-
-            for (uint8_t i = 0; i < LED_COUNT; ++i)
-            {
-                if (strncasecmp(Arguments + ptr_indx, COLOR_NAMES[i], strlen(COLOR_NAMES[i])) == 0)
-                {
-                    blink_settings.Buffer[0] |= 1 << i;
-                    ptr_indx += strlen(COLOR_NAMES[i]) + 1;
-                }
-            }
-
-            if (prev_index == ptr_indx)
-            {
-                break;
-            }
-        }
-    }
-
-    blink_rate = strtol(Arguments + ptr_indx, NULL, 10);
-    memcpy(blink_settings.Buffer + sizeof(blink_settings.Buffer[0]), &blink_rate, sizeof(blink_rate));
-
-    for (COLOR color = BLUE; color < LED_COUNT; color++)
-    {
-        if (ColorFlag & (1 << color))
-        {
-            blink_settings.Buffer[0] |= 1 << color;
-        }
-    }
-
-    xQueueSend(SettingsQueue, &blink_settings, portMAX_DELAY);
+            .colour_mask = args->arg[0].present ? (uint8_t) args->arg[0].value
+                                                : BIT(BLUE) | BIT(RED) | BIT(ORANGE) | BIT(GREEN),
+            .pattern     = LED_PATTERN_BLINK,
+            .period_ms   = (uint32_t) args->arg[1].value,
+        },
+    };
+
+    return settings_report(settings_submit(&blink_settings));
 }
 
 
 /* -- CPU Monitor Command -- */
-/* Retrieves runtime stats for each FreeRTOS task and prints CPU usage and free stack.
- * If "continue" is passed, updates in place until ENTER is pressed. */
-void cpu_monitor(const char* arguments)
+/* Prints each task's load over the last interval, the min / average / peak over the kept history and free stack.
+ * With "continue" it prints a fresh table every interval as a background job until killed. */
+CLI_STATUS cpu_monitor(const CliArgs *args)
 {
-    uint8_t command_type = 0;
-    if (arguments == NULL)
-    {
-        cli_print("Please pass arguments\r\n");
-        return;
-    }
+    const uint8_t command_type = (uint8_t) (args->arg[0].value + 1);  // 1: once, 2: continue
 
-    uint8_t index = 0;
-
-    while(arguments[index] == ' ')
+    if (command_type == 2 && cli_proto_mode() != CLI_PROTO_TEXT)
     {
-        index++;
+        cli_print("continue needs the text CLI\r\n");
+        return CLI_FAILED;
     }
 
-    if (strcasecmp(CPU_USAGE_Commands[0], arguments + index) == 0)
-    {
-        command_type = 1;  // once
-    }
-    else if (strcasecmp(CPU_USAGE_Commands[1], arguments + index) == 0)
-    {
-        cli_print("Press Enter to stop\r\n");
-        command_type = 2;  // continue
-    }
-    else
+    if (command_type == 2)
     {
-        cli_print("Invalid argument. Use \"once\" or \"continue\"\r\n");
-        return;
+        cli_print("Refreshing every second, stop with \"kill <id>\"\r\n");
     }
 
-    uint32_t total_run_time = 0;
-    uint8_t  total_tasks = 0;
-    BaseType_t TaskIter = 0;
-
-    char received_char = 0;
-    TaskStatus_t task_status[TOTAL_TASKS_TO_WATCH] = { 0 };
-
-    cli_printf("%-10s | %-6s | %-17s |\r\n", "Task", "CPU%", "Free Stack (words)");
-    cli_print("------------------------------------------------------\r\n");
-
-    cli_print("\033[?25l"); // Hide cursor
+    CpuMonitorTask tasks[CPU_MONITOR_MAX_TASKS];
 
     do
     {
-        total_tasks = uxTaskGetSystemState(task_status, TOTAL_TASKS_TO_WATCH, &total_run_time);
+        const size_t total_tasks = cpu_monitor_snapshot(tasks, CPU_MONITOR_MAX_TASKS);
 
-        for (TaskIter = 0; TaskIter < total_tasks; ++TaskIter)
-        {
-            const float cpu_percentage = (task_status[TaskIter].ulRunTimeCounter * 100.0f) / total_run_time;
-            cli_printf("%-10s | %6.2f | %17d |\r\n",
-                            task_status[TaskIter].pcTaskName,
-                            cpu_percentage,
-                            task_status[TaskIter].usStackHighWaterMark);
-        }
+        /* One block per refresh; echo of what is being typed only lands between blocks. */
+        uart_tx_lock();
+        cli_printf("%-10s | %6s | %6s | %6s | %6s | %-17s |\r\n", "Task", "CPU%", "Min", "Avg", "Peak", "Free Stack (words)");
+        cli_print("-----------------------------------------------------------------------------\r\n");
 
-        if (command_type == 2) // continuous
+        for (size_t i = 0; i < total_tasks; ++i)
         {
-            xQueueReceive(User_Uart_Queue, &received_char, 1000);
-            cli_printf("\033[%dA\033[2K\r", total_tasks); // Move cursor up and clear line
+            /* Hundredths of a percent, printed as fixed point to keep the FPU out of the CLI task. */
+            if (tasks[i].samples == 0)
+            {
+                cli_printf("%-10s | %6s | %6s | %6s | %6s | %17u |\r\n", tasks[i].name, "-", "-", "-", "-",
+                           tasks[i].stack_free);
+                continue;
+            }
+            cli_printf("%-10s | %6.2q | %6.2q | %6.2q | %6.2q | %17u |\r\n", tasks[i].name,
+                       tasks[i].last, tasks[i].min, tasks[i].avg, tasks[i].peak, tasks[i].stack_free);
         }
+        cli_printf("CPU%% over the last %u ms, Min/Avg/Peak over up to %u intervals\r\n\r\n",
+                   CPU_MONITOR_PERIOD_MS, CPU_MONITOR_HISTORY);
+        uart_tx_unlock();
 
-    } while (command_type == 2 && received_char != ENTER);
+    } while (command_type == 2 && !cli_job_sleep(pdMS_TO_TICKS(CPU_MONITOR_PERIOD_MS)));
 
-    cli_print("\033[?25h\r\n"); // Show cursor again
+    return CLI_OK;
 }
 
 static inline uint8_t is_baudrate_valid(const uint32_t BaudRate)
@@ -401,107 +431,272 @@ static inline uint8_t is_baudrate_valid(const uint32_t BaudRate)
     return valid;
 }
 
-void uart_settings(const char* Arguments)
+/* -- UART Statistics -- */
+/* Prints the TX ring counters, the current full-ring policy and the RX interrupt load. */
+static inline void uart_stats(void)
+{
+    UartTxStats stats;
+    UartRxStats rx;
+    uart_tx_get_stats(&stats);
+    uart_rx_get_stats(&rx);
+
+    cli_printf("TX policy    : %s\r\n", uart_tx_get_policy() == UART_TX_BLOCKING ? "block" : "drop");
+    cli_printf("Bytes queued : %lu\r\n", (unsigned long) stats.bytes_queued);
+    cli_printf("Bytes dropped: %lu\r\n", (unsigned long) stats.bytes_dropped);
+    cli_printf("Stalls       : %lu (%lu ticks)\r\n", (unsigned long) stats.stalls, (unsigned long) stats.stall_ticks);
+    cli_printf("DMA transfers: %lu, errors %lu\r\n", (unsigned long) stats.dma_transfers, (unsigned long) stats.dma_errors);
+    cli_printf("RX path      : %s\r\n", UART_RX_USE_DMA ? "DMA + IDLE" : "RXNE per byte");
+    cli_printf("RX bytes     : %lu, dropped %lu, DMA laps %lu\r\n", (unsigned long) rx.bytes, (unsigned long) rx.dropped,
+               (unsigned long) rx.laps);
+    const uint32_t per_irq = rx.interrupts ? (uint32_t) ((uint64_t) rx.bytes * 100U / rx.interrupts) : 0;
+    cli_printf("RX IRQs      : %lu (%.2q bytes/IRQ)\r\n", (unsigned long) rx.interrupts, (int) per_irq);
+    cli_printf("CLI wakeups  : %lu\r\n", (unsigned long) rx.wakeups);
+    cli_printf("RX ISR cycles: %lu avg, %lu max\r\n",
+               (unsigned long) (rx.interrupts ? rx.isr_cycles / rx.interrupts : 0), (unsigned long) rx.isr_cycles_max);
+}
+
+/* -- UART Settings Command -- */
+/* `uart <baud>` changes the baud rate, `uart stats` prints TX counters, `uart txmode block|drop` sets the full-ring policy. */
+CLI_STATUS uart_settings(const CliArgs *args)
 {
-    if(NULL == Arguments)
+    const CliArg *const setting = &args->arg[0];
+    const CliArg *const mode = &args->arg[1];
+
+    switch (setting->keyword)
     {
-        cli_print("Please provide BaudRate\r\n");
-        return;
+        case 1: // stats
+            uart_stats();
+            return CLI_OK;
+
+        case 2: // txmode
+            if (!mode->present)
+            {
+                cli_print("Use \"uart txmode block\" or \"uart txmode drop\"\r\n");
+                return CLI_FAILED;
+            }
+            uart_tx_set_policy(mode->value == 0 ? UART_TX_BLOCKING : UART_TX_NON_BLOCKING);
+            return CLI_OK;
+
+        default:
+            break;
     }
-    char* endptr = NULL;
 
-    uint32_t NewBaudRate = strtol(Arguments, &endptr, 10);
+    const uint32_t NewBaudRate = (uint32_t) setting->value;
 
-    if(0 == NewBaudRate || is_baudrate_valid(NewBaudRate) != 1)
+    if(mode->present || is_baudrate_valid(NewBaudRate) != 1)
     {
         cli_print("Please provide Valid BaudRate\r\n");
-        return;
+        return CLI_FAILED;
     }
 
-    Settings uart_settings = { .config_id = UART_CONFIG};
-    memcpy(&uart_settings.Buffer, &NewBaudRate, sizeof(NewBaudRate ));
+    const Settings uart_settings = { .config_id = UART_CONFIG, .baud_rate = NewBaudRate };
 
-    xQueueSend(SettingsQueue, &uart_settings, portMAX_DELAY);
+    return settings_report(settings_submit(&uart_settings));
 }
 
-/* -- Handle Parsed Command -- */
-/* Compares `user_input` against registered commands and invokes the corresponding handler, passing any arguments. */
-static void command_handler(const char *user_input)
+/* -- Print Command Usage -- */
+/* One line built from the command's schema: <required> [optional], choices joined by '|'. */
+static void print_usage(const CliStruct *cmd)
 {
-    if(*user_input == '\0') // <! User just pressed enter without any input
+    uart_tx_lock();
+    cli_printf("Usage: %s", cmd->command);
+
+    for (uint8_t i = 0; i < cmd->arg_count; ++i)
     {
-        return;
+        const CliArgSpec *const spec = &cmd->args[i];
+
+        cli_print(spec->optional ? " [" : " <");
+        if (spec->type == CLI_ARG_INT || spec->choice_count == 0)
+        {
+            cli_print(spec->name);
+            if (spec->choice_count != 0)
+            {
+                cli_print("|");
+            }
+        }
+        for (uint8_t choice = 0; choice < spec->choice_count; ++choice)
+        {
+            cli_printf("%s%s", choice ? "|" : "", spec->choices[choice]);
+        }
+        cli_print(spec->type == CLI_ARG_COLORS ? "..." : "");
+        cli_print(spec->optional ? "]" : ">");
     }
 
-    uint8_t i = 0;
-    const size_t total = sizeof(Command_Handlers) / sizeof(Command_Handlers[0]);
+    cli_print("\r\n");
+    uart_tx_unlock();
+}
 
-    for (i = 0; i < total; ++i)
+/* -- Report Argument Error -- */
+static void report_arg_error(const CliStruct *cmd, const CliArgs *args, CLI_ARGS_STATUS status, size_t failed)
+{
+    switch (status)
     {
-        const char *cmd = Command_Handlers[i].command;
+        case CLI_ARGS_MISSING:
+            cli_printf("Missing %s\r\n", cmd->args[failed].name);
+            break;
 
-        if (strncasecmp(user_input, cmd, strlen(cmd)) == 0)
-        {
-            if (Command_Handlers[i].handler != NULL)
+        case CLI_ARGS_INVALID:
+            if (cmd->args[failed].type == CLI_ARG_INT)
             {
-                const char *Arguments = (user_input[strlen(cmd)] == '\0') ? NULL : strchr(user_input, ' ');
-                Command_Handlers[i].handler(Arguments);
+                cli_printf("Invalid %s \"%s\" (%ld to %ld)\r\n", cmd->args[failed].name, args->arg[failed].text,
+                           (long) cmd->args[failed].min, (long) cmd->args[failed].max);
             }
             else
             {
-                cli_print("Not handled\r\n");
+                cli_printf("Invalid %s \"%s\"\r\n", cmd->args[failed].name, args->arg[failed].text);
             }
-            return;
-        }
-    }
+            break;
 
-    if (i == total)
-    {
-        cli_printf("%s cmd not found\r\n", user_input);
+        case CLI_ARGS_TOO_MANY:
+            cli_printf("Unexpected \"%s\"\r\n", args->argv[failed]);
+            break;
+
+        default:
+            break;
     }
+
+    print_usage(cmd);
 }
 
-/* -- Formatted Print to CLI -- */
-/* Formats a string using vsprintf and sends it via `cli_print`. Returns number of chars printed. */
-size_t cli_printf(const char *format, ...)
+/* -- Handle Parsed Command -- */
+/* Looks up the command word in the registry, converts the remaining tokens against the command's schema
+ * and only then runs its handler: on a job worker in text mode, inline for CLI_INLINE commands and in
+ * binary mode, where the output is captured into the response. */
+static CLI_STATUS command_handler(CliArgs *args)
 {
-    char print_buffer[100];
-    va_list args;
-    va_start(args, format);
-    size_t len = vsprintf(print_buffer, format, args);
-    va_end(args);
+    size_t failed = 0;
 
-    cli_print(print_buffer);
-    return len;
-}
+    if (args->argc > CLI_MAX_ARGS)
+    {
+        cli_printf("%s: too many arguments\r\n", args->argv[0]);
+        return CLI_FAILED;
+    }
 
-/* -------------------------------------------------------------------------- */
-/*                            UART IRQ Handler                                */
-/* -------------------------------------------------------------------------- */
+    const CliStruct *const cmd = cli_registry_find(args->argv[0], strlen(args->argv[0]));
+
+    if (cmd == NULL)
+    {
+        cli_printf("%s cmd not found\r\n", args->argv[0]);
+        return CLI_FAILED;
+    }
+
+    if (cmd->handler == NULL)
+    {
+        cli_print("Not handled\r\n");
+        return CLI_FAILED;
+    }
+
+    const CLI_ARGS_STATUS status = cli_args_parse(cmd->args, cmd->arg_count, args, &failed);
+
+    if (status != CLI_ARGS_OK)
+    {
+        report_arg_error(cmd, args, status, failed);
+        return CLI_FAILED;
+    }
 
-/* -- USART1 Interrupt Service Routine -- */
-/* Called when a new byte arrives on USART1. Reads the byte and places it into the CLI queue. */
-void USART1_IRQHandler(void)
+    if ((cmd->flags & CLI_INLINE) || cli_proto_mode() != CLI_PROTO_TEXT)
+    {
+        return cmd->handler(args);
+    }
+
+    return cli_job_run(cmd, args);
+}
+
+/* -- Run Command Line -- */
+/* Splits `line` in place at CLI_CMD_SEPARATOR and runs each non-empty command in order. A failing command
+ * does not stop the ones after it; the batch summary reports how many failed. The settings the commands of
+ * one `;` line submit are held and then applied together; one left queued behind busy workers past
+ * CLI_JOB_DETACH_MS submits on its own when it runs. */
+static void run_command_line(char *line)
 {
-    uint8_t received = 0xff;
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    const uint8_t batched = (strchr(line, CLI_CMD_SEPARATOR) != NULL);
+    char *next = line;
 
-    // Check if RXNE (Receive Data Register Not Empty) flag is active
-    // and the RXNE interrupt is enabled
-    if (LL_USART_IsActiveFlag_RXNE(USART1) && LL_USART_IsEnabledIT_RXNE(USART1))
+    if (batched)
     {
-        // Also check for potential error flags (optional but recommended)
-        if (!LL_USART_IsActiveFlag_FE(USART1) &&  // Framing Error
-            !LL_USART_IsActiveFlag_NE(USART1) &&  // Noise Error
-            !LL_USART_IsActiveFlag_ORE(USART1))   // Overrun Error
+        settings_batch_begin();
+    }
+
+    while (next != NULL)
+    {
+        char *const segment = next;
+
+        next = strchr(segment, CLI_CMD_SEPARATOR);
+        if (next != NULL)
         {
-            received = LL_USART_ReceiveData8(USART1);
-            if (User_Uart_Queue != NULL)
-            {
-                xQueueSendFromISR(User_Uart_Queue, &received, &xHigherPriorityTaskWoken);
-            }
+            *next++ = '\0';
         }
+
+        if (cli_tokenize(segment, &Line_Args) == 0) // <! Empty command, e.g. just ENTER or ";;"
+        {
+            continue;
+        }
+
+        if (Batch.commands++ == 0)
+        {
+            Batch.start = xTaskGetTickCount();
+        }
+
+        if (command_handler(&Line_Args) != CLI_OK)
+        {
+            Batch.failed++;
+        }
+    }
+
+    if (batched && settings_report(settings_batch_end()) != CLI_OK)
+    {
+        Batch.failed++;
     }
+}
 
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+/* -- Execute Command Line -- */
+/* One command per call: the binary protocol carries exactly one per request frame. */
+CLI_STATUS cli_execute(char *line)
+{
+    if (cli_tokenize(line, &Line_Args) == 0)
+    {
+        cli_print("Empty command\r\n");
+        return CLI_FAILED;
+    }
+
+    return command_handler(&Line_Args);
+}
+
+/* -- End Command Batch -- */
+/* Called once the input has drained: one status line for the whole batch, then the prompt. */
+static void end_batch(void)
+{
+    if (Batch.commands > 1)
+    {
+        cli_printf("Batch: %lu commands, %lu failed, %lu ms\r\n",
+                   (unsigned long) Batch.commands,
+                   (unsigned long) Batch.failed,
+                   (unsigned long) ((xTaskGetTickCount() - Batch.start) * portTICK_PERIOD_MS));
+    }
+
+    Batch = (CliBatch) { 0 };
+    cli_print("\r>>>> ");
+}
+
+/* -- CLI Format Sink -- */
+/* Feeds each run produced by the formatter straight into the TX ring. */
+static void cli_format_to_uart(void *context, const char *data, size_t len)
+{
+    (void) context;
+    uart_tx_write((const uint8_t*) data, len);
+}
+
+/* -- Formatted Print to CLI -- */
+/* Streams the formatted output into the TX ring as it is produced; no length limit. Returns number of chars printed. */
+size_t cli_printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+
+    uart_tx_lock();
+    const size_t len = cli_vformat(Cli_Output, Cli_Output_Context, format, args);
+    uart_tx_unlock();
+
+    va_end(args);
+    return len;
 }
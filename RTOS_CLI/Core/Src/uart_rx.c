@@ -0,0 +1,388 @@
+/*
+ * uart_rx.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  USART1 receive path. DMA2 Stream2 (channel 4) writes every received byte
+ *  into a circular buffer without CPU involvement. New bytes are moved into
+ *  the CLI input ring when the line goes idle (end of a typed key or a pasted
+ *  burst) or when the DMA reaches the half/end of the buffer, so a burst costs
+ *  one interrupt instead of one per character.
+ *
+ *  The input ring is single-producer (the RX ISRs) / single-consumer (the CLI
+ *  task) with free-running indices, so neither side needs a lock for the data
+ *  itself. The reader is only woken once its trigger level is reached or a
+ *  line terminator arrives.
+ *
+ *  Both IRQs sit at NVIC priority 6, below configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ *  and the same priority so they never preempt each other while walking the
+ *  buffer.
+ */
+
+/* -- STM32 Library -- */
+#include "usart.h"
+#include "stm32f4xx_ll_bus.h"
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_usart.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* -- User Library -- */
+#include "irq_stats.h"
+#include "uart_rx.h"
+
+/* -- Global Variables -- */
+
+#if UART_RX_USE_DMA
+static uint8_t  Rx_Dma_Buffer[UART_RX_DMA_SIZE];
+static uint32_t Rx_Read;    /* First byte not yet handed to the CLI, touched by the RX ISRs only */
+static uint8_t  Rx_Overrun; /* ORE seen and counted, waiting for the DMA's next read of DR to clear it */
+#endif
+
+#define RX_RING_MASK    (UART_RX_RING_SIZE - 1U)
+
+#if (UART_RX_RING_SIZE & RX_RING_MASK) != 0
+#error "UART_RX_RING_SIZE must be a power of two"
+#endif
+
+static uint8_t Rx_Ring[UART_RX_RING_SIZE];
+
+static volatile uint32_t Rx_Head;       /* Advanced by the RX ISRs only */
+static volatile uint32_t Rx_Tail;       /* Advanced by the reader only */
+static volatile uint32_t Rx_Lines;      /* Terminators in the ring: ISR increments, reader decrements */
+static volatile uint32_t Rx_Trigger;    /* Wake level of the blocked reader, 0 when nobody waits */
+static volatile uint8_t  Rx_Terminator = UART_RX_TERMINATOR;
+
+static SemaphoreHandle_t Rx_Ready;
+
+static UartRxStats Rx_Stats;
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Hand Bytes to CLI -- */
+/* Appends `len` received bytes to the input ring and wakes the reader once if its condition is met. */
+static inline void rx_deliver(const uint8_t *data, uint32_t len, BaseType_t *woken)
+{
+    uint32_t head = Rx_Head;
+    const uint32_t space = UART_RX_RING_SIZE - (head - Rx_Tail);
+
+    if (len > space)
+    {
+        Rx_Stats.dropped += len - space;
+        len = space;
+    }
+
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        Rx_Ring[head++ & RX_RING_MASK] = data[i];
+        if (data[i] == Rx_Terminator)
+        {
+            Rx_Lines++;
+        }
+    }
+
+    Rx_Head = head;
+    Rx_Stats.bytes += len;
+
+    const uint32_t trigger = Rx_Trigger;
+    if (trigger != 0 && ((head - Rx_Tail) >= trigger || Rx_Lines != 0))
+    {
+        Rx_Trigger = 0;
+        Rx_Stats.wakeups++;
+        xSemaphoreGiveFromISR(Rx_Ready, woken);
+    }
+}
+
+/* -- ISR Cost Accounting -- */
+static inline void rx_account(const uint32_t start)
+{
+    const uint32_t cycles = DWT->CYCCNT - start;
+
+    Rx_Stats.interrupts++;
+    Rx_Stats.isr_cycles += cycles;
+    if (cycles > Rx_Stats.isr_cycles_max)
+    {
+        Rx_Stats.isr_cycles_max = cycles;
+    }
+}
+
+#if UART_RX_USE_DMA
+/* -- Drain DMA Buffer -- */
+/* Hands over everything between the last read position and the DMA write position, in at most two runs.
+ *
+ * Every HT/TC flag stands for a boundary the DMA crossed since the last drain, so the unread span must cross it
+ * too. A flag set for a boundary the span does not cross means the DMA went all the way round: the span then
+ * holds only what came after the lap, the buffer's worth before it is gone, and reading resumes from the DMA. */
+static inline void rx_drain(BaseType_t *woken)
+{
+    /* Flags first: a boundary crossed after they are read is still inside the span measured below. */
+    const uint8_t ht = LL_DMA_IsActiveFlag_HT2(DMA2);
+    const uint8_t tc = LL_DMA_IsActiveFlag_TC2(DMA2);
+
+    /* NDTR counts down and reloads to the buffer size on wrap, so this is the DMA write index. */
+    const uint32_t write = (UART_RX_DMA_SIZE - LL_DMA_GetDataLength(DMA2, LL_DMA_STREAM_2)) % UART_RX_DMA_SIZE;
+    const uint32_t end = Rx_Read + (write + UART_RX_DMA_SIZE - Rx_Read) % UART_RX_DMA_SIZE;
+    const uint8_t crossed_ht = (Rx_Read < UART_RX_DMA_SIZE / 2U && end >= UART_RX_DMA_SIZE / 2U)
+                               || end >= UART_RX_DMA_SIZE + UART_RX_DMA_SIZE / 2U;
+    const uint8_t crossed_tc = end >= UART_RX_DMA_SIZE;
+
+    if (crossed_ht || ht)
+    {
+        LL_DMA_ClearFlag_HT2(DMA2);
+    }
+    if (crossed_tc || tc)
+    {
+        LL_DMA_ClearFlag_TC2(DMA2);
+    }
+
+    if ((ht && !crossed_ht) || (tc && !crossed_tc))
+    {
+        Rx_Stats.laps++;
+        Rx_Stats.dropped += UART_RX_DMA_SIZE;
+        Rx_Read = write;
+        return;
+    }
+
+    if (write < Rx_Read)
+    {
+        rx_deliver(&Rx_Dma_Buffer[Rx_Read], UART_RX_DMA_SIZE - Rx_Read, woken);
+        Rx_Read = 0;
+    }
+
+    if (write > Rx_Read)
+    {
+        rx_deliver(&Rx_Dma_Buffer[Rx_Read], write - Rx_Read, woken);
+        Rx_Read = write;
+    }
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*                              UART RX Functions                             */
+/* -------------------------------------------------------------------------- */
+
+/* -- UART RX Init -- */
+/* Enables the cycle counter used for ISR accounting, then sets up the selected receive path. */
+void uart_rx_init(void)
+{
+    Rx_Ready = xSemaphoreCreateBinary();
+    assert_param(Rx_Ready != NULL);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if UART_RX_USE_DMA
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+
+    LL_DMA_DisableStream(DMA2, LL_DMA_STREAM_2);
+    while (LL_DMA_IsEnabledStream(DMA2, LL_DMA_STREAM_2))
+        ;
+
+    LL_DMA_SetChannelSelection(DMA2, LL_DMA_STREAM_2, LL_DMA_CHANNEL_4);
+    LL_DMA_ConfigTransfer(DMA2, LL_DMA_STREAM_2,
+                          LL_DMA_DIRECTION_PERIPH_TO_MEMORY |
+                          LL_DMA_MODE_CIRCULAR |
+                          LL_DMA_PERIPH_NOINCREMENT |
+                          LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_BYTE |
+                          LL_DMA_MDATAALIGN_BYTE |
+                          LL_DMA_PRIORITY_MEDIUM);
+    LL_DMA_DisableFifoMode(DMA2, LL_DMA_STREAM_2);
+    LL_DMA_SetPeriphAddress(DMA2, LL_DMA_STREAM_2, LL_USART_DMA_GetRegAddr(USART1));
+    LL_DMA_SetMemoryAddress(DMA2, LL_DMA_STREAM_2, (uintptr_t) Rx_Dma_Buffer);
+    LL_DMA_SetDataLength(DMA2, LL_DMA_STREAM_2, UART_RX_DMA_SIZE);
+    LL_DMA_EnableIT_HT(DMA2, LL_DMA_STREAM_2);
+    LL_DMA_EnableIT_TC(DMA2, LL_DMA_STREAM_2);
+    LL_DMA_EnableStream(DMA2, LL_DMA_STREAM_2);
+
+    LL_USART_EnableDMAReq_RX(USART1);
+    LL_USART_EnableIT_IDLE(USART1);
+
+    NVIC_SetPriority(DMA2_Stream2_IRQn, 6);
+    NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+#else
+    LL_USART_EnableIT_RXNE(USART1);
+#endif
+
+    NVIC_SetPriority(USART1_IRQn, 6);
+    NVIC_EnableIRQ(USART1_IRQn);
+}
+
+/* -- Wait for Input -- */
+/* Publishes the trigger level, re-checks under the ISR lock and sleeps until the ISR gives Rx_Ready. */
+size_t uart_rx_wait(size_t trigger_level, TickType_t timeout)
+{
+    if (trigger_level == 0)
+    {
+        trigger_level = 1;
+    }
+
+    /* Drop a give left over from a wait that already timed out. */
+    xSemaphoreTake(Rx_Ready, 0);
+
+    taskENTER_CRITICAL();
+    const uint8_t ready = (Rx_Head - Rx_Tail) >= trigger_level || Rx_Lines != 0;
+    Rx_Trigger = ready ? 0 : (uint32_t) trigger_level;
+    taskEXIT_CRITICAL();
+
+    if (!ready && xSemaphoreTake(Rx_Ready, timeout) != pdPASS)
+    {
+        Rx_Trigger = 0;
+    }
+
+    return Rx_Head - Rx_Tail;
+}
+
+/* -- Peek Input -- */
+size_t uart_rx_peek(uint8_t *data, size_t len)
+{
+    const uint32_t tail = Rx_Tail;
+    const uint32_t available = Rx_Head - tail;
+
+    if (len > available)
+    {
+        len = available;
+    }
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        data[i] = Rx_Ring[(tail + i) & RX_RING_MASK];
+    }
+
+    return len;
+}
+
+/* -- Read Input -- */
+/* Copies out and then releases the bytes; terminators leave the line count in the same step. */
+size_t uart_rx_read(uint8_t *data, size_t len)
+{
+    uint32_t lines = 0;
+
+    len = uart_rx_peek(data, len);
+    for (size_t i = 0; i < len; ++i)
+    {
+        lines += (data[i] == Rx_Terminator);
+    }
+
+    taskENTER_CRITICAL();
+    Rx_Tail += len;
+    Rx_Lines -= lines;
+    taskEXIT_CRITICAL();
+
+    return len;
+}
+
+uint32_t uart_rx_lines_pending(void)
+{
+    return Rx_Lines;
+}
+
+/* -- Set Terminator -- */
+/* The ISRs count with the new byte from here on; whatever is already buffered is recounted in the same critical section. */
+void uart_rx_set_terminator(uint8_t terminator)
+{
+    taskENTER_CRITICAL();
+    uint32_t lines = 0;
+    for (uint32_t index = Rx_Tail; index != Rx_Head; ++index)
+    {
+        lines += (Rx_Ring[index & RX_RING_MASK] == terminator);
+    }
+    Rx_Terminator = terminator;
+    Rx_Lines = lines;
+    taskEXIT_CRITICAL();
+}
+
+/* -- RX Hand-off Latency -- */
+/* DMA: a steady stream is only handed over at HT/TC, i.e. every half buffer. RXNE: every byte. Plus a tick of slack. */
+TickType_t uart_rx_latency(void)
+{
+    const uint32_t baud_rate = (huart1.Init.BaudRate != 0) ? huart1.Init.BaudRate : 115200U;
+    const uint32_t bytes = UART_RX_USE_DMA ? UART_RX_DMA_SIZE / 2U : 1U;
+
+    return pdMS_TO_TICKS(bytes * 10U * 1000U / baud_rate) + 1U;
+}
+
+void uart_rx_get_stats(UartRxStats *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = Rx_Stats;
+    taskEXIT_CRITICAL();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                            UART IRQ Handlers                               */
+/* -------------------------------------------------------------------------- */
+
+/* -- USART1 Interrupt Service Routine -- */
+/* DMA mode: the line went idle, hand over whatever the DMA has collected. Legacy mode: one byte per entry. */
+void USART1_IRQHandler(void)
+{
+    IRQ_STATS_ENTER(IRQ_STAT_USART1);
+    const uint32_t start = DWT->CYCCNT;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+#if UART_RX_USE_DMA
+    if (LL_USART_IsActiveFlag_IDLE(USART1) && LL_USART_IsEnabledIT_IDLE(USART1))
+    {
+        LL_USART_ClearFlag_IDLE(USART1);
+        rx_drain(&xHigherPriorityTaskWoken);
+    }
+
+    /* ORE clears by reading SR, then DR. Reading DR here could take a byte from under the DMA, so the DMA's own
+     * next read completes the sequence; until then the same overrun is only counted once. */
+    const uint8_t overrun = LL_USART_IsActiveFlag_ORE(USART1);
+    if (overrun && !Rx_Overrun)
+    {
+        Rx_Stats.dropped++;
+    }
+    Rx_Overrun = overrun;
+#else
+    uint8_t received = 0xff;
+
+    if (LL_USART_IsActiveFlag_RXNE(USART1) && LL_USART_IsEnabledIT_RXNE(USART1))
+    {
+        if (!LL_USART_IsActiveFlag_FE(USART1) &&  // Framing Error
+            !LL_USART_IsActiveFlag_NE(USART1) &&  // Noise Error
+            !LL_USART_IsActiveFlag_ORE(USART1))   // Overrun Error
+        {
+            received = LL_USART_ReceiveData8(USART1);
+            rx_deliver(&received, 1, &xHigherPriorityTaskWoken);
+        }
+        else
+        {
+            (void) LL_USART_ReceiveData8(USART1);
+            Rx_Stats.dropped++;
+        }
+    }
+#endif
+
+    rx_account(start);
+    IRQ_STATS_EXIT(IRQ_STAT_USART1);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+#if UART_RX_USE_DMA
+/* -- DMA2 Stream2 Interrupt Service Routine -- */
+/* Half or full buffer reached in the middle of a long burst: hand over what is there so the DMA never laps the reader. */
+void DMA2_Stream2_IRQHandler(void)
+{
+    IRQ_STATS_ENTER(IRQ_STAT_UART_RX_DMA);
+    const uint32_t start = DWT->CYCCNT;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (LL_DMA_IsActiveFlag_HT2(DMA2) || LL_DMA_IsActiveFlag_TC2(DMA2))
+    {
+        rx_drain(&xHigherPriorityTaskWoken);
+    }
+
+    rx_account(start);
+    IRQ_STATS_EXIT(IRQ_STAT_UART_RX_DMA);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
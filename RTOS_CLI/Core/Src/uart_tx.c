@@ -0,0 +1,303 @@
+/*
+ * uart_tx.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  USART1 transmit path. Writers copy into a ring buffer and return; DMA2
+ *  Stream7 (channel 4) drains the ring into USART1->DR one contiguous chunk at
+ *  a time and the transfer-complete interrupt starts the next chunk. The IRQ
+ *  sits at NVIC priority 6, below configMAX_SYSCALL_INTERRUPT_PRIORITY, so it
+ *  may use the FromISR API to wake a writer stalled on a full ring.
+ */
+
+/* -- Standard Library -- */
+#include <string.h>
+
+/* -- STM32 Library -- */
+#include "usart.h"
+#include "stm32f4xx_ll_bus.h"
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_usart.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* -- User Library -- */
+#include "irq_stats.h"
+#include "uart_tx.h"
+
+#define TX_RING_MASK    (UART_TX_RING_SIZE - 1U)
+
+#if (UART_TX_RING_SIZE & TX_RING_MASK) != 0
+#error "UART_TX_RING_SIZE must be a power of two"
+#endif
+
+/* -- Global Variables -- */
+
+static uint8_t Tx_Ring[UART_TX_RING_SIZE];
+
+static volatile uint32_t Tx_Head;       /* Advanced by writers, under Tx_Lock */
+static volatile uint32_t Tx_Tail;       /* Advanced by the DMA ISR */
+static volatile uint32_t Tx_Dma_Len;    /* Bytes in flight, 0 when the stream is idle */
+static volatile uint8_t  Tx_Waiting;    /* A writer is blocked on Tx_Space */
+
+static SemaphoreHandle_t Tx_Lock;       /* Recursive, see uart_tx_lock() */
+static SemaphoreHandle_t Tx_Space;
+
+static UART_TX_POLICY Tx_Policy = UART_TX_BLOCKING;
+static UartTxStats    Tx_Stats;
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Start Next DMA Chunk -- */
+/* Hands the longest contiguous run from the tail to the stream. Caller owns the stream (ISR or critical section). */
+static inline void start_dma(void)
+{
+    const uint32_t pending = Tx_Head - Tx_Tail;
+
+    if (pending == 0)
+    {
+        Tx_Dma_Len = 0;
+        return;
+    }
+
+    const uint32_t offset = Tx_Tail & TX_RING_MASK;
+    const uint32_t chunk = (pending < UART_TX_RING_SIZE - offset) ? pending : UART_TX_RING_SIZE - offset;
+
+    Tx_Dma_Len = chunk;
+
+    LL_DMA_ClearFlag_TC7(DMA2);
+    LL_DMA_ClearFlag_HT7(DMA2);
+    LL_DMA_ClearFlag_TE7(DMA2);
+    LL_DMA_SetMemoryAddress(DMA2, LL_DMA_STREAM_7, (uintptr_t) &Tx_Ring[offset]);
+    LL_DMA_SetDataLength(DMA2, LL_DMA_STREAM_7, chunk);
+    LL_DMA_EnableStream(DMA2, LL_DMA_STREAM_7);
+
+    Tx_Stats.dma_transfers++;
+}
+
+/* -- Polled Fallback -- */
+/* Used before uart_tx_init() has run, e.g. from early error paths. */
+static inline size_t polled_write(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        while (!LL_USART_IsActiveFlag_TXE(USART1))
+            ;
+        LL_USART_TransmitData8(USART1, data[i]);
+    }
+
+    return len;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              UART TX Functions                             */
+/* -------------------------------------------------------------------------- */
+
+/* -- UART TX Init -- */
+/* Sets up DMA2 Stream7 / channel 4 as memory to USART1->DR, byte wide, with TC and TE interrupts. */
+void uart_tx_init(void)
+{
+    Tx_Lock = xSemaphoreCreateRecursiveMutex();
+    Tx_Space = xSemaphoreCreateBinary();
+    assert_param(Tx_Lock != NULL && Tx_Space != NULL);
+
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+
+    LL_DMA_DisableStream(DMA2, LL_DMA_STREAM_7);
+    while (LL_DMA_IsEnabledStream(DMA2, LL_DMA_STREAM_7))
+        ;
+
+    LL_DMA_SetChannelSelection(DMA2, LL_DMA_STREAM_7, LL_DMA_CHANNEL_4);
+    LL_DMA_ConfigTransfer(DMA2, LL_DMA_STREAM_7,
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH |
+                          LL_DMA_MODE_NORMAL |
+                          LL_DMA_PERIPH_NOINCREMENT |
+                          LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_BYTE |
+                          LL_DMA_MDATAALIGN_BYTE |
+                          LL_DMA_PRIORITY_LOW);
+    LL_DMA_DisableFifoMode(DMA2, LL_DMA_STREAM_7);
+    LL_DMA_SetPeriphAddress(DMA2, LL_DMA_STREAM_7, LL_USART_DMA_GetRegAddr(USART1));
+    LL_DMA_EnableIT_TC(DMA2, LL_DMA_STREAM_7);
+    LL_DMA_EnableIT_TE(DMA2, LL_DMA_STREAM_7);
+
+    LL_USART_EnableDMAReq_TX(USART1);
+
+    NVIC_SetPriority(DMA2_Stream7_IRQn, 6);
+    NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+}
+
+/* -- UART TX Write -- */
+/* Copies as much as fits, starts the stream if it is idle, and applies the full-ring policy for the rest. */
+size_t uart_tx_write(const uint8_t *data, size_t len)
+{
+    if (Tx_Lock == NULL)
+    {
+        return polled_write(data, len);
+    }
+
+    size_t written = 0;
+
+    uart_tx_lock();
+
+    while (written < len)
+    {
+        const uint32_t space = UART_TX_RING_SIZE - (Tx_Head - Tx_Tail);
+
+        if (space == 0)
+        {
+            if (Tx_Policy == UART_TX_NON_BLOCKING)
+            {
+                Tx_Stats.bytes_dropped += len - written;
+                break;
+            }
+
+            const TickType_t stall_start = xTaskGetTickCount();
+
+            /* Drop any stale give, then re-check under the same lock the ISR honours. */
+            xSemaphoreTake(Tx_Space, 0);
+            taskENTER_CRITICAL();
+            const uint8_t still_full = (Tx_Head - Tx_Tail) == UART_TX_RING_SIZE;
+            Tx_Waiting = still_full;
+            taskEXIT_CRITICAL();
+
+            if (still_full)
+            {
+                xSemaphoreTake(Tx_Space, portMAX_DELAY);
+            }
+
+            Tx_Stats.stalls++;
+            Tx_Stats.stall_ticks += xTaskGetTickCount() - stall_start;
+            continue;
+        }
+
+        const uint32_t offset = Tx_Head & TX_RING_MASK;
+        size_t chunk = len - written;
+
+        if (chunk > space)
+        {
+            chunk = space;
+        }
+        if (chunk > UART_TX_RING_SIZE - offset)
+        {
+            chunk = UART_TX_RING_SIZE - offset;
+        }
+
+        memcpy(&Tx_Ring[offset], data + written, chunk);
+
+        taskENTER_CRITICAL();
+        Tx_Head += chunk;
+        if (Tx_Dma_Len == 0)
+        {
+            start_dma();
+        }
+        taskEXIT_CRITICAL();
+
+        written += chunk;
+        Tx_Stats.bytes_queued += chunk;
+    }
+
+    uart_tx_unlock();
+
+    return written;
+}
+
+/* -- UART TX Lock -- */
+void uart_tx_lock(void)
+{
+    if (Tx_Lock != NULL)
+    {
+        xSemaphoreTakeRecursive(Tx_Lock, portMAX_DELAY);
+    }
+}
+
+void uart_tx_unlock(void)
+{
+    if (Tx_Lock != NULL)
+    {
+        xSemaphoreGiveRecursive(Tx_Lock);
+    }
+}
+
+/* -- UART TX Flush -- */
+/* Polls once per tick until the ring has drained and USART1 reports transmission complete. */
+BaseType_t uart_tx_flush(TickType_t timeout)
+{
+    const TickType_t start = xTaskGetTickCount();
+
+    while (Tx_Head != Tx_Tail || Tx_Dma_Len != 0 || !LL_USART_IsActiveFlag_TC(USART1))
+    {
+        if (xTaskGetTickCount() - start >= timeout)
+        {
+            return pdFALSE;
+        }
+        vTaskDelay(1);
+    }
+
+    return pdTRUE;
+}
+
+void uart_tx_set_policy(UART_TX_POLICY policy)
+{
+    Tx_Policy = policy;
+}
+
+UART_TX_POLICY uart_tx_get_policy(void)
+{
+    return Tx_Policy;
+}
+
+void uart_tx_get_stats(UartTxStats *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = Tx_Stats;
+    taskEXIT_CRITICAL();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                            DMA IRQ Handler                                 */
+/* -------------------------------------------------------------------------- */
+
+/* -- DMA2 Stream7 Interrupt Service Routine -- */
+/* Retires the finished chunk, chains the next one and wakes a writer waiting for space. */
+void DMA2_Stream7_IRQHandler(void)
+{
+    IRQ_STATS_ENTER(IRQ_STAT_UART_TX_DMA);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8_t finished = 0;
+
+    if (LL_DMA_IsActiveFlag_TE7(DMA2))
+    {
+        /* The stream disables itself on error; the chunk is lost but the ring keeps moving. */
+        LL_DMA_ClearFlag_TE7(DMA2);
+        Tx_Stats.dma_errors++;
+        finished = 1;
+    }
+
+    if (LL_DMA_IsActiveFlag_TC7(DMA2))
+    {
+        LL_DMA_ClearFlag_TC7(DMA2);
+        finished = 1;
+    }
+
+    if (finished && Tx_Dma_Len != 0)
+    {
+        Tx_Tail += Tx_Dma_Len;
+        start_dma();
+
+        if (Tx_Waiting)
+        {
+            Tx_Waiting = 0;
+            xSemaphoreGiveFromISR(Tx_Space, &xHigherPriorityTaskWoken);
+        }
+    }
+
+    IRQ_STATS_EXIT(IRQ_STAT_UART_TX_DMA);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,149 @@
+/*
+ * dsp_bench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host benchmark for the adc_dsp.c kernels against their _ref twins, on
+ *  random 12-bit codes. The SIMD instructions are emulated here, so the
+ *  timings only compare the two C paths on the host; `bench dsp` gives the
+ *  Cortex-M4 figures. That the two paths agree bit for bit is checked by
+ *  Test/adc_dsp_test.c under ctest.
+ */
+
+/* -- Standard Library -- */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* -- User Library -- */
+#include "adc_dsp.h"
+
+#define BENCH_BLOCKS        (20000U)
+#define BENCH_BLOCK_SCANS   (100U)
+#define FFT_RUNS            (200U)
+
+static uint32_t Seed = 1;
+
+static volatile int16_t Bench_Sink;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/* -- Bench Input -- */
+static void make_noise(uint16_t *samples, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Seed = Seed * 1664525U + 1013904223U;
+        samples[i] = (uint16_t) (Seed >> 20);
+    }
+}
+
+/* -- Timing -- */
+/* ns per 100-sample block for each stage of the ADC task's chain, kernel and _ref. */
+static void timing(void)
+{
+    static AdcDcBlock dc;
+    static AdcCic cic;
+    static AdcFir fir;
+    static AdcOversampler os;
+    uint16_t samples[BENCH_BLOCK_SCANS], oversampled[BENCH_BLOCK_SCANS];
+    int16_t q15[BENCH_BLOCK_SCANS], out[BENCH_BLOCK_SCANS];
+    uint64_t ns[6][2] = { { 0 } };
+
+    make_noise(samples, BENCH_BLOCK_SCANS);
+    adc_dsp_to_q15_ref(samples, q15, BENCH_BLOCK_SCANS);
+    adc_dsp_fir_init(&fir, ADC_DSP_LOWPASS);
+    adc_dsp_oversample_init(&os, 2);
+
+    for (uint32_t path = 0; path < 2; ++path)
+    {
+        uint64_t start = now_ns();
+        for (uint32_t block = 0; block < BENCH_BLOCKS; ++block)
+        {
+            (path == 0) ? adc_dsp_to_q15(samples, out, BENCH_BLOCK_SCANS) : adc_dsp_to_q15_ref(samples, out, BENCH_BLOCK_SCANS);
+            Bench_Sink = out[block % BENCH_BLOCK_SCANS];
+        }
+        ns[0][path] = now_ns() - start;
+
+        start = now_ns();
+        for (uint32_t block = 0; block < BENCH_BLOCKS; ++block)
+        {
+            (path == 0) ? adc_dsp_dc_block(&dc, q15, out, BENCH_BLOCK_SCANS) : adc_dsp_dc_block_ref(&dc, q15, out, BENCH_BLOCK_SCANS);
+            Bench_Sink = out[block % BENCH_BLOCK_SCANS];
+        }
+        ns[1][path] = now_ns() - start;
+
+        start = now_ns();
+        for (uint32_t block = 0; block < BENCH_BLOCKS; ++block)
+        {
+            (path == 0) ? adc_dsp_cic(&cic, q15, out, BENCH_BLOCK_SCANS) : adc_dsp_cic_ref(&cic, q15, out, BENCH_BLOCK_SCANS);
+            Bench_Sink = out[block % (BENCH_BLOCK_SCANS / ADC_DSP_DECIMATION)];
+        }
+        ns[2][path] = now_ns() - start;
+
+        start = now_ns();
+        for (uint32_t block = 0; block < BENCH_BLOCKS; ++block)
+        {
+            (path == 0) ? adc_dsp_fir(&fir, q15, out, BENCH_BLOCK_SCANS) : adc_dsp_fir_ref(&fir, q15, out, BENCH_BLOCK_SCANS);
+            Bench_Sink = out[block % BENCH_BLOCK_SCANS];
+        }
+        ns[3][path] = now_ns() - start;
+
+        start = now_ns();
+        for (uint32_t block = 0; block < BENCH_BLOCKS; ++block)
+        {
+            (path == 0) ? adc_dsp_oversample(&os, samples, oversampled, BENCH_BLOCK_SCANS)
+                        : adc_dsp_oversample_ref(&os, samples, oversampled, BENCH_BLOCK_SCANS);
+            Bench_Sink = (int16_t) oversampled[0];
+        }
+        ns[4][path] = now_ns() - start;
+
+        /* Nothing is below code 0: a whole block searched, as while a capture waits. */
+        start = now_ns();
+        for (uint32_t block = 0; block < BENCH_BLOCKS; ++block)
+        {
+            Bench_Sink = (int16_t) ((path == 0) ? adc_dsp_find_trigger(samples, BENCH_BLOCK_SCANS, 0, 0, ADC_TRIGGER_BELOW)
+                                                : adc_dsp_find_trigger_ref(samples, BENCH_BLOCK_SCANS, 0, 0, ADC_TRIGGER_BELOW));
+        }
+        ns[5][path] = now_ns() - start;
+    }
+
+    uint32_t fft_data[ADC_DSP_FFT_SIZE];
+    uint64_t fft_ns[2];
+
+    for (uint32_t path = 0; path < 2; ++path)
+    {
+        const uint64_t start = now_ns();
+        for (uint32_t run = 0; run < FFT_RUNS; ++run)
+        {
+            memset(fft_data, 0, sizeof(fft_data));
+            fft_data[run % ADC_DSP_FFT_SIZE] = 0x4000U;
+            (path == 0) ? adc_dsp_fft(fft_data) : adc_dsp_fft_ref(fft_data);
+            Bench_Sink = (int16_t) fft_data[1];
+        }
+        fft_ns[path] = now_ns() - start;
+    }
+
+    static const char *const stages[] = { "to_q15", "dc_block", "cic", "fir16", "oversmp16", "trigger" };
+
+    printf("%-10s | %12s | %12s\n", "ns/block", "kernel", "ref");
+    for (uint32_t stage = 0; stage < 6; ++stage)
+    {
+        printf("%-10s | %12.1f | %12.1f\n", stages[stage], (double) ns[stage][0] / BENCH_BLOCKS,
+               (double) ns[stage][1] / BENCH_BLOCKS);
+    }
+    printf("%-10s | %12.1f | %12.1f   (ns per 1024-point FFT)\n", "fft1024", (double) fft_ns[0] / FFT_RUNS,
+           (double) fft_ns[1] / FFT_RUNS);
+}
+
+int main(void)
+{
+    timing();
+    return 0;
+}
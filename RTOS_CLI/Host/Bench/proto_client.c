@@ -0,0 +1,570 @@
+/*
+ * proto_client.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host client for the binary CLI protocol (cli_proto.c) and a throughput
+ *  benchmark against the text CLI. Works on the simulator's pseudo-terminal
+ *  and on the board's ST-Link VCP alike.
+ *
+ *      cli_proto_client <tty> <command>...       run commands, print the responses
+ *      cli_proto_client <tty> --bench <count>    text vs binary commands per second
+ *      cli_proto_client <tty> --capture <file>   fetch a finished `capture` into a CSV
+ *      cli_proto_client <tty> --spectrum <file>  fetch the last `adc fft` spectrum into a CSV
+ */
+
+/* -- Standard Library -- */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* -- User Library -- */
+#include "cli_frame.h"
+
+#define CLIENT_TIMEOUT_MS   (3000)
+#define CLIENT_WINDOW       (8U)        /* Binary requests kept in flight */
+#define BENCH_COMMAND       "rand_data 1 100"
+#define TEXT_PROMPT         ">>>> "
+
+/* `capture dump` record header, see adc_capture.c. */
+#define CAPTURE_HEADER      (18U)
+#define CAPTURE_FORMAT      (1U)
+
+/* `adc fft spectrum` record header, see adc_task.c. */
+#define SPECTRUM_HEADER     (12U)
+#define SPECTRUM_FORMAT     (1U)
+
+typedef struct
+{
+    int fd;
+    uint8_t rx[CLI_FRAME_MAX_ENCODED];
+    size_t rx_len;
+    uint8_t overflow;
+    size_t bytes_in;
+    size_t bytes_out;
+} Client;
+
+/* -------------------------------------------------------------------------- */
+/*                              Static Helpers                                */
+/* -------------------------------------------------------------------------- */
+
+static inline double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* -- Open Serial Port -- */
+static int open_port(const char *path)
+{
+    struct termios tio;
+    const int fd = open(path, O_RDWR | O_NOCTTY);
+
+    if (fd < 0 || tcgetattr(fd, &tio) != 0)
+    {
+        fprintf(stderr, "cannot open %s: %s\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    cfmakeraw(&tio);
+    cfsetspeed(&tio, B115200);
+    tcsetattr(fd, TCSANOW, &tio);
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+static void write_all(Client *client, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+
+    while (len > 0)
+    {
+        const ssize_t done = write(client->fd, bytes, len);
+        if (done < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+            fprintf(stderr, "write failed: %s\n", strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+        bytes += done;
+        len -= (size_t) done;
+        client->bytes_out += (size_t) done;
+    }
+}
+
+/* -- Read With Timeout -- */
+/* Returns bytes read; exits when the device stays silent for CLIENT_TIMEOUT_MS. */
+static size_t read_some(Client *client, uint8_t *data, size_t len)
+{
+    struct pollfd pfd = { .fd = client->fd, .events = POLLIN };
+
+    if (poll(&pfd, 1, CLIENT_TIMEOUT_MS) <= 0)
+    {
+        fprintf(stderr, "timeout waiting for the device\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const ssize_t got = read(client->fd, data, len);
+    if (got <= 0)
+    {
+        fprintf(stderr, "read failed: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    client->bytes_in += (size_t) got;
+    return (size_t) got;
+}
+
+/* -- Wait for Text -- */
+/* Reads until `marker` has been seen `count` times; a marker split across reads is still found. */
+static void wait_for_text(Client *client, const char *marker, size_t count)
+{
+    char window[4096];
+    size_t len = 0;
+    const size_t marker_len = strlen(marker);
+
+    while (count > 0)
+    {
+        len += read_some(client, (uint8_t*) window + len, sizeof(window) - 1 - len);
+        window[len] = '\0';
+
+        char *found;
+        char *from = window;
+        while (count > 0 && (found = strstr(from, marker)) != NULL)
+        {
+            count--;
+            from = found + marker_len;
+        }
+
+        /* Keep a tail in case the next marker straddles the boundary. */
+        size_t keep = len - (size_t) (from - window);
+        if (keep > marker_len - 1)
+        {
+            keep = marker_len - 1;
+        }
+        memmove(window, window + len - keep, keep);
+        len = keep;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Binary Protocol                               */
+/* -------------------------------------------------------------------------- */
+
+static void send_request(Client *client, uint16_t id, const char *command)
+{
+    static uint8_t raw[CLI_FRAME_MAX];
+    static uint8_t encoded[CLI_FRAME_MAX_ENCODED];
+
+    const CliFrame request =
+    {
+        .id = id,
+        .type = CLI_FRAME_REQUEST,
+        .payload = (const uint8_t*) command,
+        .payload_len = strlen(command),
+    };
+
+    write_all(client, encoded, cli_frame_pack(&request, raw, encoded));
+}
+
+/* -- Receive Response -- */
+/* Blocks for the next complete frame; `response->payload` stays valid until the next call. */
+static CLI_FRAME_STATUS receive_response(Client *client, CliFrame *response)
+{
+    static uint8_t pending[4096];
+    static size_t pending_len;
+    static size_t pending_at;
+
+    while (1)
+    {
+        while (pending_at < pending_len)
+        {
+            const uint8_t byte = pending[pending_at++];
+
+            if (byte != CLI_FRAME_DELIMITER)
+            {
+                if (client->rx_len < sizeof(client->rx))
+                {
+                    client->rx[client->rx_len++] = byte;
+                }
+                else
+                {
+                    client->overflow = 1;
+                }
+                continue;
+            }
+
+            const size_t len = client->rx_len;
+            const uint8_t overflow = client->overflow;
+            client->rx_len = 0;
+            client->overflow = 0;
+
+            if (len == 0)
+            {
+                continue;
+            }
+
+            return overflow ? CLI_FRAME_MALFORMED : cli_frame_unpack(client->rx, len, response);
+        }
+
+        pending_len = read_some(client, pending, sizeof(pending));
+        pending_at = 0;
+    }
+}
+
+/* -- Enter Binary Mode -- */
+/* Everything before the sync delimiter is the echo of our own command. */
+static void enter_binary(Client *client)
+{
+    uint8_t byte = 0xFF;
+
+    write_all(client, "\rproto binary\r", 14);
+    while (byte != CLI_FRAME_DELIMITER)
+    {
+        read_some(client, &byte, 1);
+    }
+    client->rx_len = 0;
+}
+
+static void leave_binary(Client *client, uint16_t id)
+{
+    CliFrame response;
+
+    send_request(client, id, "proto text");
+    while (receive_response(client, &response) == CLI_FRAME_OK && response.id != id)
+        ;
+}
+
+/* -- Run Commands -- */
+/* All commands are sent up front; responses come back in order, matched by id. */
+static int run_commands(Client *client, char **commands, int count)
+{
+    CliFrame response;
+    int failures = 0;
+
+    enter_binary(client);
+
+    for (int i = 0; i < count; ++i)
+    {
+        send_request(client, (uint16_t) (i + 1), commands[i]);
+    }
+
+    for (int received = 0; received < count; ++received)
+    {
+        const CLI_FRAME_STATUS status = receive_response(client, &response);
+        const uint8_t result = response.status & (uint8_t) ~CLI_FRAME_TRUNCATED;
+
+        if (status != CLI_FRAME_OK)
+        {
+            printf("[frame error %d]\n", status);
+            failures++;
+            continue;
+        }
+
+        printf("[%u] %s%s: %.*s", response.id,
+               result == CLI_FRAME_OK ? "ok" : "failed",
+               (response.status & CLI_FRAME_TRUNCATED) ? " (truncated)" : "",
+               (int) response.payload_len, (const char*) response.payload);
+        if (response.payload_len == 0 || response.payload[response.payload_len - 1] != '\n')
+        {
+            printf("\n");
+        }
+        failures += (result != CLI_FRAME_OK);
+    }
+
+    leave_binary(client, (uint16_t) (count + 1));
+    return failures;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                            Capture and Spectrum                            */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t get_le16(const uint8_t *in)
+{
+    return (uint32_t) in[0] | ((uint32_t) in[1] << 8);
+}
+
+/* -- Fetch Capture -- */
+/* One `capture dump <offset>` per record until the capture is complete; each sample becomes one CSV row with its
+ * time relative to the trigger. */
+static int fetch_capture(Client *client, const char *path)
+{
+    static const char *const triggers[] = { "rising", "falling", "above", "below" };
+    FILE *const csv = fopen(path, "w");
+    uint32_t offset = 0, total = 1, pre = 0, period_us = 0, channel = 0, trigger = 0, level = 0;
+    uint16_t id = 0;
+    int failed = 0;
+
+    if (csv == NULL)
+    {
+        fprintf(stderr, "cannot create %s: %s\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    enter_binary(client);
+    fprintf(csv, "index,time_us,code\n");
+
+    while (offset < total)
+    {
+        char command[32];
+        CliFrame response;
+
+        snprintf(command, sizeof(command), "capture dump %u", offset);
+        send_request(client, ++id, command);
+        if (receive_response(client, &response) != CLI_FRAME_OK || response.id != id)
+        {
+            fprintf(stderr, "bad response frame\n");
+            failed = 1;
+            break;
+        }
+
+        const uint8_t *const record = response.payload;
+
+        if (response.status != CLI_FRAME_OK || response.payload_len < CAPTURE_HEADER || record[0] != CAPTURE_FORMAT)
+        {
+            fprintf(stderr, "%.*s", (int) response.payload_len, (const char*) response.payload);
+            failed = 1;
+            break;
+        }
+
+        channel = record[1];
+        trigger = record[2];
+        period_us = get_le16(&record[4]) | (get_le16(&record[6]) << 16);
+        level = get_le16(&record[8]);
+        pre = get_le16(&record[10]);
+        total = get_le16(&record[12]);
+
+        const uint32_t count = get_le16(&record[16]);
+        const uint8_t *packed = record + CAPTURE_HEADER;
+
+        if (get_le16(&record[14]) != offset || count == 0 || response.payload_len < CAPTURE_HEADER + (count * 3U + 1U) / 2U)
+        {
+            fprintf(stderr, "malformed record at offset %u\n", offset);
+            failed = 1;
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; ++i, ++offset)
+        {
+            uint32_t code;
+
+            if (i + 1 == count && (count & 1U))
+            {
+                code = get_le16(packed) & 0x0FFFU;
+            }
+            else if ((i & 1U) == 0)
+            {
+                code = packed[0] | ((packed[1] & 0x0FU) << 8);
+            }
+            else
+            {
+                code = (packed[1] >> 4) | ((uint32_t) packed[2] << 4);
+                packed += 3;
+            }
+
+            fprintf(csv, "%u,%lld,%u\n", offset, ((long long) offset - pre) * period_us, code);
+        }
+    }
+
+    leave_binary(client, ++id);
+    fclose(csv);
+
+    if (!failed)
+    {
+        printf("IN%u %s at %u: %u samples, %u before the trigger, %u us apart, in %s (%zu B received)\n", channel,
+               (trigger < 4U) ? triggers[trigger] : "?", level, total, pre, period_us, path, client->bytes_in);
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* -- Fetch Spectrum -- */
+/* One `adc fft spectrum <offset>` per record until every bin is in; one CSV row per bin with its frequency. */
+static int fetch_spectrum(Client *client, const char *path)
+{
+    FILE *const csv = fopen(path, "w");
+    uint32_t offset = 0, total = 1, size = 0, period_us = 0, channel = 0;
+    uint16_t id = 0;
+    int failed = 0;
+
+    if (csv == NULL)
+    {
+        fprintf(stderr, "cannot create %s: %s\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    enter_binary(client);
+    fprintf(csv, "bin,hz,magnitude\n");
+
+    while (offset < total)
+    {
+        char command[32];
+        CliFrame response;
+
+        snprintf(command, sizeof(command), "adc fft spectrum %u", offset);
+        send_request(client, ++id, command);
+        if (receive_response(client, &response) != CLI_FRAME_OK || response.id != id)
+        {
+            fprintf(stderr, "bad response frame\n");
+            failed = 1;
+            break;
+        }
+
+        const uint8_t *const record = response.payload;
+
+        if (response.status != CLI_FRAME_OK || response.payload_len < SPECTRUM_HEADER || record[0] != SPECTRUM_FORMAT)
+        {
+            fprintf(stderr, "%.*s", (int) response.payload_len, (const char*) response.payload);
+            failed = 1;
+            break;
+        }
+
+        channel = record[1];
+        size = get_le16(&record[2]);
+        period_us = get_le16(&record[4]) | (get_le16(&record[6]) << 16);
+        total = size / 2U + 1U;
+
+        const uint32_t count = get_le16(&record[10]);
+
+        if (get_le16(&record[8]) != offset || count == 0 || size == 0 || period_us == 0
+            || response.payload_len < SPECTRUM_HEADER + 2U * count)
+        {
+            fprintf(stderr, "malformed record at offset %u\n", offset);
+            failed = 1;
+            break;
+        }
+
+        for (uint32_t i = 0; i < count; ++i, ++offset)
+        {
+            fprintf(csv, "%u,%.3f,%u\n", offset, offset * 1e6 / ((double) size * period_us),
+                    get_le16(&record[SPECTRUM_HEADER + 2U * i]));
+        }
+    }
+
+    leave_binary(client, ++id);
+    fclose(csv);
+
+    if (!failed)
+    {
+        printf("IN%u: %u bins of a %u-point FFT, %.3f Hz apart, in %s (%zu B received)\n", channel, total, size,
+               1e6 / ((double) size * period_us), path, client->bytes_in);
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                Benchmark                                   */
+/* -------------------------------------------------------------------------- */
+
+static void report(const char *name, Client *client, size_t count, double seconds)
+{
+    printf("%-26s: %7.1f cmd/s  %6.2f ms/cmd  %5zu B out  %6zu B in\n", name,
+           (double) count / seconds, seconds * 1000.0 / (double) count, client->bytes_out, client->bytes_in);
+    client->bytes_in = 0;
+    client->bytes_out = 0;
+}
+
+static void bench(Client *client, size_t count)
+{
+    const char line[] = BENCH_COMMAND "\r";
+    double start;
+
+    /* Start from a clean prompt. */
+    write_all(client, "\r", 1);
+    wait_for_text(client, TEXT_PROMPT, 1);
+    client->bytes_in = client->bytes_out = 0;
+
+    /* Text, stop and wait: what a screen-scraping rig does. */
+    start = now_s();
+    for (size_t i = 0; i < count; ++i)
+    {
+        write_all(client, line, sizeof(line) - 1);
+        wait_for_text(client, TEXT_PROMPT, 1);
+    }
+    report("text, wait for prompt", client, count, now_s() - start);
+
+    /* Text, pipelined: one batch, one summary, but no per-command result. */
+    start = now_s();
+    for (size_t i = 0; i < count; ++i)
+    {
+        write_all(client, line, sizeof(line) - 1);
+    }
+    wait_for_text(client, "Batch:", 1);
+    wait_for_text(client, TEXT_PROMPT, 1);
+    report("text, pipelined batch", client, count, now_s() - start);
+
+    /* Binary, CLIENT_WINDOW requests in flight, every response checked. */
+    CliFrame response;
+    size_t sent = 0;
+    size_t errors = 0;
+
+    enter_binary(client);
+    client->bytes_in = client->bytes_out = 0;
+
+    start = now_s();
+    while (sent < count && sent < CLIENT_WINDOW)
+    {
+        send_request(client, (uint16_t) ++sent, BENCH_COMMAND);
+    }
+    for (size_t received = 0; received < count; ++received)
+    {
+        if (receive_response(client, &response) != CLI_FRAME_OK || response.id != (uint16_t) (received + 1)
+            || response.status != CLI_FRAME_OK)
+        {
+            errors++;
+        }
+        if (sent < count)
+        {
+            send_request(client, (uint16_t) ++sent, BENCH_COMMAND);
+        }
+    }
+    report("binary, 8 in flight", client, count, now_s() - start);
+
+    leave_binary(client, (uint16_t) (count + 1));
+    if (errors != 0)
+    {
+        printf("binary responses with errors: %zu\n", errors);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <tty> <command>...\n       %s <tty> --bench <count>\n       %s <tty> --capture <file>\n"
+                "       %s <tty> --spectrum <file>\n", argv[0], argv[0], argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Client client = { .fd = open_port(argv[1]) };
+
+    if (strcmp(argv[2], "--bench") == 0)
+    {
+        const long count = (argc > 3) ? strtol(argv[3], NULL, 10) : 200;
+        bench(&client, (count > 0) ? (size_t) count : 200U);
+        return EXIT_SUCCESS;
+    }
+
+    if (strcmp(argv[2], "--capture") == 0)
+    {
+        return fetch_capture(&client, (argc > 3) ? argv[3] : "capture.csv");
+    }
+
+    if (strcmp(argv[2], "--spectrum") == 0)
+    {
+        return fetch_spectrum(&client, (argc > 3) ? argv[3] : "spectrum.csv");
+    }
+
+    return run_commands(&client, argv + 2, argc - 2) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,133 @@
+/*
+ * registry_bench.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host benchmark for command dispatch with 100+ registered commands. The
+ *  build generates CLI_COMMAND() entries "cmd_1" .. "cmd_128" into the
+ *  registry section; every lookup is timed against the linear
+ *  strncasecmp() prefix scan that command_handler() used before.
+ */
+
+/* -- Standard Library -- */
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+/* -- User Library -- */
+#include "cli_registry.h"
+
+#define BENCH_ROUNDS    (2000U)
+#define BENCH_INPUTS    (CLI_MAX_COMMANDS + 1U)
+
+/* Registered by the generated file. */
+CLI_STATUS bench_handler(const CliArgs *args);
+
+CLI_STATUS bench_handler(const CliArgs *args)
+{
+    (void) args;
+    return CLI_OK;
+}
+
+static volatile uintptr_t Bench_Sink;
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/* -- Old Dispatch -- */
+/* The pre-registry command_handler() loop: first table entry whose name is a prefix of the input wins. */
+static const CliStruct* linear_find(const CliStruct *const *table, size_t count, const char *user_input)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char *cmd = table[i]->command;
+
+        if (strncasecmp(user_input, cmd, strlen(cmd)) == 0)
+        {
+            return table[i];
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    static char inputs[BENCH_INPUTS][32];
+    static const CliStruct *table[CLI_MAX_COMMANDS];
+
+    if (cli_registry_init() != 0)
+    {
+        printf("CLI_MAX_COMMANDS is too small for the generated commands\n");
+        return 1;
+    }
+    const size_t count = cli_registry_count();
+
+    /* Old table in registration order, inputs with arguments attached as typed at the prompt. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        table[i] = cli_registry_at(i);
+    }
+    for (size_t i = count; i > 1; --i)
+    {
+        const size_t j = (i * 2654435761U) % i;
+        const CliStruct *swap = table[i - 1];
+        table[i - 1] = table[j];
+        table[j] = swap;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        snprintf(inputs[i], sizeof(inputs[i]), "%s 12 34", cli_registry_at(i)->command);
+    }
+    snprintf(inputs[count], sizeof(inputs[count]), "no_such_command 1");
+
+    size_t wrong = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char *const input = inputs[i];
+        const CliStruct *const found = cli_registry_find(input, strcspn(input, " "));
+
+        if (found != cli_registry_at(i))
+        {
+            printf("registry lookup failed for \"%s\"\n", input);
+            return 1;
+        }
+        wrong += (linear_find(table, count, input) != found);
+    }
+
+    uint64_t start = now_ns();
+    for (uint32_t round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        for (size_t i = 0; i <= count; ++i)
+        {
+            Bench_Sink += (uintptr_t) linear_find(table, count, inputs[i]);
+        }
+    }
+    const uint64_t linear_ns = now_ns() - start;
+
+    start = now_ns();
+    for (uint32_t round = 0; round < BENCH_ROUNDS; ++round)
+    {
+        for (size_t i = 0; i <= count; ++i)
+        {
+            const char *const input = inputs[i];
+            Bench_Sink += (uintptr_t) cli_registry_find(input, strcspn(input, " "));
+        }
+    }
+    const uint64_t registry_ns = now_ns() - start;
+
+    const double lookups = (double) BENCH_ROUNDS * (double) (count + 1);
+
+    printf("commands registered : %zu\n", count);
+    printf("linear prefix scan  : %7.1f ns/lookup, %zu inputs dispatched to the wrong command\n",
+           (double) linear_ns / lookups, wrong);
+    printf("sorted registry     : %7.1f ns/lookup\n", (double) registry_ns / lookups);
+
+    return 0;
+}
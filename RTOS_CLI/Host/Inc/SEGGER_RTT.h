@@ -0,0 +1,13 @@
+/*
+ * SEGGER_RTT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in: there is no debug probe, RTT output goes nowhere.
+ */
+
+#ifndef HOST_SEGGER_RTT_H_
+#define HOST_SEGGER_RTT_H_
+
+#endif /* HOST_SEGGER_RTT_H_ */
@@ -0,0 +1,28 @@
+/*
+ * SEGGER_SYSVIEW.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in: SystemView recording is unavailable, prints go to stderr.
+ */
+
+#ifndef HOST_SEGGER_SYSVIEW_H_
+#define HOST_SEGGER_SYSVIEW_H_
+
+#include "host_board.h"
+
+static inline void SEGGER_SYSVIEW_Conf(void)
+{
+}
+
+static inline void SEGGER_SYSVIEW_Start(void)
+{
+}
+
+static inline void SEGGER_SYSVIEW_Print(const char *s)
+{
+    host_log("[sysview] %s\n", s);
+}
+
+#endif /* HOST_SEGGER_SYSVIEW_H_ */
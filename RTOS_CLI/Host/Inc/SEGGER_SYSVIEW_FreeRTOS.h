@@ -0,0 +1,16 @@
+/*
+ * SEGGER_SYSVIEW_FreeRTOS.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in: FreeRTOSConfig.h pulls this in for the trace hooks, the
+ *  simulation keeps the kernel's empty defaults.
+ */
+
+#ifndef HOST_SEGGER_SYSVIEW_FREERTOS_H_
+#define HOST_SEGGER_SYSVIEW_FREERTOS_H_
+
+#include "SEGGER_SYSVIEW.h"
+
+#endif /* HOST_SEGGER_SYSVIEW_FREERTOS_H_ */
@@ -0,0 +1,31 @@
+/*
+ * host_board.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Glue between the simulated peripherals and the Linux FreeRTOS port.
+ */
+
+#ifndef HOST_BOARD_H_
+#define HOST_BOARD_H_
+
+#include <stdint.h>
+
+/* Called from the tick signal: raises every pending, enabled peripheral IRQ. */
+void host_irq_service(void);
+
+/* Write a diagnostic line to stderr without going through stdio locks. */
+void host_log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/* Load the settings flash image from RTOS_CLI_FLASH (default rtos_cli_flash.bin); called by HAL_Init(). */
+void host_flash_init(void);
+
+/* Let `operations` more word programs and sector erases through, then fail every one as if power had gone
+ * (a negative count lifts the cut). A word programs whole or not at all; so does a sector erase. */
+void host_flash_power_cut(int32_t operations);
+
+/* Nanoseconds since the simulation started. */
+uint64_t host_time_ns(void);
+
+#endif /* HOST_BOARD_H_ */
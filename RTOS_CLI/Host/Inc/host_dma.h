@@ -0,0 +1,26 @@
+/*
+ * host_dma.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Simulated DMA controller.
+ */
+
+#ifndef HOST_DMA_H_
+#define HOST_DMA_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Advance every enabled stream of `DMAx` and raise its IRQ on half/complete/error. Tick context only. */
+void host_dma_service(DMA_TypeDef *DMAx);
+
+/* Timer update DMA burst into TIMx->DMAR (host_hal.c): writes one DCR burst per update event that has
+ * passed since the last call and returns how many items that consumed. */
+size_t host_tim_dma_burst(TIM_TypeDef *TIMx, const uint8_t *src, size_t items);
+
+/* ADC regular data for a DMA stream (host_adc.c): the conversions of every TIM3 update that has passed
+ * since the last call, up to `items` halfwords. */
+size_t host_adc_dma_read(ADC_TypeDef *ADCx, uint8_t *dst, size_t items);
+
+#endif /* HOST_DMA_H_ */
@@ -0,0 +1,28 @@
+/*
+ * host_uart.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Simulated USART: USART1 is exposed as a pseudo-terminal, other instances
+ *  swallow their output.
+ */
+
+#ifndef HOST_UART_H_
+#define HOST_UART_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Apply a baud rate; the first call for USART1 also opens the pseudo-terminal. */
+void host_uart_configure(USART_TypeDef *USARTx, uint32_t BaudRate);
+
+/* Move received bytes into the data register and run the USART IRQ handler, paced at the baud rate. */
+void host_uart_service(USART_TypeDef *USARTx);
+
+/* DMA side of the TX path: sends what the wire could have carried since the last tick, returns bytes taken. */
+size_t host_uart_dma_tx(USART_TypeDef *USARTx, const uint8_t *data, size_t len);
+
+/* DMA side of the RX path: hands over bytes the wire has delivered, returns bytes written to `data`. */
+size_t host_uart_dma_rx(USART_TypeDef *USARTx, uint8_t *data, size_t len);
+
+#endif /* HOST_UART_H_ */
@@ -0,0 +1,651 @@
+/*
+ * stm32f4xx_hal.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the STM32F4 HAL/CMSIS headers. Only the registers,
+ *  handles and calls the firmware touches are modelled; peripheral instances
+ *  are plain structs backed by the simulator in Host/Src.
+ */
+
+#ifndef HOST_STM32F4XX_HAL_H_
+#define HOST_STM32F4XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*                               Common Types                                 */
+/* -------------------------------------------------------------------------- */
+
+#define __IO volatile
+
+typedef enum
+{
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    DISABLE = 0U,
+    ENABLE  = !DISABLE
+} FunctionalState;
+
+/* The board build defines USE_FULL_ASSERT in stm32f4xx_hal_conf.h, keep the same semantics. */
+#define USE_FULL_ASSERT    1U
+#define assert_param(expr) ((expr) ? (void)0U : assert_failed((uint8_t *)__FILE__, __LINE__))
+void assert_failed(uint8_t *file, uint32_t line);
+
+/* -------------------------------------------------------------------------- */
+/*                                  CMSIS                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef enum
+{
+    ADC_IRQn              = 18,
+    TIM1_UP_TIM10_IRQn    = 25,
+    TIM2_IRQn             = 28,
+    TIM3_IRQn             = 29,
+    TIM4_IRQn             = 30,
+    USART1_IRQn           = 37,
+    USART3_IRQn           = 39,
+    DMA2_Stream0_IRQn     = 56,
+    DMA2_Stream1_IRQn     = 57,
+    DMA2_Stream2_IRQn     = 58,
+    DMA2_Stream3_IRQn     = 59,
+    DMA2_Stream4_IRQn     = 60,
+    DMA2_Stream5_IRQn     = 68,
+    DMA2_Stream6_IRQn     = 69,
+    DMA2_Stream7_IRQn     = 70,
+    HOST_IRQ_COUNT        = 82
+} IRQn_Type;
+
+#define NVIC_PRIORITYGROUP_4    0x00000003U
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn);
+
+void __disable_irq(void);
+void __enable_irq(void);
+
+/* Wait for the next simulated interrupt (the tick signal or a peripheral IRQ raised from it). */
+void __WFI(void);
+#define __DSB()     __sync_synchronize()
+
+/* Cortex-M4 SIMD instructions (cmsis_gcc.h), computed lane by lane with the same wrap and saturation. */
+#define __UNALIGNED_UINT32_READ(addr)       (__extension__ ({ uint32_t v_; memcpy(&v_, (addr), 4); v_; }))
+#define __UNALIGNED_UINT32_WRITE(addr, val) do { const uint32_t v_ = (val); memcpy((addr), &v_, 4); } while (0)
+#define __PKHBT(ARG1, ARG2, ARG3)   ((((uint32_t) (ARG1)) & 0x0000FFFFUL) | ((((uint32_t) (ARG2)) << (ARG3)) & 0xFFFF0000UL))
+
+static inline int32_t __SSAT(int32_t value, uint32_t bits)
+{
+    const int32_t max = (int32_t) ((1UL << (bits - 1U)) - 1U);
+
+    return (value > max) ? max : (value < -max - 1) ? -max - 1 : value;
+}
+
+static inline uint32_t host_simd_lanes(int32_t low, int32_t high)
+{
+    return ((uint32_t) low & 0xFFFFU) | ((uint32_t) high << 16);
+}
+
+static inline uint32_t __SSUB16(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes((int16_t) op1 - (int16_t) op2, (int16_t) (op1 >> 16) - (int16_t) (op2 >> 16));
+}
+
+static inline uint32_t __QADD16(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes(__SSAT((int16_t) op1 + (int16_t) op2, 16),
+                           __SSAT((int16_t) (op1 >> 16) + (int16_t) (op2 >> 16), 16));
+}
+
+static inline uint32_t __QSUB16(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes(__SSAT((int16_t) op1 - (int16_t) op2, 16),
+                           __SSAT((int16_t) (op1 >> 16) - (int16_t) (op2 >> 16), 16));
+}
+
+/* Halving forms: each lane's 17-bit result shifted right by one, so they never overflow. */
+static inline uint32_t __SHADD16(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes(((int16_t) op1 + (int16_t) op2) >> 1, ((int16_t) (op1 >> 16) + (int16_t) (op2 >> 16)) >> 1);
+}
+
+static inline uint32_t __SHSUB16(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes(((int16_t) op1 - (int16_t) op2) >> 1, ((int16_t) (op1 >> 16) - (int16_t) (op2 >> 16)) >> 1);
+}
+
+/* Low: op1.lo - op2.hi, high: op1.hi + op2.lo. */
+static inline uint32_t __SHASX(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes(((int16_t) op1 - (int16_t) (op2 >> 16)) >> 1, ((int16_t) (op1 >> 16) + (int16_t) op2) >> 1);
+}
+
+/* Low: op1.lo + op2.hi, high: op1.hi - op2.lo. */
+static inline uint32_t __SHSAX(uint32_t op1, uint32_t op2)
+{
+    return host_simd_lanes(((int16_t) op1 + (int16_t) (op2 >> 16)) >> 1, ((int16_t) (op1 >> 16) - (int16_t) op2) >> 1);
+}
+
+static inline uint32_t __SMUAD(uint32_t op1, uint32_t op2)
+{
+    return (uint32_t) ((int32_t) (int16_t) op1 * (int16_t) op2 + (int32_t) (int16_t) (op1 >> 16) * (int16_t) (op2 >> 16));
+}
+
+static inline uint32_t __SMUSD(uint32_t op1, uint32_t op2)
+{
+    return (uint32_t) ((int32_t) (int16_t) op1 * (int16_t) op2 - (int32_t) (int16_t) (op1 >> 16) * (int16_t) (op2 >> 16));
+}
+
+static inline uint32_t __SMUADX(uint32_t op1, uint32_t op2)
+{
+    return (uint32_t) ((int32_t) (int16_t) op1 * (int16_t) (op2 >> 16) + (int32_t) (int16_t) (op1 >> 16) * (int16_t) op2);
+}
+
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    const int64_t sum = (int64_t) (int16_t) op1 * (int16_t) op2 + (int64_t) (int16_t) (op1 >> 16) * (int16_t) (op2 >> 16);
+
+    return op3 + (uint32_t) sum;
+}
+
+extern uint32_t SystemCoreClock;
+
+/* -------------------------------------------------------------------------- */
+/*                           Peripheral Registers                             */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+    __IO uint32_t GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t MODER;
+    __IO uint32_t OTYPER;
+    __IO uint32_t OSPEEDR;
+    __IO uint32_t PUPDR;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t LCKR;
+    __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t CR;
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+} RNG_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+    __IO uint32_t BDTR;
+    __IO uint32_t DCR;
+    __IO uint32_t DMAR;
+    __IO uint32_t OR;
+} TIM_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t SR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMPR1;
+    __IO uint32_t SMPR2;
+    __IO uint32_t JOFR1;
+    __IO uint32_t JOFR2;
+    __IO uint32_t JOFR3;
+    __IO uint32_t JOFR4;
+    __IO uint32_t HTR;
+    __IO uint32_t LTR;
+    __IO uint32_t SQR1;
+    __IO uint32_t SQR2;
+    __IO uint32_t SQR3;
+    __IO uint32_t JSQR;
+    __IO uint32_t JDR1;
+    __IO uint32_t JDR2;
+    __IO uint32_t JDR3;
+    __IO uint32_t JDR4;
+    __IO uint32_t DR;
+} ADC_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t CSR;
+    __IO uint32_t CCR;
+    __IO uint32_t CDR;
+} ADC_Common_TypeDef;
+
+/* Address registers are pointer sized so the simulated DMA can reach host memory. */
+typedef struct
+{
+    __IO uint32_t  CR;
+    __IO uint32_t  NDTR;
+    __IO uintptr_t PAR;
+    __IO uintptr_t M0AR;
+    __IO uintptr_t M1AR;
+    __IO uint32_t  FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t LISR;
+    __IO uint32_t HISR;
+    __IO uint32_t LIFCR;
+    __IO uint32_t HIFCR;
+    DMA_Stream_TypeDef Stream[8];
+} DMA_TypeDef;
+
+/* Cortex-M4 debug blocks. Every DWT access goes through host_dwt(), which advances CYCCNT
+ * from the host clock at SystemCoreClock while TRCENA and CYCCNTENA are set. */
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+    __IO uint32_t CPICNT;
+    __IO uint32_t EXCCNT;
+    __IO uint32_t SLEEPCNT;
+    __IO uint32_t LSUCNT;
+    __IO uint32_t FOLDCNT;
+} DWT_Type;
+
+typedef struct
+{
+    __IO uint32_t DHCSR;
+    __IO uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type* host_dwt(void);
+
+/* SysTick and SCB are not simulated: the host port sleeps on the tick signal, and host_dwt() counts on through
+ * that sleep. SysTick reads as stopped, so low_power.c has no sleep to credit, which is right here. */
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __IO uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+    __IO uint32_t CPUID;
+    __IO uint32_t ICSR;
+} SCB_Type;
+
+extern CoreDebug_Type host_core_debug;
+extern SysTick_Type   host_systick;
+extern SCB_Type       host_scb;
+
+#define DWT         (host_dwt())
+#define CoreDebug   (&host_core_debug)
+#define SysTick     (&host_systick)
+#define SCB         (&host_scb)
+
+#define SysTick_CTRL_ENABLE_Msk     (1UL << 0)
+#define SCB_ICSR_PENDSTSET_Msk      (1UL << 26)
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+extern USART_TypeDef host_usart1, host_usart3;
+extern GPIO_TypeDef  host_gpioa, host_gpiob, host_gpiod, host_gpioh;
+extern RNG_TypeDef   host_rng;
+extern TIM_TypeDef   host_tim1, host_tim2, host_tim3, host_tim4;
+extern DMA_TypeDef   host_dma1, host_dma2;
+extern ADC_TypeDef   host_adc1;
+extern ADC_Common_TypeDef host_adc_common;
+
+#define USART1  (&host_usart1)
+#define USART3  (&host_usart3)
+#define GPIOA   (&host_gpioa)
+#define GPIOB   (&host_gpiob)
+#define GPIOD   (&host_gpiod)
+#define GPIOH   (&host_gpioh)
+#define RNG     (&host_rng)
+#define TIM1    (&host_tim1)
+#define TIM2    (&host_tim2)
+#define TIM3    (&host_tim3)
+#define TIM4    (&host_tim4)
+#define DMA1    (&host_dma1)
+#define DMA2    (&host_dma2)
+#define ADC1    (&host_adc1)
+#define ADC123_COMMON   (&host_adc_common)
+
+/* USART status and control bits, as laid out in RM0090. */
+#define USART_SR_PE         (1U << 0)
+#define USART_SR_FE         (1U << 1)
+#define USART_SR_NE         (1U << 2)
+#define USART_SR_ORE        (1U << 3)
+#define USART_SR_IDLE       (1U << 4)
+#define USART_SR_RXNE       (1U << 5)
+#define USART_SR_TC         (1U << 6)
+#define USART_SR_TXE        (1U << 7)
+
+#define USART_CR1_IDLEIE    (1U << 4)
+#define USART_CR1_RXNEIE    (1U << 5)
+#define USART_CR1_TCIE      (1U << 6)
+#define USART_CR1_TXEIE     (1U << 7)
+
+#define USART_CR3_DMAR      (1U << 6)
+#define USART_CR3_DMAT      (1U << 7)
+
+/* DMA stream control bits, as laid out in RM0090. */
+#define DMA_SxCR_EN         (1U << 0)
+#define DMA_SxCR_DMEIE      (1U << 1)
+#define DMA_SxCR_TEIE       (1U << 2)
+#define DMA_SxCR_HTIE       (1U << 3)
+#define DMA_SxCR_TCIE       (1U << 4)
+#define DMA_SxCR_PFCTRL     (1U << 5)
+#define DMA_SxCR_DIR_0      (1U << 6)
+#define DMA_SxCR_DIR        (3U << 6)
+#define DMA_SxCR_CIRC       (1U << 8)
+#define DMA_SxCR_PINC       (1U << 9)
+#define DMA_SxCR_MINC       (1U << 10)
+#define DMA_SxCR_PSIZE      (3U << 11)
+#define DMA_SxCR_MSIZE      (3U << 13)
+#define DMA_SxCR_PL         (3U << 16)
+#define DMA_SxCR_CHSEL_Pos  (25U)
+#define DMA_SxCR_CHSEL      (7U << DMA_SxCR_CHSEL_Pos)
+#define DMA_SxFCR_DMDIS     (1U << 2)
+
+/* -------------------------------------------------------------------------- */
+/*                                   RCC                                      */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    uint32_t PLLState;
+    uint32_t PLLSource;
+    uint32_t PLLM;
+    uint32_t PLLN;
+    uint32_t PLLP;
+    uint32_t PLLQ;
+} RCC_PLLInitTypeDef;
+
+typedef struct
+{
+    uint32_t OscillatorType;
+    uint32_t HSEState;
+    uint32_t LSEState;
+    uint32_t HSIState;
+    uint32_t HSICalibrationValue;
+    uint32_t LSIState;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct
+{
+    uint32_t ClockType;
+    uint32_t SYSCLKSource;
+    uint32_t AHBCLKDivider;
+    uint32_t APB1CLKDivider;
+    uint32_t APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+#define RCC_OSCILLATORTYPE_HSE      0x00000001U
+#define RCC_HSE_ON                  0x00010000U
+#define RCC_PLL_ON                  0x00000002U
+#define RCC_PLLSOURCE_HSE           0x00400000U
+#define RCC_PLLP_DIV2               0x00000002U
+#define RCC_CLOCKTYPE_SYSCLK        0x00000001U
+#define RCC_CLOCKTYPE_HCLK          0x00000002U
+#define RCC_CLOCKTYPE_PCLK1         0x00000004U
+#define RCC_CLOCKTYPE_PCLK2         0x00000008U
+#define RCC_SYSCLKSOURCE_PLLCLK     0x00000002U
+#define RCC_SYSCLK_DIV1             0x00000000U
+#define RCC_HCLK_DIV2               0x00001000U
+#define RCC_HCLK_DIV4               0x00001400U
+#define FLASH_LATENCY_4             0x00000004U
+#define PWR_REGULATOR_VOLTAGE_SCALE1 0x0000C000U
+
+#define __HAL_RCC_PWR_CLK_ENABLE()      do { } while (0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOD_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_USART1_CLK_ENABLE()   do { } while (0)
+#define __HAL_RCC_USART1_CLK_DISABLE()  do { } while (0)
+#define __HAL_RCC_USART3_CLK_ENABLE()   do { } while (0)
+#define __HAL_RCC_USART3_CLK_DISABLE()  do { } while (0)
+#define __HAL_RCC_RNG_CLK_ENABLE()      do { } while (0)
+#define __HAL_RCC_RNG_CLK_DISABLE()     do { } while (0)
+#define __HAL_RCC_TIM2_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_TIM2_CLK_DISABLE()    do { } while (0)
+#define __HAL_RCC_TIM3_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_TIM3_CLK_DISABLE()    do { } while (0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(__REGULATOR__)  do { (void) (__REGULATOR__); } while (0)
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+
+/* -------------------------------------------------------------------------- */
+/*                                   GPIO                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0      ((uint16_t)0x0001)
+#define GPIO_PIN_1      ((uint16_t)0x0002)
+#define GPIO_PIN_2      ((uint16_t)0x0004)
+#define GPIO_PIN_4      ((uint16_t)0x0010)
+#define GPIO_PIN_6      ((uint16_t)0x0040)
+#define GPIO_PIN_10     ((uint16_t)0x0400)
+#define GPIO_PIN_11     ((uint16_t)0x0800)
+#define GPIO_PIN_12     ((uint16_t)0x1000)
+#define GPIO_PIN_13     ((uint16_t)0x2000)
+#define GPIO_PIN_14     ((uint16_t)0x4000)
+#define GPIO_PIN_15     ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT         0x00000000U
+#define GPIO_MODE_OUTPUT_PP     0x00000001U
+#define GPIO_MODE_AF_PP         0x00000002U
+#define GPIO_MODE_ANALOG        0x00000003U
+#define GPIO_NOPULL             0x00000000U
+#define GPIO_SPEED_FREQ_LOW     0x00000000U
+#define GPIO_SPEED_FREQ_VERY_HIGH 0x00000003U
+#define GPIO_AF2_TIM4           0x02U
+#define GPIO_AF7_USART1         0x07U
+#define GPIO_AF7_USART3         0x07U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+/* -------------------------------------------------------------------------- */
+/*                                   UART                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct
+{
+    USART_TypeDef    *Instance;
+    UART_InitTypeDef  Init;
+} UART_HandleTypeDef;
+
+#define UART_WORDLENGTH_8B      0x00000000U
+#define UART_STOPBITS_1         0x00000000U
+#define UART_PARITY_NONE        0x00000000U
+#define UART_MODE_TX_RX         0x0000000CU
+#define UART_HWCONTROL_NONE     0x00000000U
+#define UART_OVERSAMPLING_16    0x00000000U
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+void HAL_UART_MspInit(UART_HandleTypeDef *huart);
+void HAL_UART_MspDeInit(UART_HandleTypeDef *huart);
+
+/* -------------------------------------------------------------------------- */
+/*                                    RNG                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    RNG_TypeDef *Instance;
+} RNG_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_RNG_Init(RNG_HandleTypeDef *hrng);
+void HAL_RNG_MspInit(RNG_HandleTypeDef *hrng);
+void HAL_RNG_MspDeInit(RNG_HandleTypeDef *hrng);
+
+/* -------------------------------------------------------------------------- */
+/*                                    TIM                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+    TIM_TypeDef          *Instance;
+    TIM_Base_InitTypeDef  Init;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t ClockSource;
+    uint32_t ClockPolarity;
+    uint32_t ClockPrescaler;
+    uint32_t ClockFilter;
+} TIM_ClockConfigTypeDef;
+
+typedef struct
+{
+    uint32_t MasterOutputTrigger;
+    uint32_t MasterSlaveMode;
+} TIM_MasterConfigTypeDef;
+
+#define TIM_COUNTERMODE_UP              0x00000000U
+#define TIM_CLOCKDIVISION_DIV1          0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE  0x00000000U
+#define TIM_CLOCKSOURCE_INTERNAL        0x00001000U
+#define TIM_TRGO_RESET                  0x00000000U
+#define TIM_TRGO_UPDATE                 0x00000020U
+#define TIM_MASTERSLAVEMODE_DISABLE     0x00000000U
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig);
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim);
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim);
+void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+/* -------------------------------------------------------------------------- */
+/*                                   FLASH                                    */
+/* -------------------------------------------------------------------------- */
+
+/* Only sectors 1 and 2 exist on the host: the settings store (host_flash.c). */
+typedef struct
+{
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t Sector;
+    uint32_t NbSectors;
+    uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+#define FLASH_TYPEERASE_SECTORS         0x00000000U
+#define FLASH_TYPEPROGRAM_WORD          0x00000002U
+#define FLASH_VOLTAGE_RANGE_3           0x00000002U
+#define FLASH_SECTOR_1                  1U
+#define FLASH_SECTOR_2                  2U
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uintptr_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+
+/* -------------------------------------------------------------------------- */
+/*                                   Core                                     */
+/* -------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_Init(void);
+void HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+extern volatile uint32_t uwTick;
+void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32F4XX_HAL_H_ */
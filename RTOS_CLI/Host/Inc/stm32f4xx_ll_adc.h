@@ -0,0 +1,147 @@
+/*
+ * stm32f4xx_ll_adc.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the ADC LL driver: the regular group calls adc_task.c
+ *  uses. Register bits match RM0090, except that ranks and channels are
+ *  plain indices. Conversions are produced by host_adc.c on TIM3 updates.
+ */
+
+#ifndef HOST_STM32F4XX_LL_ADC_H_
+#define HOST_STM32F4XX_LL_ADC_H_
+
+#include "stm32f4xx_hal.h"
+
+#define ADC_SR_OVR              (1U << 5)
+#define ADC_CR1_SCAN            (1U << 8)
+#define ADC_CR1_RES             (3U << 24)
+#define ADC_CR1_OVRIE           (1U << 26)
+#define ADC_CR2_ADON            (1U << 0)
+#define ADC_CR2_DMA             (1U << 8)
+#define ADC_CR2_DDS             (1U << 9)
+#define ADC_CR2_ALIGN           (1U << 11)
+#define ADC_CR2_EXTSEL          (0xFU << 24)
+#define ADC_CR2_EXTEN           (3U << 28)
+#define ADC_SQR1_L_Pos          (20U)
+#define ADC_SQR1_L              (0xFU << ADC_SQR1_L_Pos)
+#define ADC_CCR_ADCPRE          (3U << 16)
+
+#define __LL_ADC_COMMON_INSTANCE(__ADCx__)  (ADC123_COMMON)
+
+#define LL_ADC_CLOCK_SYNC_PCLK_DIV2         (0U)
+#define LL_ADC_RESOLUTION_12B               (0U)
+#define LL_ADC_DATA_ALIGN_RIGHT             (0U)
+#define LL_ADC_SEQ_SCAN_ENABLE              ADC_CR1_SCAN
+
+#define LL_ADC_REG_TRIG_EXT_TIM3_TRGO       (8U << 24)
+#define LL_ADC_REG_TRIG_EXT_RISING          (1U << 28)
+#define LL_ADC_REG_DMA_TRANSFER_UNLIMITED   (ADC_CR2_DDS | ADC_CR2_DMA)
+#define LL_ADC_REG_SEQ_SCAN_ENABLE_3RANKS   (2U << ADC_SQR1_L_Pos)
+
+#define LL_ADC_REG_RANK_1       (0U)
+#define LL_ADC_REG_RANK_2       (1U)
+#define LL_ADC_REG_RANK_3       (2U)
+
+#define LL_ADC_CHANNEL_0        (0U)
+#define LL_ADC_CHANNEL_1        (1U)
+#define LL_ADC_CHANNEL_2        (2U)
+
+#define LL_ADC_SAMPLINGTIME_84CYCLES        (4U)
+
+#define LL_ADC_DMA_REG_REGULAR_DATA         (0U)
+
+static inline void LL_ADC_SetCommonClock(ADC_Common_TypeDef *ADCxy_COMMON, uint32_t CommonClock)
+{
+    ADCxy_COMMON->CCR = (ADCxy_COMMON->CCR & ~ADC_CCR_ADCPRE) | CommonClock;
+}
+
+static inline void LL_ADC_SetResolution(ADC_TypeDef *ADCx, uint32_t Resolution)
+{
+    ADCx->CR1 = (ADCx->CR1 & ~ADC_CR1_RES) | Resolution;
+}
+
+static inline void LL_ADC_SetDataAlignment(ADC_TypeDef *ADCx, uint32_t DataAlignment)
+{
+    ADCx->CR2 = (ADCx->CR2 & ~ADC_CR2_ALIGN) | DataAlignment;
+}
+
+static inline void LL_ADC_SetSequencersScanMode(ADC_TypeDef *ADCx, uint32_t ScanMode)
+{
+    ADCx->CR1 = (ADCx->CR1 & ~ADC_CR1_SCAN) | ScanMode;
+}
+
+static inline void LL_ADC_REG_SetTriggerSource(ADC_TypeDef *ADCx, uint32_t TriggerSource)
+{
+    ADCx->CR2 = (ADCx->CR2 & ~ADC_CR2_EXTSEL) | (TriggerSource & ADC_CR2_EXTSEL);
+}
+
+static inline void LL_ADC_REG_StartConversionExtTrig(ADC_TypeDef *ADCx, uint32_t ExternalTriggerEdge)
+{
+    ADCx->CR2 |= ExternalTriggerEdge;
+}
+
+static inline void LL_ADC_REG_StopConversionExtTrig(ADC_TypeDef *ADCx)
+{
+    ADCx->CR2 &= ~ADC_CR2_EXTEN;
+}
+
+static inline void LL_ADC_REG_SetSequencerLength(ADC_TypeDef *ADCx, uint32_t SequencerNbRanks)
+{
+    ADCx->SQR1 = (ADCx->SQR1 & ~ADC_SQR1_L) | SequencerNbRanks;
+}
+
+/* Ranks 1..6 live in SQR3, five bits each. */
+static inline void LL_ADC_REG_SetSequencerRanks(ADC_TypeDef *ADCx, uint32_t Rank, uint32_t Channel)
+{
+    const uint32_t shift = Rank * 5U;
+
+    ADCx->SQR3 = (ADCx->SQR3 & ~(0x1FU << shift)) | (Channel << shift);
+}
+
+/* Channels 0..9 live in SMPR2, three bits each. */
+static inline void LL_ADC_SetChannelSamplingTime(ADC_TypeDef *ADCx, uint32_t Channel, uint32_t SamplingTime)
+{
+    const uint32_t shift = Channel * 3U;
+
+    ADCx->SMPR2 = (ADCx->SMPR2 & ~(7U << shift)) | (SamplingTime << shift);
+}
+
+static inline void LL_ADC_REG_SetDMATransfer(ADC_TypeDef *ADCx, uint32_t DMATransfer)
+{
+    ADCx->CR2 = (ADCx->CR2 & ~(ADC_CR2_DDS | ADC_CR2_DMA)) | DMATransfer;
+}
+
+static inline uintptr_t LL_ADC_DMA_GetRegAddr(ADC_TypeDef *ADCx, uint32_t Register)
+{
+    (void) Register;
+    return (uintptr_t) &ADCx->DR;
+}
+
+static inline void LL_ADC_Enable(ADC_TypeDef *ADCx)
+{
+    ADCx->CR2 |= ADC_CR2_ADON;
+}
+
+static inline void LL_ADC_Disable(ADC_TypeDef *ADCx)
+{
+    ADCx->CR2 &= ~ADC_CR2_ADON;
+}
+
+static inline void LL_ADC_EnableIT_OVR(ADC_TypeDef *ADCx)
+{
+    ADCx->CR1 |= ADC_CR1_OVRIE;
+}
+
+static inline uint32_t LL_ADC_IsActiveFlag_OVR(ADC_TypeDef *ADCx)
+{
+    return (ADCx->SR & ADC_SR_OVR) != 0;
+}
+
+static inline void LL_ADC_ClearFlag_OVR(ADC_TypeDef *ADCx)
+{
+    ADCx->SR &= ~ADC_SR_OVR;
+}
+
+#endif /* HOST_STM32F4XX_LL_ADC_H_ */
@@ -0,0 +1,37 @@
+/*
+ * stm32f4xx_ll_bus.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the bus clock LL driver: every clock is always running.
+ */
+
+#ifndef HOST_STM32F4XX_LL_BUS_H_
+#define HOST_STM32F4XX_LL_BUS_H_
+
+#include "stm32f4xx_hal.h"
+
+#define LL_AHB1_GRP1_PERIPH_GPIOA   0x00000001U
+#define LL_AHB1_GRP1_PERIPH_DMA1    0x00200000U
+#define LL_AHB1_GRP1_PERIPH_DMA2    0x00400000U
+#define LL_APB1_GRP1_PERIPH_TIM3    0x00000002U
+#define LL_APB1_GRP1_PERIPH_TIM4    0x00000004U
+#define LL_APB2_GRP1_PERIPH_ADC1    0x00000100U
+
+static inline void LL_AHB1_GRP1_EnableClock(uint32_t Periphs)
+{
+    (void) Periphs;
+}
+
+static inline void LL_APB1_GRP1_EnableClock(uint32_t Periphs)
+{
+    (void) Periphs;
+}
+
+static inline void LL_APB2_GRP1_EnableClock(uint32_t Periphs)
+{
+    (void) Periphs;
+}
+
+#endif /* HOST_STM32F4XX_LL_BUS_H_ */
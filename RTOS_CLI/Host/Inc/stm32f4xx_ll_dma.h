@@ -0,0 +1,175 @@
+/*
+ * stm32f4xx_ll_dma.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the DMA LL driver. Register bits match RM0090; the
+ *  transfers themselves are carried out by host_dma.c from the tick.
+ */
+
+#ifndef HOST_STM32F4XX_LL_DMA_H_
+#define HOST_STM32F4XX_LL_DMA_H_
+
+#include "stm32f4xx_hal.h"
+
+#define LL_DMA_STREAM_0     0x00000000U
+#define LL_DMA_STREAM_1     0x00000001U
+#define LL_DMA_STREAM_2     0x00000002U
+#define LL_DMA_STREAM_3     0x00000003U
+#define LL_DMA_STREAM_4     0x00000004U
+#define LL_DMA_STREAM_5     0x00000005U
+#define LL_DMA_STREAM_6     0x00000006U
+#define LL_DMA_STREAM_7     0x00000007U
+
+#define LL_DMA_CHANNEL_0    (0U << DMA_SxCR_CHSEL_Pos)
+#define LL_DMA_CHANNEL_2    (2U << DMA_SxCR_CHSEL_Pos)
+#define LL_DMA_CHANNEL_3    (3U << DMA_SxCR_CHSEL_Pos)
+#define LL_DMA_CHANNEL_4    (4U << DMA_SxCR_CHSEL_Pos)
+
+#define LL_DMA_DIRECTION_PERIPH_TO_MEMORY   0x00000000U
+#define LL_DMA_DIRECTION_MEMORY_TO_PERIPH   DMA_SxCR_DIR_0
+#define LL_DMA_MODE_NORMAL                  0x00000000U
+#define LL_DMA_MODE_CIRCULAR                DMA_SxCR_CIRC
+#define LL_DMA_PERIPH_NOINCREMENT           0x00000000U
+#define LL_DMA_MEMORY_INCREMENT             DMA_SxCR_MINC
+#define LL_DMA_PDATAALIGN_BYTE              0x00000000U
+#define LL_DMA_PDATAALIGN_HALFWORD          (1U << 11)
+#define LL_DMA_MDATAALIGN_BYTE              0x00000000U
+#define LL_DMA_MDATAALIGN_HALFWORD          (1U << 13)
+#define LL_DMA_PRIORITY_LOW                 0x00000000U
+#define LL_DMA_PRIORITY_MEDIUM              (1U << 16)
+#define LL_DMA_PRIORITY_HIGH                (2U << 16)
+
+/* Implemented by host_dma.c: latches the transfer length like the hardware does on EN. */
+void host_dma_enable(DMA_TypeDef *DMAx, uint32_t Stream);
+
+static inline void LL_DMA_EnableStream(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    host_dma_enable(DMAx, Stream);
+}
+
+static inline void LL_DMA_DisableStream(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    DMAx->Stream[Stream].CR &= ~DMA_SxCR_EN;
+}
+
+static inline uint32_t LL_DMA_IsEnabledStream(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    return (DMAx->Stream[Stream].CR & DMA_SxCR_EN) == DMA_SxCR_EN;
+}
+
+static inline void LL_DMA_ConfigTransfer(DMA_TypeDef *DMAx, uint32_t Stream, uint32_t Configuration)
+{
+    const uint32_t mask = DMA_SxCR_DIR | DMA_SxCR_CIRC | DMA_SxCR_PINC | DMA_SxCR_MINC
+                        | DMA_SxCR_PSIZE | DMA_SxCR_MSIZE | DMA_SxCR_PL | DMA_SxCR_PFCTRL;
+    DMAx->Stream[Stream].CR = (DMAx->Stream[Stream].CR & ~mask) | Configuration;
+}
+
+static inline void LL_DMA_SetChannelSelection(DMA_TypeDef *DMAx, uint32_t Stream, uint32_t Channel)
+{
+    DMAx->Stream[Stream].CR = (DMAx->Stream[Stream].CR & ~DMA_SxCR_CHSEL) | Channel;
+}
+
+static inline void LL_DMA_SetMode(DMA_TypeDef *DMAx, uint32_t Stream, uint32_t Mode)
+{
+    DMAx->Stream[Stream].CR = (DMAx->Stream[Stream].CR & ~DMA_SxCR_CIRC) | Mode;
+}
+
+static inline void LL_DMA_DisableFifoMode(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    DMAx->Stream[Stream].FCR &= ~DMA_SxFCR_DMDIS;
+}
+
+static inline void LL_DMA_SetDataLength(DMA_TypeDef *DMAx, uint32_t Stream, uint32_t NbData)
+{
+    DMAx->Stream[Stream].NDTR = NbData;
+}
+
+static inline uint32_t LL_DMA_GetDataLength(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    return DMAx->Stream[Stream].NDTR;
+}
+
+static inline void LL_DMA_SetMemoryAddress(DMA_TypeDef *DMAx, uint32_t Stream, uintptr_t MemoryAddress)
+{
+    DMAx->Stream[Stream].M0AR = MemoryAddress;
+}
+
+static inline void LL_DMA_SetPeriphAddress(DMA_TypeDef *DMAx, uint32_t Stream, uintptr_t PeriphAddress)
+{
+    DMAx->Stream[Stream].PAR = PeriphAddress;
+}
+
+static inline void LL_DMA_EnableIT_TC(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    DMAx->Stream[Stream].CR |= DMA_SxCR_TCIE;
+}
+
+static inline void LL_DMA_EnableIT_HT(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    DMAx->Stream[Stream].CR |= DMA_SxCR_HTIE;
+}
+
+static inline void LL_DMA_EnableIT_TE(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    DMAx->Stream[Stream].CR |= DMA_SxCR_TEIE;
+}
+
+/* Per-stream flag accessors, generated the way the LL header spells them out by hand. */
+#define HOST_LL_DMA_FLAG(NAME, N, BIT)                                            \
+    static inline uint32_t LL_DMA_IsActiveFlag_##NAME##N(DMA_TypeDef *DMAx)       \
+    {                                                                             \
+        return (host_dma_isr(DMAx, N) & (BIT)) != 0U;                             \
+    }                                                                             \
+    static inline void LL_DMA_ClearFlag_##NAME##N(DMA_TypeDef *DMAx)              \
+    {                                                                             \
+        host_dma_clear(DMAx, N, BIT);                                             \
+    }
+
+#define HOST_LL_DMA_STREAM_FLAGS(N)             \
+    HOST_LL_DMA_FLAG(TC, N, DMA_FLAG_TC)        \
+    HOST_LL_DMA_FLAG(HT, N, DMA_FLAG_HT)        \
+    HOST_LL_DMA_FLAG(TE, N, DMA_FLAG_TE)
+
+/* Stream flags as seen in LISR/HISR after shifting the stream's field down to bit 0. */
+#define DMA_FLAG_FE     (1U << 0)
+#define DMA_FLAG_DME    (1U << 2)
+#define DMA_FLAG_TE     (1U << 3)
+#define DMA_FLAG_HT     (1U << 4)
+#define DMA_FLAG_TC     (1U << 5)
+
+static inline uint32_t host_dma_flag_shift(uint32_t Stream)
+{
+    static const uint8_t shift[4] = { 0, 6, 16, 22 };
+    return shift[Stream & 3U];
+}
+
+static inline uint32_t host_dma_isr(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    const uint32_t isr = (Stream < 4U) ? DMAx->LISR : DMAx->HISR;
+    return (isr >> host_dma_flag_shift(Stream)) & 0x3DU;
+}
+
+static inline void host_dma_clear(DMA_TypeDef *DMAx, uint32_t Stream, uint32_t Flags)
+{
+    if (Stream < 4U)
+    {
+        DMAx->LISR &= ~(Flags << host_dma_flag_shift(Stream));
+    }
+    else
+    {
+        DMAx->HISR &= ~(Flags << host_dma_flag_shift(Stream));
+    }
+}
+
+HOST_LL_DMA_STREAM_FLAGS(0)
+HOST_LL_DMA_STREAM_FLAGS(1)
+HOST_LL_DMA_STREAM_FLAGS(2)
+HOST_LL_DMA_STREAM_FLAGS(3)
+HOST_LL_DMA_STREAM_FLAGS(4)
+HOST_LL_DMA_STREAM_FLAGS(5)
+HOST_LL_DMA_STREAM_FLAGS(6)
+HOST_LL_DMA_STREAM_FLAGS(7)
+
+#endif /* HOST_STM32F4XX_LL_DMA_H_ */
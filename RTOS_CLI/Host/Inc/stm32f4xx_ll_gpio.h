@@ -0,0 +1,63 @@
+/*
+ * stm32f4xx_ll_gpio.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the GPIO LL driver, operating on the simulated ODR.
+ */
+
+#ifndef HOST_STM32F4XX_LL_GPIO_H_
+#define HOST_STM32F4XX_LL_GPIO_H_
+
+#include "stm32f4xx_hal.h"
+
+#define LL_GPIO_MODE_INPUT      0x00000000U
+#define LL_GPIO_MODE_OUTPUT     0x00000001U
+#define LL_GPIO_MODE_ALTERNATE  0x00000002U
+#define LL_GPIO_MODE_ANALOG     0x00000003U
+#define LL_GPIO_AF_2            0x00000002U
+
+#define LL_GPIO_PIN_0           GPIO_PIN_0
+#define LL_GPIO_PIN_1           GPIO_PIN_1
+#define LL_GPIO_PIN_2           GPIO_PIN_2
+
+static inline void LL_GPIO_SetPinMode(GPIO_TypeDef *GPIOx, uint32_t Pin, uint32_t Mode)
+{
+    const uint32_t shift = (uint32_t) __builtin_ctz(Pin) * 2U;
+    GPIOx->MODER = (GPIOx->MODER & ~(3U << shift)) | (Mode << shift);
+}
+
+static inline uint32_t LL_GPIO_GetPinMode(GPIO_TypeDef *GPIOx, uint32_t Pin)
+{
+    return (GPIOx->MODER >> ((uint32_t) __builtin_ctz(Pin) * 2U)) & 3U;
+}
+
+/* Pin is one of GPIO_PIN_8 .. GPIO_PIN_15. */
+static inline void LL_GPIO_SetAFPin_8_15(GPIO_TypeDef *GPIOx, uint32_t Pin, uint32_t Alternate)
+{
+    const uint32_t shift = ((uint32_t) __builtin_ctz(Pin) - 8U) * 4U;
+    GPIOx->AFR[1] = (GPIOx->AFR[1] & ~(0xFU << shift)) | (Alternate << shift);
+}
+
+static inline void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    GPIOx->ODR |= PinMask;
+}
+
+static inline void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    GPIOx->ODR &= ~PinMask;
+}
+
+static inline void LL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    GPIOx->ODR ^= PinMask;
+}
+
+static inline uint32_t LL_GPIO_IsOutputPinSet(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    return (GPIOx->ODR & PinMask) == PinMask;
+}
+
+#endif /* HOST_STM32F4XX_LL_GPIO_H_ */
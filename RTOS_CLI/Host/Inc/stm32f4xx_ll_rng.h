@@ -0,0 +1,29 @@
+/*
+ * stm32f4xx_ll_rng.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the RNG LL driver.
+ */
+
+#ifndef HOST_STM32F4XX_LL_RNG_H_
+#define HOST_STM32F4XX_LL_RNG_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Implemented by host_hal.c */
+uint32_t host_rng_read(RNG_TypeDef *RNGx);
+
+static inline uint32_t LL_RNG_IsActiveFlag_DRDY(RNG_TypeDef *RNGx)
+{
+    (void) RNGx;
+    return 1U;
+}
+
+static inline uint32_t LL_RNG_ReadRandData32(RNG_TypeDef *RNGx)
+{
+    return host_rng_read(RNGx);
+}
+
+#endif /* HOST_STM32F4XX_LL_RNG_H_ */
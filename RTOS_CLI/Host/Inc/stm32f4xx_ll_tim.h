@@ -0,0 +1,164 @@
+/*
+ * stm32f4xx_ll_tim.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the TIM LL driver: the output compare and DMA burst
+ *  calls the LED PWM engine uses, and TRGO for the ADC. Register bits match RM0090; update events
+ *  and the DMA bursts they trigger are modelled by host_hal.c.
+ */
+
+#ifndef HOST_STM32F4XX_LL_TIM_H_
+#define HOST_STM32F4XX_LL_TIM_H_
+
+#include "stm32f4xx_hal.h"
+
+#define TIM_CR1_CEN         (1U << 0)
+#define TIM_CR1_ARPE        (1U << 7)
+#define TIM_CR2_MMS         (7U << 4)
+#define TIM_DIER_UDE        (1U << 8)
+#define TIM_EGR_UG          (1U << 0)
+#define TIM_DCR_DBA         (0x1FU << 0)
+#define TIM_DCR_DBL_Pos     (8U)
+#define TIM_DCR_DBL         (0x1FU << TIM_DCR_DBL_Pos)
+
+#define LL_TIM_CHANNEL_CH1  (1U << 0)
+#define LL_TIM_CHANNEL_CH2  (1U << 4)
+#define LL_TIM_CHANNEL_CH3  (1U << 8)
+#define LL_TIM_CHANNEL_CH4  (1U << 12)
+
+#define LL_TIM_TRGO_UPDATE  (2U << 4)
+
+#define LL_TIM_OCMODE_FROZEN    (0U << 4)
+#define LL_TIM_OCMODE_PWM1      (6U << 4)
+
+#define LL_TIM_DMABURST_BASEADDR_CCR1       (13U)
+#define LL_TIM_DMABURST_LENGTH_4TRANSFERS   (3U << TIM_DCR_DBL_Pos)
+
+/* CCMRx byte offset of a channel: CH1/CH3 in the low byte, CH2/CH4 in the high one. */
+static inline __IO uint32_t* host_tim_ccmr(TIM_TypeDef *TIMx, uint32_t Channel, uint32_t *shift)
+{
+    const uint32_t index = (uint32_t) __builtin_ctz(Channel) / 4U;
+
+    *shift = (index & 1U) * 8U;
+    return (index < 2U) ? &TIMx->CCMR1 : &TIMx->CCMR2;
+}
+
+static inline void LL_TIM_SetPrescaler(TIM_TypeDef *TIMx, uint32_t Prescaler)
+{
+    TIMx->PSC = Prescaler;
+}
+
+static inline void LL_TIM_SetAutoReload(TIM_TypeDef *TIMx, uint32_t AutoReload)
+{
+    TIMx->ARR = AutoReload;
+}
+
+static inline void LL_TIM_EnableARRPreload(TIM_TypeDef *TIMx)
+{
+    TIMx->CR1 |= TIM_CR1_ARPE;
+}
+
+static inline void LL_TIM_EnableCounter(TIM_TypeDef *TIMx)
+{
+    TIMx->CR1 |= TIM_CR1_CEN;
+}
+
+static inline void LL_TIM_DisableCounter(TIM_TypeDef *TIMx)
+{
+    TIMx->CR1 &= ~TIM_CR1_CEN;
+}
+
+static inline void LL_TIM_SetTriggerOutput(TIM_TypeDef *TIMx, uint32_t TimerSynchronization)
+{
+    TIMx->CR2 = (TIMx->CR2 & ~TIM_CR2_MMS) | TimerSynchronization;
+}
+
+static inline void LL_TIM_GenerateEvent_UPDATE(TIM_TypeDef *TIMx)
+{
+    TIMx->EGR = TIM_EGR_UG;
+}
+
+static inline void LL_TIM_OC_SetMode(TIM_TypeDef *TIMx, uint32_t Channel, uint32_t Mode)
+{
+    uint32_t shift;
+    __IO uint32_t *const ccmr = host_tim_ccmr(TIMx, Channel, &shift);
+
+    *ccmr = (*ccmr & ~((7U << 4) << shift)) | (Mode << shift);
+}
+
+static inline void LL_TIM_OC_EnablePreload(TIM_TypeDef *TIMx, uint32_t Channel)
+{
+    uint32_t shift;
+    __IO uint32_t *const ccmr = host_tim_ccmr(TIMx, Channel, &shift);
+
+    *ccmr |= (1U << 3) << shift;
+}
+
+static inline void LL_TIM_CC_EnableChannel(TIM_TypeDef *TIMx, uint32_t Channels)
+{
+    TIMx->CCER |= Channels;
+}
+
+static inline void LL_TIM_CC_DisableChannel(TIM_TypeDef *TIMx, uint32_t Channels)
+{
+    TIMx->CCER &= ~Channels;
+}
+
+static inline void LL_TIM_ConfigDMABurst(TIM_TypeDef *TIMx, uint32_t DMABurstBaseAddress, uint32_t DMABurstLength)
+{
+    TIMx->DCR = DMABurstBaseAddress | DMABurstLength;
+}
+
+static inline void LL_TIM_EnableDMAReq_UPDATE(TIM_TypeDef *TIMx)
+{
+    TIMx->DIER |= TIM_DIER_UDE;
+}
+
+static inline void LL_TIM_DisableDMAReq_UPDATE(TIM_TypeDef *TIMx)
+{
+    TIMx->DIER &= ~TIM_DIER_UDE;
+}
+
+static inline uint32_t LL_TIM_OC_GetCompareCH1(TIM_TypeDef *TIMx)
+{
+    return TIMx->CCR1;
+}
+
+static inline uint32_t LL_TIM_OC_GetCompareCH2(TIM_TypeDef *TIMx)
+{
+    return TIMx->CCR2;
+}
+
+static inline uint32_t LL_TIM_OC_GetCompareCH3(TIM_TypeDef *TIMx)
+{
+    return TIMx->CCR3;
+}
+
+static inline uint32_t LL_TIM_OC_GetCompareCH4(TIM_TypeDef *TIMx)
+{
+    return TIMx->CCR4;
+}
+
+static inline void LL_TIM_OC_SetCompareCH1(TIM_TypeDef *TIMx, uint32_t CompareValue)
+{
+    TIMx->CCR1 = CompareValue;
+}
+
+static inline void LL_TIM_OC_SetCompareCH2(TIM_TypeDef *TIMx, uint32_t CompareValue)
+{
+    TIMx->CCR2 = CompareValue;
+}
+
+static inline void LL_TIM_OC_SetCompareCH3(TIM_TypeDef *TIMx, uint32_t CompareValue)
+{
+    TIMx->CCR3 = CompareValue;
+}
+
+static inline void LL_TIM_OC_SetCompareCH4(TIM_TypeDef *TIMx, uint32_t CompareValue)
+{
+    TIMx->CCR4 = CompareValue;
+}
+
+#endif /* HOST_STM32F4XX_LL_TIM_H_ */
@@ -0,0 +1,125 @@
+/*
+ * stm32f4xx_ll_usart.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host stand-in for the USART LL driver. Status flags live in the simulated
+ *  register block; the data register is wired to host_uart.c.
+ */
+
+#ifndef HOST_STM32F4XX_LL_USART_H_
+#define HOST_STM32F4XX_LL_USART_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Implemented by host_uart.c */
+uint32_t host_usart_txe(USART_TypeDef *USARTx);
+uint32_t host_usart_tc(USART_TypeDef *USARTx);
+void host_usart_transmit(USART_TypeDef *USARTx, uint8_t Value);
+
+static inline uint32_t LL_USART_IsActiveFlag_TXE(USART_TypeDef *USARTx)
+{
+    return host_usart_txe(USARTx);
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_TC(USART_TypeDef *USARTx)
+{
+    return host_usart_tc(USARTx);
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_RXNE(USART_TypeDef *USARTx)
+{
+    return (USARTx->SR & USART_SR_RXNE) == USART_SR_RXNE;
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_FE(USART_TypeDef *USARTx)
+{
+    return (USARTx->SR & USART_SR_FE) == USART_SR_FE;
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_NE(USART_TypeDef *USARTx)
+{
+    return (USARTx->SR & USART_SR_NE) == USART_SR_NE;
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_ORE(USART_TypeDef *USARTx)
+{
+    return (USARTx->SR & USART_SR_ORE) == USART_SR_ORE;
+}
+
+static inline void LL_USART_EnableIT_RXNE(USART_TypeDef *USARTx)
+{
+    USARTx->CR1 |= USART_CR1_RXNEIE;
+}
+
+static inline void LL_USART_DisableIT_RXNE(USART_TypeDef *USARTx)
+{
+    USARTx->CR1 &= ~USART_CR1_RXNEIE;
+}
+
+static inline uint32_t LL_USART_IsEnabledIT_RXNE(USART_TypeDef *USARTx)
+{
+    return (USARTx->CR1 & USART_CR1_RXNEIE) == USART_CR1_RXNEIE;
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_IDLE(USART_TypeDef *USARTx)
+{
+    return (USARTx->SR & USART_SR_IDLE) == USART_SR_IDLE;
+}
+
+/* SR-then-DR read sequence; DR is left alone since the DMA owns it. */
+static inline void LL_USART_ClearFlag_IDLE(USART_TypeDef *USARTx)
+{
+    USARTx->SR &= ~USART_SR_IDLE;
+}
+
+static inline void LL_USART_ClearFlag_ORE(USART_TypeDef *USARTx)
+{
+    USARTx->SR &= ~USART_SR_ORE;
+}
+
+static inline void LL_USART_EnableIT_IDLE(USART_TypeDef *USARTx)
+{
+    USARTx->CR1 |= USART_CR1_IDLEIE;
+}
+
+static inline uint32_t LL_USART_IsEnabledIT_IDLE(USART_TypeDef *USARTx)
+{
+    return (USARTx->CR1 & USART_CR1_IDLEIE) == USART_CR1_IDLEIE;
+}
+
+static inline void LL_USART_EnableDMAReq_RX(USART_TypeDef *USARTx)
+{
+    USARTx->CR3 |= USART_CR3_DMAR;
+}
+
+static inline void LL_USART_EnableDMAReq_TX(USART_TypeDef *USARTx)
+{
+    USARTx->CR3 |= USART_CR3_DMAT;
+}
+
+static inline uint32_t LL_USART_IsEnabledDMAReq_TX(USART_TypeDef *USARTx)
+{
+    return (USARTx->CR3 & USART_CR3_DMAT) == USART_CR3_DMAT;
+}
+
+static inline uintptr_t LL_USART_DMA_GetRegAddr(USART_TypeDef *USARTx)
+{
+    return (uintptr_t) &USARTx->DR;
+}
+
+static inline void LL_USART_TransmitData8(USART_TypeDef *USARTx, uint8_t Value)
+{
+    host_usart_transmit(USARTx, Value);
+}
+
+/* Reading DR clears RXNE (and ORE, as the SR-then-DR sequence would on silicon). */
+static inline uint8_t LL_USART_ReceiveData8(USART_TypeDef *USARTx)
+{
+    const uint8_t value = (uint8_t) USARTx->DR;
+    USARTx->SR &= ~(USART_SR_RXNE | USART_SR_ORE);
+    return value;
+}
+
+#endif /* HOST_STM32F4XX_LL_USART_H_ */
@@ -0,0 +1,336 @@
+/*
+ * port.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  FreeRTOS port for running the firmware as a Linux process.
+ *
+ *  Every task is backed by a pthread, but only the thread owning pxCurrentTCB
+ *  is ever runnable; all others sleep on their own wake flag. The kernel tick
+ *  is SIGALRM and "interrupts disabled" means SIGALRM is blocked on the calling
+ *  thread. Simulated peripheral interrupts are serviced from the tick handler.
+ *
+ *  Like PendSV on the Cortex-M4, a yield requested while interrupts are masked
+ *  is only pended and the switch is taken once the critical section is left,
+ *  so every context switch happens with a critical nesting of zero.
+ */
+
+/* -- Standard Library -- */
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+
+#define HOST_TASK_THREAD_STACK  (256 * 1024)
+
+typedef struct
+{
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    BaseType_t      runnable;
+    BaseType_t      dying;
+    TaskFunction_t  code;
+    void           *parameters;
+} HostThread;
+
+/* -- Global Variables -- */
+
+static volatile UBaseType_t uxCriticalNesting = 0;
+static volatile BaseType_t  xSwitchPending    = pdFALSE;
+static volatile BaseType_t  xSchedulerStarted = pdFALSE;
+static sigset_t             xTickSignal;
+
+/* -------------------------------------------------------------------------- */
+/*                              Thread Handling                               */
+/* -------------------------------------------------------------------------- */
+
+/* -- Thread of a Task -- */
+/* pxPortInitialiseStack() leaves the HostThread pointer at the task's top of stack. */
+static inline HostThread* thread_of(TaskHandle_t task)
+{
+    HostThread *thread;
+    __builtin_memcpy(&thread, *(StackType_t**) task, sizeof(thread));
+    return thread;
+}
+
+/* -- Resume Thread -- */
+static void thread_resume(HostThread *thread)
+{
+    pthread_mutex_lock(&thread->lock);
+    thread->runnable = pdTRUE;
+    pthread_cond_signal(&thread->wake);
+    pthread_mutex_unlock(&thread->lock);
+}
+
+/* -- Wait Until Scheduled -- */
+/* Blocks the calling thread until it is handed the CPU; exits it if its task was deleted meanwhile. */
+static void thread_wait(HostThread *thread)
+{
+    pthread_mutex_lock(&thread->lock);
+    while (thread->runnable == pdFALSE)
+    {
+        pthread_cond_wait(&thread->wake, &thread->lock);
+    }
+    thread->runnable = pdFALSE;
+    const BaseType_t dying = thread->dying;
+    pthread_mutex_unlock(&thread->lock);
+
+    if (dying != pdFALSE)
+    {
+        pthread_mutex_destroy(&thread->lock);
+        pthread_cond_destroy(&thread->wake);
+        free(thread);
+        pthread_exit(NULL);
+    }
+}
+
+/* -- Switch Context -- */
+/* Must be called with the tick masked and a critical nesting of zero. */
+static void switch_context(void)
+{
+    while (xSwitchPending != pdFALSE)
+    {
+        xSwitchPending = pdFALSE;
+
+        HostThread *const previous = thread_of(xTaskGetCurrentTaskHandle());
+        vTaskSwitchContext();
+        HostThread *const next = thread_of(xTaskGetCurrentTaskHandle());
+
+        if (next != previous)
+        {
+            thread_resume(next);
+            thread_wait(previous);
+        }
+    }
+}
+
+/* -- Task Thread Entry -- */
+static void* task_thread(void *arguments)
+{
+    HostThread *const thread = (HostThread*) arguments;
+
+    thread_wait(thread);
+    vPortEnableInterrupts();
+
+    thread->code(thread->parameters);
+
+    /* A task returned; the board would trap in prvTaskExitError(), here it is just removed. */
+    vTaskDelete(NULL);
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              Tick Interrupt                                */
+/* -------------------------------------------------------------------------- */
+
+/* -- SIGALRM Handler -- */
+/* Acts as SysTick plus every simulated peripheral IRQ. Runs on the current task's thread. */
+static void tick_handler(int signal)
+{
+    (void) signal;
+
+    if (xTaskIncrementTick() != pdFALSE)
+    {
+        xSwitchPending = pdTRUE;
+    }
+
+    host_irq_service();
+
+    switch_context();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Port Interface                               */
+/* -------------------------------------------------------------------------- */
+
+StackType_t* pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    sigset_t previous_mask;
+    pthread_attr_t attributes;
+
+    /* Keep the tick away while libc allocates, a preempted malloc() would deadlock the next caller. */
+    pthread_sigmask(SIG_BLOCK, &xTickSignal, &previous_mask);
+
+    HostThread *const thread = calloc(1, sizeof(HostThread));
+    configASSERT(thread != NULL);
+
+    pthread_mutex_init(&thread->lock, NULL);
+    pthread_cond_init(&thread->wake, NULL);
+    thread->code = pxCode;
+    thread->parameters = pvParameters;
+
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, HOST_TASK_THREAD_STACK);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    configASSERT(pthread_create(&thread->thread, &attributes, task_thread, thread) == 0);
+    pthread_attr_destroy(&attributes);
+
+    pthread_sigmask(SIG_SETMASK, &previous_mask, NULL);
+
+    /* pxTopOfStack is the last usable word; step down far enough to hold a pointer. */
+    pxTopOfStack -= sizeof(HostThread*) / sizeof(StackType_t);
+    __builtin_memcpy(pxTopOfStack, &thread, sizeof(thread));
+
+    return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    struct sigaction action = { 0 };
+    const struct itimerval tick = {
+        .it_interval = { .tv_sec = 0, .tv_usec = 1000000 / configTICK_RATE_HZ },
+        .it_value    = { .tv_sec = 0, .tv_usec = 1000000 / configTICK_RATE_HZ },
+    };
+
+    action.sa_handler = tick_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaddset(&action.sa_mask, SIGALRM);
+    sigaction(SIGALRM, &action, NULL);
+
+    /* The main thread only parks from here on, it must never take the tick. */
+    pthread_sigmask(SIG_BLOCK, &xTickSignal, NULL);
+
+    uxCriticalNesting = 0;
+    xSchedulerStarted = pdTRUE;
+    setitimer(ITIMER_REAL, &tick, NULL);
+
+    thread_resume(thread_of(xTaskGetCurrentTaskHandle()));
+
+    while (1)
+    {
+        pause();
+    }
+
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+    exit(EXIT_SUCCESS);
+}
+
+void vPortYield(void)
+{
+    xSwitchPending = pdTRUE;
+
+    if (xSchedulerStarted != pdFALSE && uxCriticalNesting == 0)
+    {
+        vPortDisableInterrupts();
+        switch_context();
+        vPortEnableInterrupts();
+    }
+}
+
+void vPortYieldFromISR(void)
+{
+    /* Taken by tick_handler() once every simulated ISR has run. */
+    xSwitchPending = pdTRUE;
+}
+
+void vPortDisableInterrupts(void)
+{
+    pthread_sigmask(SIG_BLOCK, &xTickSignal, NULL);
+}
+
+void vPortEnableInterrupts(void)
+{
+    pthread_sigmask(SIG_UNBLOCK, &xTickSignal, NULL);
+}
+
+void vPortEnterCritical(void)
+{
+    vPortDisableInterrupts();
+    uxCriticalNesting++;
+}
+
+void vPortExitCritical(void)
+{
+    if (uxCriticalNesting == 0)
+    {
+        return;
+    }
+
+    if (--uxCriticalNesting == 0)
+    {
+        if (xSchedulerStarted != pdFALSE)
+        {
+            switch_context();
+        }
+        vPortEnableInterrupts();
+    }
+}
+
+void vPortCleanUpTCB(void *pxTCB)
+{
+    HostThread *const thread = thread_of((TaskHandle_t) pxTCB);
+
+    /* The thread is parked in thread_wait(); wake it so it can release itself. */
+    pthread_mutex_lock(&thread->lock);
+    thread->dying = pdTRUE;
+    pthread_mutex_unlock(&thread->lock);
+    thread_resume(thread);
+}
+
+/* -- Suppress Ticks and Sleep -- */
+/* Tickless idle on the host. Ticks are swallowed with sigwait() instead of reaching xTaskIncrementTick(),
+ * the peripherals are still serviced each period, and the first one that readies a task ends the sleep.
+ * As on the board, the periods slept are stepped onto the tick count and the last one is a real tick. */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    TickType_t xSlept = 0;
+    int signal;
+
+    vPortDisableInterrupts();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep || xSwitchPending != pdFALSE)
+    {
+        vPortEnableInterrupts();
+        return;
+    }
+
+    TickType_t xModifiableIdleTime = xExpectedIdleTime;
+    configPRE_SLEEP_PROCESSING(xModifiableIdleTime);
+
+    if (xModifiableIdleTime > 0)
+    {
+        while (xSlept < xExpectedIdleTime && xSwitchPending == pdFALSE)
+        {
+            sigwait(&xTickSignal, &signal);
+            xSlept++;
+            host_irq_service();
+        }
+    }
+
+    configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+
+    if (xSlept > 0)
+    {
+        vTaskStepTick(xSlept - 1);
+        if (xTaskIncrementTick() != pdFALSE)
+        {
+            xSwitchPending = pdTRUE;
+        }
+    }
+
+    vPortEnableInterrupts();
+}
+
+/* -- Port Constructor -- */
+/* Runs before main() so the signal set exists before the first xTaskCreate(). */
+__attribute__((constructor)) static void port_init(void)
+{
+    sigemptyset(&xTickSignal);
+    sigaddset(&xTickSignal, SIGALRM);
+}
@@ -0,0 +1,94 @@
+/*
+ * portmacro.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  FreeRTOS port definitions for running the firmware as a Linux process.
+ *  See port.c for how tasks, the tick and interrupt masking are mapped onto
+ *  pthreads and signals.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -- Type Definitions -- */
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  uint32_t
+#define portBASE_TYPE   long
+
+/* Stacks keep the target's 32-bit word so task and heap sizes match the board. */
+typedef portSTACK_TYPE  StackType_t;
+typedef long            BaseType_t;
+typedef unsigned long   UBaseType_t;
+
+#if ( configUSE_16_BIT_TICKS == 1 )
+    typedef uint16_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+    typedef uint32_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#endif
+
+#define portPOINTER_SIZE_TYPE   uintptr_t
+
+/* -- Architecture Specifics -- */
+#define portSTACK_GROWTH        ( -1 )
+#define portTICK_PERIOD_MS      ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT      8
+#define portNOP()
+#define portMEMORY_BARRIER()    __sync_synchronize()
+
+/* -- Scheduler Utilities -- */
+void vPortYield(void);
+void vPortYieldFromISR(void);
+
+#define portYIELD()                 vPortYield()
+#define portEND_SWITCHING_ISR(x)    do { if ((x) != pdFALSE) { vPortYieldFromISR(); } } while (0)
+#define portYIELD_FROM_ISR(x)       portEND_SWITCHING_ISR(x)
+
+/* -- Critical Sections -- */
+void vPortDisableInterrupts(void);
+void vPortEnableInterrupts(void);
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+
+#define portDISABLE_INTERRUPTS()                vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()                 vPortEnableInterrupts()
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+
+/* Simulated ISRs already run with the tick signal blocked, so there is nothing to save. */
+#define portSET_INTERRUPT_MASK_FROM_ISR()       0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    ( void ) ( x )
+
+/* -- Task Function Macros -- */
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters)    void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)          void vFunction(void *pvParameters)
+
+/* -- Task Deletion -- */
+void vPortCleanUpTCB(void *pxTCB);
+#define portCLEAN_UP_TCB(pxTCB)     vPortCleanUpTCB(pxTCB)
+
+/* -- Tickless Idle -- */
+/* The SIGALRM timer keeps running to poll the simulated peripherals; only the kernel stops seeing ticks. */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime)     vPortSuppressTicksAndSleep(xExpectedIdleTime)
+
+/* Run-time stats use the firmware's run_time.c on the simulated DWT, see FreeRTOSConfig.h. */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,139 @@
+/*
+ * host_adc.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  ADC1 for the host build. Every TIM3 update that has passed since the
+ *  last DMA service starts one scan of the regular sequence, as TRGO does
+ *  on the board; the DMA then reads the conversions in rank order. Each
+ *  input carries a fixed test signal, evaluated at the scan's own time:
+ *
+ *    IN0: 50 Hz sine, 1500 LSB peak
+ *    IN1: 440 Hz sine, 800 LSB peak, plus 1250 Hz, 200 LSB peak
+ *    IN2: 1.0 V DC with +/-8 LSB of noise
+ */
+
+/* -- Standard Library -- */
+#include <math.h>
+
+/* -- STM32 Library -- */
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_ll_adc.h"
+#include "stm32f4xx_ll_tim.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+#include "host_dma.h"
+
+#define HOST_ADC_MID_SCALE      (2048.0)
+#define HOST_ADC_FULL_SCALE     (4095)
+
+/* Conversions kept for a DMA that has fallen behind; the rest are dropped, as an overrun would. */
+#define HOST_ADC_BACKLOG        (4096U)
+
+#define HOST_ADC_TWO_PI         (6.283185307179586)
+
+/* -- Global Variables -- */
+
+static uint64_t Last_Update_Ns;
+static uint64_t Scan;           /* Scans since the last software update event */
+static uint32_t Rank;           /* Next rank of the current scan */
+static uint64_t Pending;        /* Conversions triggered but not yet read */
+static uint32_t Noise = 0x2545F491U;
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Input Voltage -- */
+/* In LSB, at `t` seconds. */
+static inline uint16_t input(const uint32_t channel, const double t)
+{
+    double value;
+
+    switch (channel)
+    {
+        case 0:
+            value = HOST_ADC_MID_SCALE + 1500.0 * sin(HOST_ADC_TWO_PI * 50.0 * t);
+            break;
+
+        case 1:
+            value = HOST_ADC_MID_SCALE + 800.0 * sin(HOST_ADC_TWO_PI * 440.0 * t)
+                    + 200.0 * sin(HOST_ADC_TWO_PI * 1250.0 * t);
+            break;
+
+        case 2:
+            Noise ^= Noise << 13;
+            Noise ^= Noise >> 17;
+            Noise ^= Noise << 5;
+            value = 1365.0 + (double) (Noise % 17U) - 8.0;
+            break;
+
+        default:
+            value = 0.0;
+            break;
+    }
+
+    return (value < 0.0) ? 0 : (value > HOST_ADC_FULL_SCALE) ? HOST_ADC_FULL_SCALE : (uint16_t) lround(value);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  Host ADC                                  */
+/* -------------------------------------------------------------------------- */
+
+/* -- ADC DMA Read -- */
+size_t host_adc_dma_read(ADC_TypeDef *ADCx, uint8_t *dst, size_t items)
+{
+    const uint64_t now = host_time_ns();
+    const uint32_t length = ((ADCx->SQR1 & ADC_SQR1_L) >> ADC_SQR1_L_Pos) + 1U;
+    const uint64_t period_ns = (uint64_t) (TIM3->PSC + 1U) * (TIM3->ARR + 1U) * 1000000000ULL / (SystemCoreClock / 2U);
+    uint16_t *const halfwords = (uint16_t*) dst;
+
+    if (!(ADCx->CR2 & ADC_CR2_ADON) || !(ADCx->CR2 & ADC_CR2_EXTEN))
+    {
+        Pending = 0;
+        Rank = 0;
+        return 0;
+    }
+
+    /* UG is an update too, so TRGO starts a scan straight away. */
+    if (TIM3->EGR & TIM_EGR_UG)
+    {
+        TIM3->EGR = 0;
+        Last_Update_Ns = now;
+        Scan = 0;
+        Rank = 0;
+        Pending = length;
+    }
+
+    if (TIM3->CR1 & TIM_CR1_CEN)
+    {
+        const uint64_t updates = (now - Last_Update_Ns) / period_ns;
+
+        Last_Update_Ns += updates * period_ns;
+        Pending += updates * length;
+        if (Pending > HOST_ADC_BACKLOG)
+        {
+            Scan += (Pending - HOST_ADC_BACKLOG) / length;
+            Pending = HOST_ADC_BACKLOG - HOST_ADC_BACKLOG % length;
+        }
+    }
+
+    const size_t count = (Pending < items) ? (size_t) Pending : items;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t channel = (ADCx->SQR3 >> (Rank * 5U)) & 0x1FU;
+
+        halfwords[i] = input(channel, (double) Scan * (double) period_ns * 1e-9);
+        if (++Rank == length)
+        {
+            Rank = 0;
+            Scan++;
+        }
+    }
+
+    Pending -= count;
+    return count;
+}
@@ -0,0 +1,194 @@
+/*
+ * host_dma.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Simulated DMA1 and DMA2 controllers. Streams move data between memory and
+ *  the simulated peripherals once per tick, decrement NDTR, set HT/TC flags,
+ *  reload in circular mode and call the stream's IRQ handler like the NVIC
+ *  would. Only DMA2 stream interrupts are wired up.
+ */
+
+/* -- STM32 Library -- */
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_ll_adc.h"
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_tim.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+#include "host_dma.h"
+#include "host_uart.h"
+
+/* -- Global Variables -- */
+
+DMA_TypeDef host_dma1, host_dma2;
+
+/* NDTR latched when the stream is enabled, reload value in circular mode; [0] DMA1, [1] DMA2. */
+static uint32_t Dma_Length[2][8];
+
+/* Handlers are only linked in when the firmware uses the stream. */
+void DMA2_Stream0_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream1_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream2_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream3_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream4_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream5_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream6_IRQHandler(void) __attribute__((weak));
+void DMA2_Stream7_IRQHandler(void) __attribute__((weak));
+
+static void (*const Dma2_Handlers[8])(void) = {
+    DMA2_Stream0_IRQHandler, DMA2_Stream1_IRQHandler, DMA2_Stream2_IRQHandler, DMA2_Stream3_IRQHandler,
+    DMA2_Stream4_IRQHandler, DMA2_Stream5_IRQHandler, DMA2_Stream6_IRQHandler, DMA2_Stream7_IRQHandler,
+};
+
+static const IRQn_Type Dma2_Irqs[8] = {
+    DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+    DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn,
+};
+
+/* -------------------------------------------------------------------------- */
+/*                              Static Helpers                                */
+/* -------------------------------------------------------------------------- */
+
+static inline uint32_t *stream_length(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    return &Dma_Length[(DMAx == DMA1) ? 0 : 1][Stream];
+}
+
+static inline void set_flags(DMA_TypeDef *DMAx, uint32_t Stream, uint32_t Flags)
+{
+    if (Stream < 4U)
+    {
+        DMAx->LISR |= Flags << host_dma_flag_shift(Stream);
+    }
+    else
+    {
+        DMAx->HISR |= Flags << host_dma_flag_shift(Stream);
+    }
+}
+
+/* -- Memory to Peripheral -- */
+/* Returns how many items the peripheral behind `PAR` accepted this tick. */
+static size_t periph_write(uintptr_t PAR, const uint8_t *src, size_t items)
+{
+    if (PAR == (uintptr_t) &USART1->DR && (USART1->CR3 & USART_CR3_DMAT))
+    {
+        return host_uart_dma_tx(USART1, src, items);
+    }
+
+    if (PAR == (uintptr_t) &TIM4->DMAR && (TIM4->DIER & TIM_DIER_UDE))
+    {
+        return host_tim_dma_burst(TIM4, src, items);
+    }
+
+    /* Unmodelled peripheral: behaves like a sink that is always ready. */
+    return items;
+}
+
+/* -- Peripheral to Memory -- */
+/* Returns how many items the peripheral behind `PAR` produced this tick. */
+static size_t periph_read(uintptr_t PAR, uint8_t *dst, size_t items)
+{
+    if (PAR == (uintptr_t) &USART1->DR && (USART1->CR3 & USART_CR3_DMAR))
+    {
+        return host_uart_dma_rx(USART1, dst, items);
+    }
+
+    if (PAR == (uintptr_t) &ADC1->DR && (ADC1->CR2 & ADC_CR2_DMA))
+    {
+        return host_adc_dma_read(ADC1, dst, items);
+    }
+
+    /* Unmodelled peripheral: never requests a transfer. */
+    return 0;
+}
+
+/* -- Advance One Stream -- */
+static uint32_t service_stream(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    DMA_Stream_TypeDef *const st = &DMAx->Stream[Stream];
+    const uint32_t total = *stream_length(DMAx, Stream);
+    const uint32_t item_size = 1U << ((st->CR & DMA_SxCR_MSIZE) >> 13);
+    uint32_t flags = 0;
+
+    while ((st->CR & DMA_SxCR_EN) && total != 0)
+    {
+        const uint32_t done = total - st->NDTR;
+        uint8_t *const memory = (uint8_t*) st->M0AR + ((st->CR & DMA_SxCR_MINC) ? done * item_size : 0);
+        size_t moved;
+
+        if ((st->CR & DMA_SxCR_DIR) == DMA_SxCR_DIR_0)
+        {
+            moved = periph_write(st->PAR, memory, st->NDTR);
+        }
+        else
+        {
+            moved = periph_read(st->PAR, memory, st->NDTR);
+        }
+
+        if (moved == 0)
+        {
+            break;
+        }
+
+        const uint32_t before = st->NDTR;
+        st->NDTR -= (uint32_t) moved;
+
+        if (before > total / 2 && st->NDTR <= total / 2)
+        {
+            flags |= DMA_FLAG_HT;
+        }
+
+        if (st->NDTR == 0)
+        {
+            flags |= DMA_FLAG_TC;
+
+            if (st->CR & DMA_SxCR_CIRC)
+            {
+                st->NDTR = total;
+            }
+            else
+            {
+                st->CR &= ~DMA_SxCR_EN;
+            }
+        }
+    }
+
+    return flags;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                             Simulator Interface                            */
+/* -------------------------------------------------------------------------- */
+
+void host_dma_enable(DMA_TypeDef *DMAx, uint32_t Stream)
+{
+    *stream_length(DMAx, Stream) = DMAx->Stream[Stream].NDTR;
+    DMAx->Stream[Stream].CR |= DMA_SxCR_EN;
+}
+
+void host_dma_service(DMA_TypeDef *DMAx)
+{
+    for (uint32_t stream = 0; stream < 8; ++stream)
+    {
+        const uint32_t flags = service_stream(DMAx, stream);
+
+        if (flags == 0)
+        {
+            continue;
+        }
+
+        set_flags(DMAx, stream, flags);
+
+        const uint32_t cr = DMAx->Stream[stream].CR;
+        const uint32_t enabled = ((cr & DMA_SxCR_TCIE) ? DMA_FLAG_TC : 0)
+                               | ((cr & DMA_SxCR_HTIE) ? DMA_FLAG_HT : 0);
+
+        if (DMAx == DMA2 && (flags & enabled) && NVIC_GetEnableIRQ(Dma2_Irqs[stream]) && Dma2_Handlers[stream] != NULL)
+        {
+            Dma2_Handlers[stream]();
+        }
+    }
+}
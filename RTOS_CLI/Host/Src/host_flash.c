@@ -0,0 +1,161 @@
+/*
+ * host_flash.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Flash sectors 1 and 2 (the SETTINGS region of the linker script) for the
+ *  host build, backed by a file so that saved settings survive a restart.
+ *  NOR rules apply: erase sets every byte to 0xFF, programming can only clear
+ *  bits, and nothing can be programmed while the flash is locked. Each write
+ *  goes straight through to the file, so killing the process mid-compaction
+ *  leaves the same state a reset would on the board. host_flash_power_cut()
+ *  stops the writes at a chosen point, for the tests.
+ */
+
+/* -- Standard Library -- */
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* -- STM32 Library -- */
+#include "stm32f4xx_hal.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+#include "settings_store.h"
+
+#define HOST_FLASH_SIZE     (2U * SETTINGS_STORE_SECTOR_SIZE)
+
+/* -- Global Variables -- */
+
+/* Same name as the linker symbol on the board. */
+uint8_t _settings_flash_start[HOST_FLASH_SIZE] __attribute__((aligned(4)));
+
+static int     Flash_Fd = -1;
+static uint8_t Flash_Unlocked;
+static int32_t Flash_Ops_Left = -1;     /* Programs and sector erases before the power cut, -1 for no cut */
+
+/* -------------------------------------------------------------------------- */
+/*                          Static Inline Function Group                      */
+/* -------------------------------------------------------------------------- */
+
+/* -- Power Left -- */
+/* Counts one program or sector erase against the cut; pdFALSE once the power has gone. */
+static inline BaseType_t power_left(void)
+{
+    if (Flash_Ops_Left == 0)
+    {
+        return pdFALSE;
+    }
+
+    if (Flash_Ops_Left > 0)
+    {
+        Flash_Ops_Left--;
+    }
+    return pdTRUE;
+}
+
+/* -- Write Through -- */
+static inline void write_through(const uint32_t offset, const uint32_t length)
+{
+    if (Flash_Fd >= 0 && pwrite(Flash_Fd, &_settings_flash_start[offset], length, offset) != (ssize_t) length)
+    {
+        host_log("host_flash: write to the flash image failed\n");
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 Host Flash                                 */
+/* -------------------------------------------------------------------------- */
+
+/* -- Host Flash Init -- */
+/* A missing or short file reads as erased flash. */
+void host_flash_init(void)
+{
+    const char *path = getenv("RTOS_CLI_FLASH");
+    ssize_t loaded;
+
+    memset(_settings_flash_start, 0xFF, sizeof(_settings_flash_start));
+
+    Flash_Fd = open((path != NULL) ? path : "rtos_cli_flash.bin", O_RDWR | O_CREAT, 0644);
+    if (Flash_Fd < 0)
+    {
+        host_log("host_flash: no flash image, settings will not persist\n");
+        return;
+    }
+
+    loaded = pread(Flash_Fd, _settings_flash_start, sizeof(_settings_flash_start), 0);
+    if (loaded < (ssize_t) sizeof(_settings_flash_start))
+    {
+        memset(&_settings_flash_start[(loaded > 0) ? loaded : 0], 0xFF,
+               sizeof(_settings_flash_start) - (size_t) ((loaded > 0) ? loaded : 0));
+        write_through(0, sizeof(_settings_flash_start));
+    }
+}
+
+/* -- Host Flash Power Cut -- */
+void host_flash_power_cut(int32_t operations)
+{
+    Flash_Ops_Left = operations;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    Flash_Unlocked = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    Flash_Unlocked = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uintptr_t Address, uint64_t Data)
+{
+    const uintptr_t base = (uintptr_t) _settings_flash_start;
+    uint32_t word = (uint32_t) Data;
+
+    if (!Flash_Unlocked || TypeProgram != FLASH_TYPEPROGRAM_WORD || (Address & 3U) != 0
+        || Address < base || Address + 4U > base + HOST_FLASH_SIZE || !power_left())
+    {
+        return HAL_ERROR;
+    }
+
+    const uint32_t offset = (uint32_t) (Address - base);
+    uint32_t current;
+
+    memcpy(&current, &_settings_flash_start[offset], sizeof(current));
+    word &= current;
+    memcpy(&_settings_flash_start[offset], &word, sizeof(word));
+    write_through(offset, sizeof(word));
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+    *SectorError = 0xFFFFFFFFU;
+
+    if (!Flash_Unlocked || pEraseInit->TypeErase != FLASH_TYPEERASE_SECTORS)
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint32_t sector = pEraseInit->Sector; sector < pEraseInit->Sector + pEraseInit->NbSectors; ++sector)
+    {
+        if ((sector != FLASH_SECTOR_1 && sector != FLASH_SECTOR_2) || !power_left())
+        {
+            *SectorError = sector;
+            return HAL_ERROR;
+        }
+
+        const uint32_t offset = (sector - FLASH_SECTOR_1) * SETTINGS_STORE_SECTOR_SIZE;
+        memset(&_settings_flash_start[offset], 0xFF, SETTINGS_STORE_SECTOR_SIZE);
+        write_through(offset, SETTINGS_STORE_SECTOR_SIZE);
+    }
+
+    return HAL_OK;
+}
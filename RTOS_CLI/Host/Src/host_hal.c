@@ -0,0 +1,398 @@
+/*
+ * host_hal.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  HAL, CMSIS and NVIC stand-ins for the host simulation build.
+ */
+
+/* -- Standard Library -- */
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* -- STM32 Library -- */
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_ll_rng.h"
+#include "stm32f4xx_ll_tim.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+#include "host_dma.h"
+#include "host_uart.h"
+
+/* -- Global Variables -- */
+
+uint32_t SystemCoreClock = 144000000U;
+
+USART_TypeDef host_usart1, host_usart3;
+GPIO_TypeDef  host_gpioa, host_gpiob, host_gpiod, host_gpioh;
+RNG_TypeDef   host_rng;
+TIM_TypeDef   host_tim1, host_tim2, host_tim3, host_tim4;
+ADC_TypeDef   host_adc1;
+ADC_Common_TypeDef host_adc_common;
+
+volatile uint32_t uwTick;
+
+CoreDebug_Type host_core_debug;
+SysTick_Type   host_systick;
+SCB_Type       host_scb;
+
+static DWT_Type Dwt;
+static uint32_t Dwt_Last_Cyccnt;
+static uint64_t Dwt_Base_Ns;
+
+static volatile uint8_t  Nvic_Enabled[HOST_IRQ_COUNT];
+static volatile uint8_t  Nvic_Priority[HOST_IRQ_COUNT];
+static uint32_t          Rng_State;
+
+/* -------------------------------------------------------------------------- */
+/*                               Host Helpers                                 */
+/* -------------------------------------------------------------------------- */
+
+uint64_t host_time_ns(void)
+{
+    static struct timespec start;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (start.tv_sec == 0 && start.tv_nsec == 0)
+    {
+        start = now;
+    }
+
+    return (uint64_t) (now.tv_sec - start.tv_sec) * 1000000000ULL + (uint64_t) (now.tv_nsec - start.tv_nsec);
+}
+
+void host_log(const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (len > (int) sizeof(buffer) - 1)
+    {
+        len = sizeof(buffer) - 1;
+    }
+
+    if (len > 0 && write(STDERR_FILENO, buffer, (size_t) len) < 0)
+    {
+        /* Nothing sensible left to report to. */
+    }
+}
+
+/* -- Simulated NVIC -- */
+/* Runs in tick-signal context; every peripheral model raises its IRQ from here. */
+void host_irq_service(void)
+{
+    if (Nvic_Enabled[USART1_IRQn])
+    {
+        host_uart_service(USART1);
+    }
+
+    host_dma_service(DMA1);
+    host_dma_service(DMA2);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  CMSIS                                     */
+/* -------------------------------------------------------------------------- */
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    Nvic_Priority[IRQn] = (uint8_t) priority;
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    Nvic_Enabled[IRQn] = 1;
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    Nvic_Enabled[IRQn] = 0;
+}
+
+uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+    return Nvic_Enabled[IRQn];
+}
+
+DWT_Type* host_dwt(void)
+{
+    const uint64_t now = host_time_ns();
+
+    if (!(host_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) || !(Dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+        || Dwt.CYCCNT != Dwt_Last_Cyccnt)
+    {
+        /* Counter stopped, or firmware wrote CYCCNT: count on from the current value. */
+        Dwt_Base_Ns = now - (uint64_t) Dwt.CYCCNT * 1000U / (SystemCoreClock / 1000000U);
+    }
+    else
+    {
+        Dwt.CYCCNT = (uint32_t) ((now - Dwt_Base_Ns) * (SystemCoreClock / 1000000U) / 1000U);
+    }
+
+    Dwt_Last_Cyccnt = Dwt.CYCCNT;
+    return &Dwt;
+}
+
+void __disable_irq(void)
+{
+    portDISABLE_INTERRUPTS();
+}
+
+void __enable_irq(void)
+{
+    portENABLE_INTERRUPTS();
+}
+
+/* Interrupts are the tick signal here, so sleeping until one arrives is sigsuspend() with it unblocked. */
+void __WFI(void)
+{
+    sigset_t mask;
+
+    pthread_sigmask(SIG_SETMASK, NULL, &mask);
+    sigdelset(&mask, SIGALRM);
+    sigsuspend(&mask);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   HAL                                      */
+/* -------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+    Rng_State = (uint32_t) time(NULL) ^ (uint32_t) getpid();
+
+    /* RTOS_CLI_CYCCNT presets the cycle counter, e.g. just below 2^32 to exercise a wrap right after boot. */
+    const char *cyccnt = getenv("RTOS_CLI_CYCCNT");
+    if (cyccnt != NULL)
+    {
+        Dwt.CYCCNT = (uint32_t) strtoul(cyccnt, NULL, 0);
+        Dwt_Last_Cyccnt = Dwt.CYCCNT;
+    }
+
+    host_flash_init();
+    return HAL_OK;
+}
+
+void HAL_IncTick(void)
+{
+    uwTick++;
+}
+
+/* Weak, as in the HAL, so the firmware can take the time base over. */
+__attribute__((weak)) uint32_t HAL_GetTick(void)
+{
+    return (uint32_t) (host_time_ns() / 1000000ULL);
+}
+
+/* No TIM1 time base on the host; uwTick only moves through HAL_IncTick(). */
+void HAL_SuspendTick(void)
+{
+}
+
+void HAL_ResumeTick(void)
+{
+}
+
+void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
+{
+    (void) PriorityGroup;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void) SubPriority;
+    NVIC_SetPriority(IRQn, PreemptPriority);
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    NVIC_EnableIRQ(IRQn);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    NVIC_DisableIRQ(IRQn);
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    (void) RCC_OscInitStruct;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    (void) RCC_ClkInitStruct;
+    (void) FLatency;
+    return HAL_OK;
+}
+
+/* -- GPIO -- */
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    for (uint32_t pin = 0; pin < 16; ++pin)
+    {
+        if (GPIO_Init->Pin & (1U << pin))
+        {
+            GPIOx->MODER = (GPIOx->MODER & ~(3U << (pin * 2))) | ((GPIO_Init->Mode & 3U) << (pin * 2));
+        }
+    }
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin)
+{
+    for (uint32_t pin = 0; pin < 16; ++pin)
+    {
+        if (GPIO_Pin & (1U << pin))
+        {
+            GPIOx->MODER &= ~(3U << (pin * 2));
+        }
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState != GPIO_PIN_RESET)
+    {
+        GPIOx->ODR |= GPIO_Pin;
+    }
+    else
+    {
+        GPIOx->ODR &= ~(uint32_t) GPIO_Pin;
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->ODR ^= GPIO_Pin;
+}
+
+/* -- UART -- */
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    if (huart == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    HAL_UART_MspInit(huart);
+    host_uart_configure(huart->Instance, huart->Init.BaudRate);
+    return HAL_OK;
+}
+
+/* -- RNG -- */
+
+HAL_StatusTypeDef HAL_RNG_Init(RNG_HandleTypeDef *hrng)
+{
+    HAL_RNG_MspInit(hrng);
+    return HAL_OK;
+}
+
+uint32_t host_rng_read(RNG_TypeDef *RNGx)
+{
+    (void) RNGx;
+
+    /* xorshift32, plenty for a demo command. */
+    Rng_State ^= Rng_State << 13;
+    Rng_State ^= Rng_State >> 17;
+    Rng_State ^= Rng_State << 5;
+    return Rng_State;
+}
+
+/* -- TIM -- */
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+    HAL_TIM_Base_MspInit(htim);
+    htim->Instance->PSC = htim->Init.Prescaler;
+    htim->Instance->ARR = htim->Init.Period;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 |= 1U;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig)
+{
+    (void) htim;
+    (void) sClockSourceConfig;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig)
+{
+    (void) htim;
+    (void) sMasterConfig;
+    return HAL_OK;
+}
+
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim)
+{
+    HAL_TIM_PeriodElapsedCallback(htim);
+}
+
+/* -- Timer Update DMA Burst -- */
+/* TIM2..TIM4 run from the APB1 timer clock, twice PCLK1 = HCLK / 2 with the board's APB1 prescaler of 4.
+ * An update event generated by software (UG) restarts the count of update periods. */
+size_t host_tim_dma_burst(TIM_TypeDef *TIMx, const uint8_t *src, size_t items)
+{
+    static uint64_t last_update_ns[4];
+    uint64_t *const last = &last_update_ns[(TIMx == TIM1) ? 0 : (TIMx == TIM2) ? 1 : (TIMx == TIM3) ? 2 : 3];
+    const uint64_t now = host_time_ns();
+
+    if (TIMx->EGR & TIM_EGR_UG)
+    {
+        TIMx->EGR = 0;
+        TIMx->CNT = 0;
+        *last = now;
+        return 0;
+    }
+
+    if (!(TIMx->CR1 & TIM_CR1_CEN))
+    {
+        return 0;
+    }
+
+    const uint32_t base = TIMx->DCR & TIM_DCR_DBA;
+    const uint32_t length = ((TIMx->DCR & TIM_DCR_DBL) >> TIM_DCR_DBL_Pos) + 1U;
+    const uint64_t period_ns = (uint64_t) (TIMx->PSC + 1U) * (TIMx->ARR + 1U) * 1000000000ULL / (SystemCoreClock / 2U);
+    const uint16_t *const halfwords = (const uint16_t*) src;
+
+    uint64_t updates = (now - *last) / period_ns;
+    if (updates > items / length)
+    {
+        updates = items / length;
+    }
+
+    for (uint64_t update = 0; update < updates; ++update)
+    {
+        for (uint32_t k = 0; k < length; ++k)
+        {
+            (&TIMx->CR1)[base + k] = halfwords[update * length + k];
+        }
+    }
+
+    *last += updates * period_ns;
+    return (size_t) (updates * length);
+}
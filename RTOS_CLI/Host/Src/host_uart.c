@@ -0,0 +1,308 @@
+/*
+ * host_uart.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Simulated USART. USART1 is bridged to a pseudo-terminal so a terminal or a
+ *  test script can talk to the CLI exactly as over the ST-Link VCP. Both
+ *  directions are paced at the configured baud rate (10 bits per byte) so
+ *  TXE polling and RX interrupt rates look like they do on the board.
+ */
+
+#define _GNU_SOURCE
+
+/* -- Standard Library -- */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* termios.h names its delay masks after the USART/TIM control registers. */
+#undef CR1
+#undef CR2
+#undef CR3
+
+/* -- STM32 Library -- */
+#include "stm32f4xx_hal.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+#include "host_uart.h"
+
+#define HOST_UART_RX_FIFO   (4096)
+
+typedef struct
+{
+    int      master_fd;
+    int      slave_fd;
+    uint32_t baud_rate;
+    uint64_t tx_busy_until_ns;
+    uint8_t  tx_dma_active;
+    uint64_t rx_last_service_ns;
+    uint64_t rx_credit_bits;
+    uint8_t  rx_dma_busy;       /* DMA took bytes since the line was last idle */
+    uint8_t  rx_fifo[HOST_UART_RX_FIFO];
+    size_t   rx_head;
+    size_t   rx_count;
+} HostUart;
+
+/* -- Global Variables -- */
+
+static HostUart Host_Usart1 = { .master_fd = -1, .slave_fd = -1, .baud_rate = 115200 };
+
+/* Provided by the firmware (uart_rx.c). */
+void USART1_IRQHandler(void);
+
+/* -------------------------------------------------------------------------- */
+/*                              Static Helpers                                */
+/* -------------------------------------------------------------------------- */
+
+static inline HostUart* uart_of(USART_TypeDef *USARTx)
+{
+    return (USARTx == USART1) ? &Host_Usart1 : NULL;
+}
+
+static inline uint64_t byte_time_ns(const HostUart *uart)
+{
+    return 10ULL * 1000000000ULL / uart->baud_rate;
+}
+
+/* -- Open Pseudo-Terminal -- */
+/* Creates the pty pair, puts the slave into raw mode and keeps it open so reads never see EIO. */
+static void open_pty(HostUart *uart)
+{
+    struct termios tio;
+
+    uart->master_fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (uart->master_fd < 0 || grantpt(uart->master_fd) != 0 || unlockpt(uart->master_fd) != 0)
+    {
+        host_log("host_uart: cannot create pseudo-terminal (%s)\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    const char *slave_name = ptsname(uart->master_fd);
+    uart->slave_fd = open(slave_name, O_RDWR | O_NOCTTY);
+    if (uart->slave_fd >= 0 && tcgetattr(uart->slave_fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(uart->slave_fd, TCSANOW, &tio);
+    }
+
+    const char *link_name = getenv("RTOS_CLI_PTY");
+    if (link_name != NULL)
+    {
+        unlink(link_name);
+        if (symlink(slave_name, link_name) != 0)
+        {
+            host_log("host_uart: cannot link %s (%s)\n", link_name, strerror(errno));
+        }
+    }
+
+    host_log("USART1 on %s\n", link_name != NULL ? link_name : slave_name);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                             Simulator Interface                            */
+/* -------------------------------------------------------------------------- */
+
+void host_uart_configure(USART_TypeDef *USARTx, uint32_t BaudRate)
+{
+    HostUart *const uart = uart_of(USARTx);
+
+    USARTx->SR |= USART_SR_TXE | USART_SR_TC;
+
+    if (uart == NULL || BaudRate == 0)
+    {
+        return;
+    }
+
+    if (uart->master_fd < 0)
+    {
+        open_pty(uart);
+        uart->rx_last_service_ns = host_time_ns();
+    }
+    else if (uart->baud_rate != BaudRate)
+    {
+        host_log("USART1 baud rate %u -> %u\n", (unsigned) uart->baud_rate, (unsigned) BaudRate);
+    }
+
+    uart->baud_rate = BaudRate;
+    USARTx->BRR = 72000000U / BaudRate;
+}
+
+uint32_t host_usart_txe(USART_TypeDef *USARTx)
+{
+    HostUart *const uart = uart_of(USARTx);
+
+    if (uart == NULL)
+    {
+        return 1U;
+    }
+
+    return host_time_ns() >= uart->tx_busy_until_ns;
+}
+
+uint32_t host_usart_tc(USART_TypeDef *USARTx)
+{
+    return host_usart_txe(USARTx);
+}
+
+void host_usart_transmit(USART_TypeDef *USARTx, uint8_t Value)
+{
+    HostUart *const uart = uart_of(USARTx);
+
+    if (uart == NULL || uart->master_fd < 0)
+    {
+        return;
+    }
+
+    const uint64_t now = host_time_ns();
+    const uint64_t start = (uart->tx_busy_until_ns > now) ? uart->tx_busy_until_ns : now;
+    uart->tx_busy_until_ns = start + byte_time_ns(uart);
+
+    /* Nobody listening behaves like an unconnected TX pin: the byte is simply lost. */
+    if (write(uart->master_fd, &Value, 1) < 0 && errno != EAGAIN)
+    {
+        host_log("host_uart: write failed (%s)\n", strerror(errno));
+    }
+}
+
+size_t host_uart_dma_tx(USART_TypeDef *USARTx, const uint8_t *data, size_t len)
+{
+    HostUart *const uart = uart_of(USARTx);
+
+    if (uart == NULL || uart->master_fd < 0)
+    {
+        return len;
+    }
+
+    /* A new transfer was enabled at some point during the last tick; let it use that whole window.
+     * A transfer still in progress keeps its fractional byte time across ticks. */
+    const uint64_t now = host_time_ns();
+    const uint64_t window_start = now - 1000000000ULL / configTICK_RATE_HZ;
+    if (!uart->tx_dma_active && uart->tx_busy_until_ns < window_start)
+    {
+        uart->tx_busy_until_ns = window_start;
+    }
+
+    size_t count = 0;
+    while (count < len && uart->tx_busy_until_ns + byte_time_ns(uart) <= now)
+    {
+        uart->tx_busy_until_ns += byte_time_ns(uart);
+        count++;
+    }
+
+    if (count > 0 && write(uart->master_fd, data, count) < 0 && errno != EAGAIN)
+    {
+        host_log("host_uart: write failed (%s)\n", strerror(errno));
+    }
+
+    uart->tx_dma_active = (count < len);
+    return count;
+}
+
+size_t host_uart_dma_rx(USART_TypeDef *USARTx, uint8_t *data, size_t len)
+{
+    HostUart *const uart = uart_of(USARTx);
+
+    if (uart == NULL)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    while (count < len && uart->rx_count > 0 && uart->rx_credit_bits >= 10)
+    {
+        uart->rx_credit_bits -= 10;
+        data[count++] = uart->rx_fifo[uart->rx_head];
+        uart->rx_head = (uart->rx_head + 1) % HOST_UART_RX_FIFO;
+        uart->rx_count--;
+    }
+
+    if (count > 0)
+    {
+        uart->rx_dma_busy = 1;
+    }
+
+    return count;
+}
+
+void host_uart_service(USART_TypeDef *USARTx)
+{
+    HostUart *const uart = uart_of(USARTx);
+
+    if (uart == NULL || uart->master_fd < 0)
+    {
+        return;
+    }
+
+    /* Top up the software FIFO that stands in for the wire. */
+    while (uart->rx_count < HOST_UART_RX_FIFO)
+    {
+        const size_t tail = (uart->rx_head + uart->rx_count) % HOST_UART_RX_FIFO;
+        const size_t space = (tail >= uart->rx_head) ? HOST_UART_RX_FIFO - tail : uart->rx_head - tail;
+        const ssize_t got = read(uart->master_fd, uart->rx_fifo + tail, space);
+
+        if (got <= 0)
+        {
+            break;
+        }
+        uart->rx_count += (size_t) got;
+    }
+
+    const uint64_t now = host_time_ns();
+    uart->rx_credit_bits += (now - uart->rx_last_service_ns) * uart->baud_rate / 1000000000ULL;
+    uart->rx_last_service_ns = now;
+
+    if (uart->rx_count == 0)
+    {
+        /* An idle line does not bank time for a later burst. */
+        uart->rx_credit_bits = 0;
+
+        if (uart->rx_dma_busy)
+        {
+            uart->rx_dma_busy = 0;
+            USARTx->SR |= USART_SR_IDLE;
+
+            if (USARTx->CR1 & USART_CR1_IDLEIE)
+            {
+                USART1_IRQHandler();
+            }
+        }
+        return;
+    }
+
+    if (USARTx->CR3 & USART_CR3_DMAR)
+    {
+        /* The DMA stream pulls from the FIFO via host_uart_dma_rx(). */
+        return;
+    }
+
+    while (uart->rx_count > 0 && uart->rx_credit_bits >= 10)
+    {
+        uart->rx_credit_bits -= 10;
+
+        if (USARTx->SR & USART_SR_RXNE)
+        {
+            USARTx->SR |= USART_SR_ORE;
+        }
+        else
+        {
+            USARTx->DR = uart->rx_fifo[uart->rx_head];
+            USARTx->SR |= USART_SR_RXNE;
+        }
+        uart->rx_head = (uart->rx_head + 1) % HOST_UART_RX_FIFO;
+        uart->rx_count--;
+
+        if (USARTx->CR1 & USART_CR1_RXNEIE)
+        {
+            USART1_IRQHandler();
+        }
+    }
+}
@@ -0,0 +1,229 @@
+/*
+ * adc_dsp_test.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host test of the adc_dsp.c kernels against their _ref twins. Each pair
+ *  gets the same input, with state carried across blocks of varying length
+ *  (odd ones included), and must agree on every output. The oversampler is
+ *  run at every ratio, the trigger search for every trigger at a level that
+ *  moves from block to block. The FFT is also held against a double-precision
+ *  DFT of the same windowed input and must stay within FFT_MAX_ERROR. The
+ *  inputs are a full-scale sine, square edges that saturate the DC blocker's
+ *  difference, and random 12-bit codes. Timings are in Bench/dsp_bench.c.
+ */
+
+/* -- Standard Library -- */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* -- User Library -- */
+#include "adc_dsp.h"
+
+#define TEST_BLOCKS         (20000U)
+#define TEST_BLOCK_SCANS    (100U)
+
+/* Worst |Q15 FFT - DFT / N| allowed on any bin, in Q15 LSB: five stages of truncation, a few LSB each. */
+#define FFT_MAX_ERROR       (8.0)
+
+typedef enum
+{
+    INPUT_SINE,
+    INPUT_SQUARE,
+    INPUT_NOISE,
+    INPUT_COUNT
+}INPUT;
+
+static const char *const Input_Names[INPUT_COUNT] = { "sine", "square", "noise" };
+
+static uint32_t Seed = 1;
+
+/* -- Test Input -- */
+static void make_input(INPUT input, uint32_t block, uint16_t *samples, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double t = (double) (block * TEST_BLOCK_SCANS + i);
+
+        switch (input)
+        {
+            case INPUT_SINE:
+                samples[i] = (uint16_t) lround(2047.5 + 2047.5 * sin(t * 0.0123));
+                break;
+
+            case INPUT_SQUARE:
+                samples[i] = ((uint32_t) t / 7U % 2U) ? 4095 : 0;
+                break;
+
+            default:
+                Seed = Seed * 1664525U + 1013904223U;
+                samples[i] = (uint16_t) (Seed >> 20);
+                break;
+        }
+    }
+}
+
+/* -- Compare -- */
+static size_t differences(const int16_t *a, const int16_t *b, size_t count)
+{
+    size_t differ = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        differ += (a[i] != b[i]);
+    }
+
+    return differ;
+}
+
+/* -- Bit Exactness -- */
+/* Block lengths cycle through 1 .. ADC_DSP_FIR_MAX_BLOCK so that every tail path and CIC phase is hit. */
+static size_t check(INPUT input)
+{
+    static AdcDcBlock dc[2];
+    static AdcCic cic[2];
+    static AdcFir fir[2];
+    static AdcOversampler os[2];
+    uint16_t samples[ADC_DSP_FIR_MAX_BLOCK], oversampled[2][ADC_DSP_FIR_MAX_BLOCK];
+    int16_t q15[2][ADC_DSP_FIR_MAX_BLOCK], dc_out[2][ADC_DSP_FIR_MAX_BLOCK];
+    int16_t cic_out[2][ADC_DSP_FIR_MAX_BLOCK], fir_out[2][ADC_DSP_FIR_MAX_BLOCK];
+    size_t differ = 0;
+
+    for (uint32_t k = 0; k < 2; ++k)
+    {
+        adc_dsp_dc_block_init(&dc[k]);
+        adc_dsp_cic_init(&cic[k]);
+        adc_dsp_fir_init(&fir[k], ADC_DSP_LOWPASS);
+    }
+
+    for (uint32_t block = 0; block < TEST_BLOCKS; ++block)
+    {
+        const size_t count = 1U + block % ADC_DSP_FIR_MAX_BLOCK;
+
+        make_input(input, block, samples, count);
+
+        adc_dsp_to_q15(samples, q15[0], count);
+        adc_dsp_to_q15_ref(samples, q15[1], count);
+        differ += differences(q15[0], q15[1], count);
+
+        adc_dsp_dc_block(&dc[0], q15[1], dc_out[0], count);
+        adc_dsp_dc_block_ref(&dc[1], q15[1], dc_out[1], count);
+        differ += differences(dc_out[0], dc_out[1], count);
+
+        const size_t decimated = adc_dsp_cic(&cic[0], q15[1], cic_out[0], count);
+        differ += (decimated != adc_dsp_cic_ref(&cic[1], q15[1], cic_out[1], count));
+        differ += differences(cic_out[0], cic_out[1], decimated);
+
+        adc_dsp_fir(&fir[0], dc_out[1], fir_out[0], count);
+        adc_dsp_fir_ref(&fir[1], dc_out[1], fir_out[1], count);
+        differ += differences(fir_out[0], fir_out[1], count);
+
+        /* Every ratio in turn, each for a stretch of blocks so that partial sums cross block edges. */
+        if (block % 1000U == 0)
+        {
+            adc_dsp_oversample_init(&os[0], block / 1000U % (ADC_DSP_OVERSAMPLE_MAX_SHIFT + 1U));
+            adc_dsp_oversample_init(&os[1], block / 1000U % (ADC_DSP_OVERSAMPLE_MAX_SHIFT + 1U));
+        }
+        const size_t results = adc_dsp_oversample(&os[0], samples, oversampled[0], count);
+        differ += (results != adc_dsp_oversample_ref(&os[1], samples, oversampled[1], count));
+        differ += differences((const int16_t*) oversampled[0], (const int16_t*) oversampled[1], results);
+
+        for (ADC_TRIGGER trigger = ADC_TRIGGER_RISING; trigger <= ADC_TRIGGER_BELOW; ++trigger)
+        {
+            const uint16_t level = (uint16_t) (block * 7U % 4096U);
+            const uint16_t previous = samples[(block * 3U) % count];
+
+            differ += (adc_dsp_find_trigger(samples, count, previous, level, trigger) !=
+                       adc_dsp_find_trigger_ref(samples, count, previous, level, trigger));
+        }
+    }
+
+    return differ;
+}
+
+/* -- FFT Check -- */
+/* Bit-exactness against the _ref FFT, and the worst error against a direct DFT in double precision. Returns the
+ * outputs that differ from the _ref version; `worst` is in Q15 LSB and `snr_db` is over the whole spectrum. */
+static size_t fft_check(INPUT input, double *worst, double *snr_db)
+{
+    static uint16_t samples[ADC_DSP_FFT_SIZE];
+    static uint32_t data[2][ADC_DSP_FFT_SIZE];
+    static double window_re[ADC_DSP_FFT_SIZE];
+    double signal = 0.0, noise = 0.0;
+    size_t differ = 0;
+
+    for (uint32_t block = 0; block < ADC_DSP_FFT_SIZE / TEST_BLOCK_SCANS + 1U; ++block)
+    {
+        const size_t from = block * TEST_BLOCK_SCANS;
+        const size_t count = (from + TEST_BLOCK_SCANS <= ADC_DSP_FFT_SIZE) ? TEST_BLOCK_SCANS : ADC_DSP_FFT_SIZE - from;
+
+        make_input(input, block, &samples[from], count);
+    }
+
+    adc_dsp_fft_window(samples, data[0]);
+    for (uint32_t n = 0; n < ADC_DSP_FFT_SIZE; ++n)
+    {
+        window_re[n] = (int16_t) data[0][n];
+    }
+    memcpy(data[1], data[0], sizeof(data[0]));
+
+    adc_dsp_fft(data[0]);
+    adc_dsp_fft_ref(data[1]);
+    differ += differences((const int16_t*) data[0], (const int16_t*) data[1], 2U * ADC_DSP_FFT_SIZE);
+
+    *worst = 0.0;
+    for (uint32_t k = 0; k < ADC_DSP_FFT_SIZE; ++k)
+    {
+        double re = 0.0, im = 0.0;
+
+        for (uint32_t n = 0; n < ADC_DSP_FFT_SIZE; ++n)
+        {
+            const double angle = -2.0 * M_PI * (double) ((k * n) % ADC_DSP_FFT_SIZE) / ADC_DSP_FFT_SIZE;
+
+            re += window_re[n] * cos(angle);
+            im += window_re[n] * sin(angle);
+        }
+        re /= ADC_DSP_FFT_SIZE;
+        im /= ADC_DSP_FFT_SIZE;
+
+        const uint32_t x = data[0][adc_dsp_fft_bin(k)];
+        const double error_re = (int16_t) x - re, error_im = (int16_t) (x >> 16) - im;
+        const double error = sqrt(error_re * error_re + error_im * error_im);
+
+        *worst = (error > *worst) ? error : *worst;
+        signal += re * re + im * im;
+        noise += error * error;
+    }
+    *snr_db = 10.0 * log10(signal / ((noise > 0.0) ? noise : 1e-12));
+
+    return differ;
+}
+
+int main(void)
+{
+    size_t total = 0;
+
+    for (INPUT input = 0; input < INPUT_COUNT; ++input)
+    {
+        const size_t differ = check(input);
+
+        printf("%-6s : %s (%zu outputs differ)\n", Input_Names[input], (differ == 0) ? "bit-exact" : "MISMATCH", differ);
+        total += differ;
+    }
+
+    for (INPUT input = 0; input < INPUT_COUNT; ++input)
+    {
+        double worst, snr_db;
+        const size_t differ = fft_check(input, &worst, &snr_db);
+        const uint8_t close = (worst <= FFT_MAX_ERROR);
+
+        printf("fft %-6s : %s, %.2f LSB from the DFT at worst, %.1f dB SNR%s\n", Input_Names[input],
+               (differ == 0) ? "bit-exact" : "MISMATCH", worst, snr_db, close ? "" : " (TOO FAR)");
+        total += differ + !close;
+    }
+
+    printf("adc_dsp: %s\n", (total == 0) ? "ok" : "FAILED");
+    return (total == 0) ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/*
+ * cli_args_test.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host test of the tokenizer and schema parser in cli_args.c: token counts
+ *  up to and past CLI_MAX_ARGS, where the line must be reported as too long
+ *  rather than cut short, and a schema run over what fits.
+ */
+
+/* -- Standard Library -- */
+#include <stdio.h>
+#include <string.h>
+
+/* -- User Library -- */
+#include "cli_args.h"
+
+static const char *const Test_Keywords[] = { "stop" };
+static const char *const Test_Edges[] = { "rising", "falling" };
+
+static const CliArgSpec Test_Args[] =
+{
+    { "channel", CLI_ARG_INT, .min = 0, .max = 2, .choices = Test_Keywords, .choice_count = CLI_ARG_COUNT(Test_Keywords) },
+    { "edge", CLI_ARG_ENUM, .optional = 1, .choices = Test_Edges, .choice_count = CLI_ARG_COUNT(Test_Edges) },
+};
+
+static CliArgs Args;
+static uint32_t Failures;
+
+/* -- Expect -- */
+static void expect(const char *name, long got, long want)
+{
+    if (got != want)
+    {
+        printf("FAIL %-28s: %ld, expected %ld\n", name, got, want);
+        Failures++;
+    }
+}
+
+/* -- Tokenize -- */
+/* Tokenizes a copy of `text`, as the CLI does its line buffer in place. */
+static size_t tokenize(const char *text)
+{
+    static char line[128];
+
+    strncpy(line, text, sizeof(line) - 1U);
+    return cli_tokenize(line, &Args);
+}
+
+int main(void)
+{
+    size_t failed = 0;
+
+    expect("empty line", tokenize(""), 0);
+    expect("blanks only", tokenize(" \t  "), 0);
+
+    expect("separators", tokenize("  capture\t1  rising "), 3);
+    expect("separators argc", Args.argc, 3);
+    expect("last token", strcmp(Args.argv[2], "rising"), 0);
+
+    /* Exactly CLI_MAX_ARGS fits. */
+    expect("eight tokens", tokenize("a b c d e f g h"), CLI_MAX_ARGS);
+    expect("eight tokens argc", Args.argc, CLI_MAX_ARGS);
+    expect("eighth token", strcmp(Args.argv[7], "h"), 0);
+
+    /* One more and the line is refused, not run on its first eight tokens. */
+    expect("nine tokens", tokenize("a b c d e f g h i"), CLI_MAX_ARGS + 1U);
+    expect("nine tokens argc", Args.argc, CLI_MAX_ARGS + 1U);
+    expect("twelve tokens argc", (tokenize("a b c d e f g h i j k l"), Args.argc), CLI_MAX_ARGS + 1U);
+
+    /* The schema over a line that fits. */
+    tokenize("capture 2 falling");
+    expect("parse", cli_args_parse(Test_Args, CLI_ARG_COUNT(Test_Args), &Args, &failed), CLI_ARGS_OK);
+    expect("parse channel", Args.arg[0].value, 2);
+    expect("parse edge", Args.arg[1].value, 1);
+
+    tokenize("capture stop");
+    expect("keyword", cli_args_parse(Test_Args, CLI_ARG_COUNT(Test_Args), &Args, &failed), CLI_ARGS_OK);
+    expect("keyword index", Args.arg[0].keyword, 1);
+
+    tokenize("capture 3");
+    expect("out of range", cli_args_parse(Test_Args, CLI_ARG_COUNT(Test_Args), &Args, &failed), CLI_ARGS_INVALID);
+
+    tokenize("capture 1 rising 5");
+    expect("left over", cli_args_parse(Test_Args, CLI_ARG_COUNT(Test_Args), &Args, &failed), CLI_ARGS_TOO_MANY);
+    expect("left over index", failed, 3);
+
+    printf("cli_args: %s\n", (Failures == 0) ? "ok" : "FAILED");
+    return (Failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/*
+ * run_time_test.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host test of the 64-bit run-time clock in run_time.c. The simulator's
+ *  host_dwt() is replaced by a fake whose CYCCNT only moves when the test
+ *  sets it, so wraps land exactly where each case wants them: just after
+ *  init, between two reads, and over and over across a long run. Cycles
+ *  slept with CYCCNT stopped are credited through run_time_add_sleep().
+ */
+
+/* -- Standard Library -- */
+#include <inttypes.h>
+#include <stdio.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+
+/* -- User Library -- */
+#include "run_time.h"
+
+/* -- Fake Cortex-M4 Debug Blocks -- */
+
+CoreDebug_Type host_core_debug;
+uint32_t SystemCoreClock = 144000000U;
+
+static DWT_Type Fake_Dwt;
+
+DWT_Type* host_dwt(void)
+{
+    return &Fake_Dwt;
+}
+
+static uint32_t Failures;
+
+/* -- Expect -- */
+static void expect(const char *name, uint64_t got, uint64_t want)
+{
+    if (got != want)
+    {
+        printf("FAIL %-28s: %" PRIu64 ", expected %" PRIu64 "\n", name, got, want);
+        Failures++;
+    }
+}
+
+/* -- Advance -- */
+/* Moves CYCCNT on by `cycles`, modulo 2^32 as the hardware counter does, and reads the clock. */
+static uint64_t advance(uint32_t cycles)
+{
+    Fake_Dwt.CYCCNT += cycles;
+    return run_time_now();
+}
+
+int main(void)
+{
+    /* Starts counting from wherever CYCCNT is, here just short of a wrap. */
+    Fake_Dwt.CYCCNT = 0xFFFFFF00U;
+    run_time_init();
+    expect("enables CYCCNT", Fake_Dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk, DWT_CTRL_CYCCNTENA_Msk);
+    expect("enables trace", host_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk, CoreDebug_DEMCR_TRCENA_Msk);
+    expect("zero at init", run_time_now(), 0);
+
+    /* The wrap falls between these two reads. */
+    expect("before the wrap", advance(0x80U), 0x80U);
+    expect("across the wrap", advance(0x100U), 0x180U);
+    expect("CYCCNT wrapped", Fake_Dwt.CYCCNT, 0x80U);
+
+    /* Reads back to back add nothing. */
+    expect("repeated read", run_time_now(), 0x180U);
+
+    /* The longest gap it can cover: one cycle short of a full wrap. */
+    expect("almost a full wrap", advance(0xFFFFFFFFU), 0x180U + 0xFFFFFFFFULL);
+
+    /* Many wraps, three reads each: the total carries into the upper word and stays exact. */
+    uint64_t want = 0x180U + 0xFFFFFFFFULL;
+    for (uint32_t i = 0; i < 3000U; ++i)
+    {
+        const uint32_t step = 0x55555555U + i * 7919U;
+
+        want += step;
+        if (advance(step) != want)
+        {
+            expect("long run", run_time_now(), want);
+            break;
+        }
+    }
+    expect("past 2^32", want > UINT32_MAX, 1);
+    expect("long run total", run_time_now(), want);
+
+    /* A sleep CYCCNT did not see is credited on top of the cycles it did, here with the sum wrapping. */
+    Fake_Dwt.CYCCNT = 0xFFFFF000U;
+    want = run_time_now();
+    Fake_Dwt.CYCCNT += 0x800U;
+    run_time_add_sleep(0x10000U);
+    want += 0x800U + 0x10000U;
+    expect("sleep credited", run_time_now(), want);
+    expect("sleep across the wrap", advance(0x1000U), want + 0x1000U);
+    expect("slept total", Run_Time_Slept_Cycles, 0x10000U);
+
+    printf("run_time: %s\n", (Failures == 0) ? "ok" : "FAILED");
+    return (Failures == 0) ? 0 : 1;
+}
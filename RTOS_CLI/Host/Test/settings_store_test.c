@@ -0,0 +1,369 @@
+/*
+ * settings_store_test.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ashish Bansal
+ *
+ *  Host test of the settings log in settings_store.c, on the file-backed
+ *  flash of host_flash.c. Each boot is a child process that loads the image,
+ *  scans it and checks what it finds, so the store's RAM index is rebuilt
+ *  from flash every time, as after a reset. host_flash_power_cut() stops the
+ *  writes after every possible word of an append and of a compaction; the
+ *  next boot must read either the old value or the new one, never a mix.
+ */
+
+/* -- Standard Library -- */
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* -- STM32 Library -- */
+#include "main.h"
+
+/* -- FreeRTOS Library -- */
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+/* -- User Library -- */
+#include "host_board.h"
+#include "settings_store.h"
+
+#define TEST_KEYS   (6U)
+
+/* Words one 8-byte put programs: two value words, the CRC, then the key/length word. */
+#define PUT_PROGRAMS    (4)
+
+typedef struct
+{
+    uint32_t id;
+    uint32_t version;
+}TestValue;
+
+extern uint8_t _settings_flash_start[];
+
+/* -- Fakes -- */
+/* One task, no scheduler: the store's mutex always succeeds. */
+
+CoreDebug_Type host_core_debug;
+static DWT_Type Fake_Dwt;
+static uint8_t  Fake_Lock;
+
+DWT_Type* host_dwt(void)
+{
+    return &Fake_Dwt;
+}
+
+QueueHandle_t xQueueCreateMutex(const uint8_t ucQueueType)
+{
+    (void) ucQueueType;
+    return (QueueHandle_t) &Fake_Lock;
+}
+
+BaseType_t xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait)
+{
+    (void) xQueue;
+    (void) xTicksToWait;
+    return pdTRUE;
+}
+
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void *const pvItemToQueue, TickType_t xTicksToWait,
+                             const BaseType_t xCopyPosition)
+{
+    (void) xQueue;
+    (void) pvItemToQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+    return pdTRUE;
+}
+
+void assert_failed(uint8_t *file, uint32_t line)
+{
+    printf("assert_failed %s:%lu\n", (const char*) file, (unsigned long) line);
+    exit(100);
+}
+
+void host_log(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static uint32_t Failures;
+
+/* -- Expect -- */
+static void expect(const char *name, uint32_t got, uint32_t want)
+{
+    if (got != want)
+    {
+        printf("FAIL %-32s: %lu, expected %lu\n", name, (unsigned long) got, (unsigned long) want);
+        Failures++;
+    }
+}
+
+/* -- Boot -- */
+/* Runs `step` in a fresh process on the image as it is in the file, like a reset would. Returns its failures. */
+static uint32_t boot(void (*step)(int32_t), const int32_t arg)
+{
+    const pid_t pid = fork();
+    int status;
+
+    if (pid == 0)
+    {
+        host_flash_init();
+        settings_store_init();
+        step(arg);
+        exit((Failures < 100) ? (int) Failures : 99);
+    }
+
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status))
+    {
+        printf("FAIL boot did not exit cleanly\n");
+        return 1;
+    }
+    return (uint32_t) WEXITSTATUS(status);
+}
+
+/* -- Put -- */
+static BaseType_t put(const uint16_t key, const uint32_t version)
+{
+    const TestValue value = { .id = 0x5E770000U + key, .version = version };
+
+    return settings_store_put(key, &value, sizeof(value));
+}
+
+/* -- Version Of -- */
+/* The stored version of `key`, 0 when unset, ~0 when the value is not one put() wrote for that key. */
+static uint32_t version_of(const uint16_t key)
+{
+    TestValue value;
+    const size_t length = settings_store_get(key, &value, sizeof(value));
+
+    if (length == 0)
+    {
+        return 0;
+    }
+    return (length == sizeof(value) && value.id == 0x5E770000U + key) ? value.version : ~0U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                    Boots                                   */
+/* -------------------------------------------------------------------------- */
+
+/* -- Blank -- */
+/* The first put formats sector 1 through a compaction. */
+static void boot_blank(int32_t arg)
+{
+    SettingsStoreStats stats;
+
+    (void) arg;
+    settings_store_get_stats(&stats);
+    expect("blank: no sector", stats.active_sector, SETTINGS_STORE_NO_SECTOR);
+    expect("blank: unset", version_of(0), 0);
+
+    for (uint16_t key = 0; key < TEST_KEYS; ++key)
+    {
+        expect("blank: put", put(key, 1), pdPASS);
+    }
+
+    settings_store_get_stats(&stats);
+    expect("blank: formatted", stats.active_sector, 0);
+    expect("blank: generation", stats.generation, 1);
+}
+
+/* -- Rescan -- */
+/* Every key at version `arg`, and nothing the scan had to reject. */
+static void boot_rescan(int32_t arg)
+{
+    SettingsStoreStats stats;
+
+    settings_store_get_stats(&stats);
+    expect("rescan: no bad records", stats.bad_records, 0);
+    expect("rescan: keys", stats.keys, TEST_KEYS);
+    for (uint16_t key = 0; key < TEST_KEYS; ++key)
+    {
+        expect("rescan: version", version_of(key), (uint32_t) arg);
+    }
+}
+
+/* -- Torn Append -- */
+/* Puts version 3 of key 2 with the power cut after `arg` words. */
+static void boot_torn_append(int32_t arg)
+{
+    host_flash_power_cut(arg);
+    (void) put(2, 3);
+}
+
+/* -- After Torn Append -- */
+/* Key 2 reads as version 2 or 3 depending on where the cut fell; a put on top must land intact. */
+static void boot_after_torn_append(int32_t arg)
+{
+    SettingsStoreStats stats;
+
+    settings_store_get_stats(&stats);
+    expect("torn append: no bad records", stats.bad_records, 0);
+    expect("torn append: old or new", version_of(2), (arg < PUT_PROGRAMS) ? 2U : 3U);
+    expect("torn append: others kept", version_of(1), 2);
+
+    expect("torn append: put after", put(2, 4), pdPASS);
+    expect("torn append: reads back", version_of(2), 4);
+}
+
+/* -- Torn Compaction -- */
+/* Compacts with the power cut after `arg` erases and words. */
+static void boot_torn_compaction(int32_t arg)
+{
+    host_flash_power_cut(arg);
+    (void) settings_store_compact();
+}
+
+/* -- After Torn Compaction -- */
+/* Every key still at its latest version, from whichever sector won; then a put and a whole compaction work. */
+static void boot_after_torn_compaction(int32_t arg)
+{
+    SettingsStoreStats stats;
+
+    (void) arg;
+    settings_store_get_stats(&stats);
+    expect("torn compaction: no bad records", stats.bad_records, 0);
+    for (uint16_t key = 0; key < TEST_KEYS; ++key)
+    {
+        expect("torn compaction: version", version_of(key), (key == 2) ? 4U : 2U);
+    }
+
+    expect("torn compaction: put after", put(5, 5), pdPASS);
+    expect("torn compaction: compact", settings_store_compact(), pdPASS);
+    expect("torn compaction: reads back", version_of(5), 5);
+}
+
+/* -- Fill -- */
+/* Appends until the sector fills and the store compacts by itself, ending with every key at version `arg`. */
+static void boot_fill(int32_t arg)
+{
+    SettingsStoreStats stats;
+    uint32_t generation;
+
+    settings_store_get_stats(&stats);
+    generation = stats.generation;
+
+    for (uint32_t version = 100; version < (uint32_t) arg; ++version)
+    {
+        if (put((uint16_t) (version % TEST_KEYS), version) != pdPASS)
+        {
+            expect("fill: put", pdFAIL, pdPASS);
+            return;
+        }
+    }
+    for (uint16_t key = 0; key < TEST_KEYS; ++key)
+    {
+        expect("fill: last put", put(key, (uint32_t) arg), pdPASS);
+    }
+
+    settings_store_get_stats(&stats);
+    expect("fill: compacted", stats.compactions != 0, 1);
+    expect("fill: generation moved on", stats.generation != generation, 1);
+}
+
+/* -- Corrupt -- */
+/* Puts version `arg` of key 0, then clears a bit of its value in flash, as a bad cell would. */
+static void boot_corrupt(int32_t arg)
+{
+    const TestValue value = { .id = 0x5E770000U, .version = (uint32_t) arg };
+    uint8_t *const found = memmem(_settings_flash_start, 2U * SETTINGS_STORE_SECTOR_SIZE, &value, sizeof(value));
+
+    expect("corrupt: put", put(0, (uint32_t) arg), pdPASS);
+
+    uint8_t *const stored = memmem(_settings_flash_start, 2U * SETTINGS_STORE_SECTOR_SIZE, &value, sizeof(value));
+    expect("corrupt: found", stored != NULL && found == NULL, 1);
+    if (stored != NULL)
+    {
+        uint32_t word;
+
+        memcpy(&word, stored + 4, sizeof(word));
+        HAL_FLASH_Unlock();
+        HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, (uintptr_t) (stored + 4), word & ~1U);
+        HAL_FLASH_Lock();
+    }
+}
+
+/* -- After Corrupt -- */
+/* The bad record is counted and skipped: key 0 falls back to version `arg`. */
+static void boot_after_corrupt(int32_t arg)
+{
+    SettingsStoreStats stats;
+
+    settings_store_get_stats(&stats);
+    expect("corrupt: counted", stats.bad_records, 1);
+    expect("corrupt: previous value", version_of(0), (uint32_t) arg);
+    expect("corrupt: others kept", version_of(1), (uint32_t) arg);
+}
+
+/* -- Reset -- */
+/* Erases the image and writes every key at version 2, then key 2 again at version `arg` unless it is 0. */
+static void boot_reset(int32_t arg)
+{
+    expect("reset: clear", settings_store_clear(), pdPASS);
+    for (uint16_t key = 0; key < TEST_KEYS; ++key)
+    {
+        expect("reset: put", put(key, 2), pdPASS);
+    }
+    if (arg != 0)
+    {
+        expect("reset: put again", put(2, (uint32_t) arg), pdPASS);
+    }
+}
+
+int main(void)
+{
+    char path[] = "/tmp/settings_store_test.XXXXXX";
+    const int fd = mkstemp(path);
+    uint32_t failures = 0;
+
+    if (fd < 0)
+    {
+        printf("settings_store: no temporary flash image\n");
+        return 1;
+    }
+    close(fd);
+    setenv("RTOS_CLI_FLASH", path, 1);
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    failures += boot(boot_blank, 0);
+    failures += boot(boot_rescan, 1);
+
+    /* A cut after every word of an append: the key/length word goes last, so it is all or nothing. */
+    for (int32_t cut = 0; cut <= PUT_PROGRAMS; ++cut)
+    {
+        failures += boot(boot_reset, 0);
+        failures += boot(boot_torn_append, cut);
+        failures += boot(boot_after_torn_append, cut);
+    }
+
+    /* A cut after the erase and every word of a compaction: the old sector stays active until the new header's
+     * magic lands. One erase, TEST_KEYS records and two header words; the last count lets it finish. Key 2 has
+     * a superseded record, which must not come back. */
+    for (int32_t cut = 0; cut <= 1 + (int32_t) TEST_KEYS * PUT_PROGRAMS + 2; ++cut)
+    {
+        failures += boot(boot_reset, 4);
+        failures += boot(boot_torn_compaction, cut);
+        failures += boot(boot_after_torn_compaction, cut);
+    }
+
+    /* Several sectors' worth of appends, then a rescan of what the compactions left. */
+    failures += boot(boot_reset, 0);
+    failures += boot(boot_fill, 4000);
+    failures += boot(boot_rescan, 4000);
+
+    failures += boot(boot_corrupt, 4001);
+    failures += boot(boot_after_corrupt, 4000);
+
+    unlink(path);
+    printf("settings_store: %s\n", (failures == 0) ? "ok" : "FAILED");
+    return (failures == 0) ? 0 : 1;
+}
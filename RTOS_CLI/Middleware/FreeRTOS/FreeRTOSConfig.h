@@ -48,7 +48,7 @@
 #endif
 
 #define configUSE_PREEMPTION			1
-#define configUSE_IDLE_HOOK				0
+#define configUSE_IDLE_HOOK				1
 #define configUSE_TICK_HOOK				0
 #define configCPU_CLOCK_HZ				( SystemCoreClock )
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
@@ -67,13 +67,33 @@
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	1
+
+/* Run-time stats clock. 1: DWT cycle counter at the core clock, extended to
+64 bits in run_time.c, so even sub-microsecond slices are charged. 0: TIM2
+prescaled to 1 MHz, 32 bits, wraps about every 71 minutes. */
+#ifndef configRUN_TIME_STATS_USE_DWT
+	#define configRUN_TIME_STATS_USE_DWT	1
+#endif
+
+#if configRUN_TIME_STATS_USE_DWT
+	#define configRUN_TIME_COUNTER_TYPE	uint64_t
+#else
+	#define configRUN_TIME_COUNTER_TYPE	uint32_t
+#endif
 #define configTaskDelete				1
+/* Tickless idle, see low_power.c. In periodic mode the pre-suppress hook
+returns 0 and the idle hook sleeps until the next tick instead. */
+#define configUSE_TICKLESS_IDLE			1
+#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )	( x ) = low_power_idle_time( x )
+#define configPRE_SLEEP_PROCESSING( x )	low_power_pre_sleep()
+#define configPOST_SLEEP_PROCESSING( x )	low_power_post_sleep( x )
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
-/* Software timer definitions. */
-#define configUSE_TIMERS				0
+/* Software timer definitions. The timer service task runs the LED engine. */
+#define configUSE_TIMERS				1
 #define configTIMER_TASK_PRIORITY		( 2 )
 #define configTIMER_QUEUE_LENGTH		10
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
@@ -90,6 +110,8 @@ to exclude the API function. */
 
 #define INCLUDE_xTaskGetIdleTaskHandle  1
 #define INCLUDE_pxTaskGetStackStart		1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
+#define INCLUDE_xTimerPendFunctionCall	1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -126,6 +148,17 @@ standard names. */
 #define xPortPendSVHandler PendSV_Handler
 #define xPortSysTickHandler SysTick_Handler
 
+/* Run-time stats clock, see configRUN_TIME_STATS_USE_DWT. */
+#if defined( __ICCARM__) || defined(__GNUC__) || defined(__CC_ARM)
+	extern void run_time_init( void );
+	extern configRUN_TIME_COUNTER_TYPE run_time_now( void );
+	extern uint32_t low_power_idle_time( uint32_t expected_idle_ticks );
+	extern void low_power_pre_sleep( void );
+	extern void low_power_post_sleep( uint32_t expected_idle_ticks );
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	run_time_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()			run_time_now()
+
 #include "SEGGER_SYSVIEW_FreeRTOS.h"
 
 #endif /* FREERTOS_CONFIG_H */
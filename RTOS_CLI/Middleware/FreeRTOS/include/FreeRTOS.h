@@ -71,8 +71,11 @@
 
 #include "tim.h"
 
+/* Ports with their own time base (the host simulation) provide these in portmacro.h. */
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() MX_TIM2_Init()
 #define portGET_RUN_TIME_COUNTER_VALUE()  (htim2.Instance->CNT)
+#endif
 
 /* Required if struct _reent is used. */
 #if ( configUSE_NEWLIB_REENTRANT == 1 )